@@ -0,0 +1,89 @@
+import re
+import struct
+import sys
+
+# Decodes binary log records written by Log::FlushBin() in raw mode ("log bin raw").
+# Each record is a line "#B time hsmn type name format arg..." in hex, where name and format are
+# addresses of strings in flash. They are read from the ELF file of the same build.
+# Other lines are passed through unchanged.
+
+if len(sys.argv) < 3:
+    print("Enter (1) ELF file (2) captured log file")
+    exit()
+
+# Must match Log::m_typeName. Type 5 (Log::BIN_EVENT) is a record made by Log::Event().
+typeName = ["<ERROR>", "<WARNING>", "<CRITICAL>", "", ""]
+
+class Elf:
+    def __init__(self, path):
+        with open(path, 'rb') as f:
+            self.data = f.read()
+        if self.data[:4] != b'\x7fELF' or self.data[4] != 1:
+            raise ValueError(path + " is not a 32-bit ELF file")
+        shoff, = struct.unpack_from('<I', self.data, 0x20)
+        shentsize, shnum = struct.unpack_from('<HH', self.data, 0x2E)
+        self.sections = []
+        for i in range(shnum):
+            name, type, flags, addr, offset, size = struct.unpack_from('<IIIIII', self.data, shoff + i * shentsize)
+            # Allocated sections with contents, i.e. not SHT_NOBITS.
+            if (flags & 0x2) and type != 8 and size:
+                self.sections.append((addr, offset, size))
+
+    def GetStr(self, addr):
+        for secAddr, offset, size in self.sections:
+            if secAddr <= addr < secAddr + size:
+                start = offset + addr - secAddr
+                end = self.data.index(b'\0', start)
+                return self.data[start:end].decode('latin-1')
+        return "<0x%08x>" % addr
+
+specPattern = re.compile(r'%([-+ #0]*)(\*|\d*)(?:\.(\*|\d*))?(hh|h|ll|l|z)?([diuxXocfFeEgGaApsn%])')
+
+def Format(elf, format, args):
+    def Convert(m):
+        flags, width, prec, length, conv = m.groups()
+        if conv == '%':
+            return '%'
+        values = []
+        if width == '*':
+            values.append(struct.unpack('<i', struct.pack('<I', args.pop(0)))[0])
+        if prec == '*':
+            values.append(struct.unpack('<i', struct.pack('<I', args.pop(0)))[0])
+        spec = '%' + flags + width + (('.' + prec) if prec is not None else '')
+        if conv in 'fFeEgGaA':
+            value = struct.unpack('<d', struct.pack('<II', args.pop(0), args.pop(0)))[0]
+            if conv in 'aA':
+                return value.hex()
+        elif length == 'll':
+            value = args.pop(0) | (args.pop(0) << 32)
+            if conv in 'di':
+                value = struct.unpack('<q', struct.pack('<Q', value))[0]
+        else:
+            value = args.pop(0)
+            if conv in 'di':
+                value = struct.unpack('<i', struct.pack('<I', value))[0]
+            elif conv == 's':
+                value = elf.GetStr(value)
+            elif conv == 'p':
+                spec = '0x' + spec
+                conv = 'x'
+        if conv in 'iu':
+            conv = 'd'
+        return (spec + conv) % tuple(values + [value])
+    return specPattern.sub(Convert, format)
+
+elf = Elf(sys.argv[1])
+with open(sys.argv[2], 'r', errors='replace') as log:
+    for line in log:
+        m = re.search(r'#B ([0-9a-f ]+)', line)
+        if not m:
+            sys.stdout.write(line)
+            continue
+        fields = [int(x, 16) for x in m.group(1).split()]
+        time, hsmn, type, name, format = fields[:5]
+        prefix = "%d %s(%d): %s" % (time, elf.GetStr(name), hsmn, typeName[type] if type < len(typeName) else "")
+        try:
+            text = Format(elf, elf.GetStr(format), fields[5:])
+        except (IndexError, ValueError, TypeError) as e:
+            text = "<decode error: %s> %s" % (e, m.group(1))
+        print(line[:m.start()] + prefix + text)
@@ -0,0 +1,307 @@
+import argparse
+import os
+import pty
+import random
+import select
+import socket
+import sys
+import termios
+import time
+import tty
+
+# Emulates the subset of the SPWF04Sx Wi-Fi module (X-NUCLEO-IDW04A1) used by WifiSt, so that WifiSt can be
+# load tested without the expansion board. Socket operations are bridged to a TCP server on the host.
+#
+# Supported commands (<id> is the socket id, up to --sockets of them):
+#   at+s.sockon=<host>,<port>,,t    Opens a TCP connection. Responds " ID: <id>" and AT-S.OK.
+#   at+s.sockw=<id>,<len>           Followed by <len> bytes of data to send.
+#   at+s.sockr=<id>,[<len>]         Returns pending data as "AT-S.Reading:<len>:<len>" followed by data.
+#   at+s.sockc=<id>                 Closes the connection.
+# Other commands get AT-S.OK.
+# Indications:
+#   +WIND:24:WiFi Up                 On start-up and when Wi-Fi is back up.
+#   +WIND:55:Pending Data:<id>:<len> When data is received from the TCP server.
+#   +WIND:58:Socket Closed:<id>:<n>  When the TCP server closes the connection.
+#   +WIND:33:WiFi Network Lost       When Wi-Fi goes down (see --wifi-down).
+#
+# Usage:
+#   python3 SpwfEmu.py                       Creates a pty and prints its name, e.g. to connect a host build.
+#   python3 SpwfEmu.py --port /dev/ttyUSB0   Uses a serial port, e.g. a USB-UART wired to the Wi-Fi UART pins.
+# To get a loopback TCP server:
+#   nc -lk 127.0.0.1 8080   or   socat TCP-LISTEN:8080,fork,reuseaddr EXEC:cat
+
+parser = argparse.ArgumentParser(description="SPWF04Sx AT command emulator")
+parser.add_argument("--port", help="serial device to use instead of a pty")
+parser.add_argument("--baud", type=int, default=115200, help="baud rate for pacing output (0 for unpaced)")
+parser.add_argument("--host", help="override host in sockon, e.g. 127.0.0.1")
+parser.add_argument("--latency", type=float, default=0.0, help="delay before each response in ms")
+parser.add_argument("--jitter", type=float, default=0.0, help="random extra delay up to this many ms")
+parser.add_argument("--drop", type=float, default=0.0, help="probability of dropping a command (no response)")
+parser.add_argument("--error", type=float, default=0.0, help="probability of responding AT-S.ERROR")
+parser.add_argument("--wifi-down", type=float, default=0.0, help="period in s to take Wi-Fi down (0 for never)")
+parser.add_argument("--down-time", type=float, default=2.0, help="time in s Wi-Fi stays down")
+parser.add_argument("--sockets", type=int, default=8, help="maximum number of open sockets")
+parser.add_argument("--seed", type=int, help="random seed for repeatable fault injection")
+parser.add_argument("--verbose", action="store_true", help="print commands and indications")
+args = parser.parse_args()
+
+if args.seed is not None:
+    random.seed(args.seed)
+
+def Log(text):
+    if args.verbose:
+        sys.stderr.write("%.3f %s\n" % (time.time(), text))
+
+class Uart:
+    def __init__(self):
+        if args.port:
+            self.fd = os.open(args.port, os.O_RDWR | os.O_NOCTTY)
+            self.name = args.port
+            tty.setraw(self.fd)
+            attr = termios.tcgetattr(self.fd)
+            speed = getattr(termios, "B%d" % args.baud)
+            attr[4] = attr[5] = speed
+            termios.tcsetattr(self.fd, termios.TCSANOW, attr)
+        else:
+            self.fd, slave = pty.openpty()
+            tty.setraw(slave)
+            self.name = os.ttyname(slave)
+        # Output is paced at one byte per 10 bit times (8N1).
+        self.byteTime = 10.0 / args.baud if args.baud else 0.0
+        self.outBytes = 0
+
+    def Write(self, data):
+        if isinstance(data, str):
+            data = data.encode("latin-1")
+        if not self.byteTime:
+            os.write(self.fd, data)
+        else:
+            # Write in small chunks to approximate the line rate without a syscall per byte.
+            for i in range(0, len(data), 16):
+                chunk = data[i:i + 16]
+                start = time.time()
+                os.write(self.fd, chunk)
+                remain = len(chunk) * self.byteTime - (time.time() - start)
+                if remain > 0:
+                    time.sleep(remain)
+        self.outBytes += len(data)
+
+class Socket:
+    def __init__(self, sock):
+        self.sock = sock
+        self.rxData = b""          # Data received from the TCP server, not yet read by sockr.
+        self.tx = 0
+        self.rx = 0
+
+class Modem:
+    def __init__(self, uart):
+        self.uart = uart
+        self.socks = {}            # Open sockets by id.
+        self.line = b""
+        self.writeRemain = 0       # Remaining data bytes of the current sockw.
+        self.writeSock = None      # Socket of the current sockw. None if closed.
+        self.writeData = b""
+        self.writeFail = None      # "drop" or "error" if the current sockw fails after its data.
+        self.skipEol = False       # Skip the second character of a "\n\r" terminator.
+        self.wifiUp = True
+        self.nextDown = time.time() + args.wifi_down if args.wifi_down else 0
+        self.upTime = 0
+        self.stat = {"cmd": 0, "drop": 0, "error": 0, "tx": 0, "rx": 0}
+
+    def Indicate(self, text):
+        Log("IND " + text)
+        self.uart.Write("+WIND:" + text + "\r\n")
+
+    def Respond(self, text):
+        delay = args.latency + random.uniform(0, args.jitter)
+        if delay:
+            time.sleep(delay / 1000.0)
+        self.uart.Write(text)
+
+    def Error(self):
+        self.stat["error"] += 1
+        self.Respond("AT-S.ERROR:0:Emulated error\r\n")
+
+    def Close(self, id):
+        s = self.socks.pop(id, None)
+        if s:
+            s.sock.close()
+            Log("socket %d closed tx=%d rx=%d" % (id, s.tx, s.rx))
+
+    def CloseAll(self):
+        for id in list(self.socks):
+            self.Close(id)
+
+    def GetSocket(self, param):
+        try:
+            return self.socks.get(int(param[0]))
+        except (ValueError, IndexError):
+            return None
+
+    def HandleCommand(self, cmd):
+        Log("CMD " + cmd)
+        self.stat["cmd"] += 1
+        name, _, param = cmd.partition("=")
+        name = name.lower()
+        param = param.split(",")
+        drop = random.random() < args.drop
+        error = not drop and ((random.random() < args.error) or not self.wifiUp)
+        if drop or error:
+            # Data of a failed sockw still arrive and must not be taken as the next command. They are
+            # discarded, and an error is reported after them.
+            if name == "at+s.sockw":
+                try:
+                    self.writeRemain = int(param[1])
+                except (ValueError, IndexError):
+                    self.writeRemain = 0
+                self.writeSock = None
+                self.writeData = b""
+                self.writeFail = "drop" if drop else "error"
+            if drop:
+                self.stat["drop"] += 1
+                Log("dropped")
+            elif not self.writeRemain:
+                self.Error()
+            return
+        if name == "at+s.sockon":
+            free = [i for i in range(args.sockets) if i not in self.socks]
+            if not free:
+                self.Respond("AT-S.ERROR:61:Too many sockets\r\n")
+                return
+            host = args.host or param[0]
+            try:
+                sock = socket.create_connection((host, int(param[1])), timeout=5)
+                sock.setblocking(False)
+            except (OSError, ValueError, IndexError) as e:
+                Log("sockon failed: %s" % e)
+                self.Respond("AT-S.ERROR:60:Failed to open socket\r\n")
+                return
+            self.socks[free[0]] = Socket(sock)
+            self.Respond(" ID: %02d\r\nAT-S.OK\r\n" % free[0])
+        elif name == "at+s.sockw":
+            try:
+                self.writeRemain = int(param[1])
+            except (ValueError, IndexError):
+                self.Respond("AT-S.ERROR:17:Invalid parameter\r\n")
+                return
+            # Data are consumed even if the socket is not open, and then discarded.
+            self.writeSock = self.GetSocket(param)
+            self.writeData = b""
+            self.writeFail = None
+            if self.writeRemain == 0:
+                self.Respond("AT-S.OK\r\n")
+        elif name == "at+s.sockr":
+            s = self.GetSocket(param)
+            if not s:
+                self.Respond("AT-S.ERROR:62:Socket not open\r\n")
+                return
+            size = len(s.rxData)
+            if len(param) > 1 and param[1]:
+                size = min(size, int(param[1]))
+            data, s.rxData = s.rxData[:size], s.rxData[size:]
+            self.Respond("AT-S.Reading:%d:%d\r\n" % (size, size))
+            self.uart.Write(data)
+            self.uart.Write("\r\nAT-S.OK\r\n")
+        elif name == "at+s.sockc":
+            s = self.GetSocket(param)
+            if not s:
+                self.Respond("AT-S.ERROR:62:Socket not open\r\n")
+                return
+            self.Close(int(param[0]))
+            self.Respond("AT-S.OK\r\n")
+        else:
+            self.Respond("AT-S.OK\r\n")
+
+    def HandleInput(self, data):
+        for c in data:
+            b = bytes([c])
+            if self.skipEol:
+                self.skipEol = False
+                if b in (b"\r", b"\n"):
+                    continue
+            if self.writeRemain:
+                self.writeData += b
+                self.writeRemain -= 1
+                if self.writeRemain == 0:
+                    if self.writeFail:
+                        if self.writeFail == "error":
+                            self.Error()
+                        continue
+                    self.stat["tx"] += len(self.writeData)
+                    s = self.writeSock
+                    if s and s in self.socks.values():
+                        s.tx += len(self.writeData)
+                        try:
+                            s.sock.sendall(self.writeData)
+                        except OSError:
+                            pass
+                    self.Respond("AT-S.OK\r\n")
+                continue
+            if b in (b"\r", b"\n"):
+                if self.line:
+                    line = self.line.decode("latin-1")
+                    self.line = b""
+                    # WifiSt terminates commands with "\n\r". Data of sockw follow the terminator.
+                    self.skipEol = True
+                    self.HandleCommand(line)
+                continue
+            self.line += b
+
+    def HandleSocket(self, id):
+        s = self.socks[id]
+        try:
+            data = s.sock.recv(4096)
+        except BlockingIOError:
+            return
+        except OSError:
+            data = b""
+        if not data:
+            self.Close(id)
+            self.Indicate("58:Socket Closed:%d:1" % id)
+            return
+        self.stat["rx"] += len(data)
+        s.rx += len(data)
+        s.rxData += data
+        self.Indicate("55:Pending Data:%d:%d" % (id, len(s.rxData)))
+
+    def Poll(self):
+        now = time.time()
+        if self.wifiUp and self.nextDown and now >= self.nextDown:
+            self.wifiUp = False
+            self.CloseAll()
+            self.Indicate("33:WiFi Network Lost")
+            self.upTime = now + args.down_time
+        elif not self.wifiUp and now >= self.upTime:
+            self.wifiUp = True
+            self.nextDown = now + args.wifi_down
+            self.Indicate("24:WiFi Up:1:127.0.0.1")
+
+uart = Uart()
+modem = Modem(uart)
+print("SPWF04 emulator on %s" % uart.name)
+sys.stdout.flush()
+modem.Indicate("1:Poweron:Emulated")
+modem.Indicate("24:WiFi Up:1:127.0.0.1")
+start = time.time()
+try:
+    while True:
+        fds = [uart.fd] + [s.sock for s in modem.socks.values()]
+        ready, _, _ = select.select(fds, [], [], 0.1)
+        if uart.fd in ready:
+            try:
+                modem.HandleInput(os.read(uart.fd, 1024))
+            except OSError:
+                # No process has opened the pty yet.
+                time.sleep(0.1)
+        for id, s in list(modem.socks.items()):
+            if s.sock in ready and id in modem.socks:
+                modem.HandleSocket(id)
+        modem.Poll()
+except KeyboardInterrupt:
+    elapsed = time.time() - start
+    s = modem.stat
+    print("\n%.1fs commands=%d dropped=%d errors=%d tx=%d (%.0f B/s) rx=%d uart out=%d (%.0f B/s)" %
+          (elapsed, s["cmd"], s["drop"], s["error"], s["tx"], s["tx"] / elapsed, s["rx"],
+           uart.outBytes, uart.outBytes / elapsed))
+    for id, sk in sorted(modem.socks.items()):
+        print("socket %d tx=%d (%.0f B/s) rx=%d" % (id, sk.tx, sk.tx / elapsed, sk.rx))
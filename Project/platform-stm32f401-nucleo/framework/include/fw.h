@@ -56,6 +56,54 @@ public:
     static Hsm *GetHsm(Hsmn hsmn);
     static QP::QActive *GetContainer(Hsmn hsmn);
 
+    // Publish-subscribe. Any HSM, including a region, can subscribe to a signal. A published event is
+    // posted once to the container of each subscriber, sharing a single allocation. See Publish().
+    // To reach subscribers within the same container synchronously, use Active::PublishSync() instead.
+    typedef uint64_t HsmnSet;   // Bit n is set for HSMN n.
+    static void Subscribe(QP::QSignal sig, Hsmn hsmn);
+    static void Unsubscribe(QP::QSignal sig, Hsmn hsmn);
+    static void Publish(Evt const *e);
+    static HsmnSet GetSubscriber(QP::QSignal sig, QP::QActive const *container = NULL);
+
+    // Event pool statistics. Counters are updated on every allocation and recycle of
+    // dynamic events and are read by console commands to size the event pools.
+    class PoolStat {
+    public:
+        uint32_t m_allocCnt;    // Number of events allocated from this pool.
+        uint32_t m_failCnt;     // Number of allocations which found this pool exhausted.
+        uint32_t m_reqBytes;    // Sum of requested event sizes, for average fill of blocks.
+        uint16_t m_maxReqSize;  // Largest requested event size.
+        uint16_t m_inUse;       // Number of blocks currently in use.
+        uint16_t m_peak;        // Peak number of blocks in use. Minimum-free watermark = count - peak.
+    };
+    class EvtCount {
+    public:
+        uint16_t m_curr;        // Number of live events.
+        uint16_t m_peak;        // Peak number of concurrent live events.
+        uint32_t m_total;       // Total number of events allocated.
+    };
+
+    static void *AllocEvt(uint32_t evtSize);
+#if FW_EVT_COUNT
+    static void OnEvtCreate(Evt const *e);
+#endif
+    static void OnEvtRecycle(QP::QEvt const *e, uint32_t poolIdx);
+    static uint32_t GetPoolCount() { return EVT_POOL_COUNT; }
+    static uint32_t GetPoolEvtSize(uint32_t index);
+    static uint32_t GetPoolEvtCount(uint32_t index);
+    static void GetPoolStat(uint32_t index, PoolStat &stat);
+#if FW_EVT_COUNT
+    static uint32_t GetSigCountSize() { return SIG_COUNT_SIZE; }
+    static bool GetSigCount(uint32_t index, QP::QSignal &sig, EvtCount &count);
+    static void GetSenderCount(Hsmn hsmn, EvtCount &count);
+    static uint32_t GetSigOverflowCnt() { return m_sigOverflowCnt; }
+#endif
+    static void ResetEvtStat();
+
+    // Post time of dynamic events for queueing latency. See Prof.
+    static void SetPostTime(QP::QEvt const *e);
+    static bool GetPostTime(QP::QEvt const *e, uint32_t &time);
+
 protected:
 
     enum {
@@ -65,14 +113,56 @@ protected:
         EVT_SIZE_LARGE = 256,
         EVT_COUNT_SMALL = 128,
         EVT_COUNT_MEDIUM = 16,
-        EVT_COUNT_LARGE = 4
+        EVT_COUNT_LARGE = 4,
+        EVT_BLOCK_COUNT = EVT_COUNT_SMALL + EVT_COUNT_MEDIUM + EVT_COUNT_LARGE
+    };
+
+    enum {
+        SIG_COUNT_ORDER = 6,    // Signal table is hashed with linear probing.
+        SIG_COUNT_SIZE = 1 << SIG_COUNT_ORDER,
     };
 
+    enum {
+        SUBSCR_ORDER = 5,       // Subscriber table is hashed with linear probing.
+        SUBSCR_SIZE = 1 << SUBSCR_ORDER,
+    };
+
+    class SigCount {
+    public:
+        QP::QSignal m_sig;      // 0 if entry is unused.
+        EvtCount m_count;
+    };
+
+    class Subscr {
+    public:
+        QP::QSignal m_sig;      // 0 if entry is unused.
+        HsmnSet m_hsmnSet;
+    };
+
+    static uint32_t HashSig(QP::QSignal sig, uint32_t order);
+    static Subscr *FindSubscr(QP::QSignal sig, bool add);
+    static uint32_t GetBlockIndex(void const *e);
+#if FW_EVT_COUNT
+    static EvtCount *FindSigCount(QP::QSignal sig, bool add);
+    static void IncCount(EvtCount &count);
+    static void DecCount(EvtCount &count);
+#endif
+
     static HsmAct m_hsmActStor[MAX_HSM_COUNT];
     static HsmActMap m_hsmActMap;
     static uint32_t m_evtPoolSmall[ROUND_UP_DIV_4(EVT_SIZE_SMALL * EVT_COUNT_SMALL)];
     static uint32_t m_evtPoolMedium[ROUND_UP_DIV_4(EVT_SIZE_MEDIUM * EVT_COUNT_MEDIUM)];
     static uint32_t m_evtPoolLarge[ROUND_UP_DIV_4(EVT_SIZE_LARGE * EVT_COUNT_LARGE)];
+    static uint32_t const m_evtPoolSize[EVT_POOL_COUNT];
+    static uint32_t const m_evtPoolCount[EVT_POOL_COUNT];
+    static PoolStat m_poolStat[EVT_POOL_COUNT];
+#if FW_EVT_COUNT
+    static SigCount m_sigCount[SIG_COUNT_SIZE];
+    static EvtCount m_senderCount[MAX_HSM_COUNT];
+    static uint32_t m_sigOverflowCnt;   // Number of events not counted since signal table is full.
+#endif
+    static uint32_t m_postTime[EVT_BLOCK_COUNT];    // Indexed by GetBlockIndex().
+    static Subscr m_subscr[SUBSCR_SIZE];
 };
 
 } // namespace FW
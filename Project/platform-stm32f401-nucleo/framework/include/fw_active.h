@@ -40,41 +40,62 @@
 #define FW_ACTIVE_H
 
 #include <stdint.h>
+#include <type_traits>
 #include "qpcpp.h"
 #include "fw_hsm.h"
 #include "fw_maptype.h"
+#include "fw_regtable.h"
 #include "fw_evt.h"
+#include "fw_log.h"
 
 namespace FW {
 
-class Active : public QP::QActive {
+// Common part of Active (based on QActive) and MActive (based on QMActive). It routes events to the
+// active object itself or to its regions, which can be Region or MRegion.
+// Only instantiated for QP::QActive and QP::QMActive (see fw_active.cpp).
+template <class QBase>
+class ActiveBase : public QBase {
 public:
-    Active(QP::QStateHandler const initial, Hsmn hsmn, char const *name) :
-        QP::QActive(initial),
-        m_hsm(hsmn, name, this),
-        m_hsmnRegMap(m_hsmnRegStor, ARRAY_COUNT(m_hsmnRegStor), HsmnReg(HSM_UNDEF, NULL)){
-    }
     void Start(uint8_t prio);
     void Add(Region *reg);
+    void Add(MRegion *reg);
     Hsm &GetHsm() { return m_hsm; }
     Hsmn GetHsmn() const { return m_hsm.GetHsmn(); }
     Sequence GenSeq() { return m_hsm.GenSeq(); }
 
+    // Compile-time log verbosity ceiling. A derived class may redefine it. See LOG_CEILING() in fw_log.h.
+    enum {
+        LOG_CEILING = Log::MAX_VERBOSITY
+    };
+
     virtual void dispatch(QP::QEvt const * const e);
 
 protected:
+    ActiveBase(QP::QStateHandler const initial, Hsmn hsmn, char const *name) :
+        QBase(initial),
+        m_hsm(hsmn, name, this, std::is_base_of<QP::QMActive, QBase>::value) {
+    }
+    void AddRegion(Hsm &hsm, QP::QHsm *reg);
+    void DispatchTo(Hsmn hsmn, QP::QEvt const * const e);
     void PostSync(Evt const *e);
+    void PublishSync(Evt const *e);
 
     enum {
         MAX_REGION_COUNT = 8,
         EVT_QUEUE_COUNT = 64 //16
     };
     Hsm m_hsm;
-    HsmnReg m_hsmnRegStor[MAX_REGION_COUNT];
-    HsmnRegMap m_hsmnRegMap;
+    HsmnRegTable<MAX_REGION_COUNT> m_hsmnRegTable;
     QP::QEvt const *m_evtQueueStor[EVT_QUEUE_COUNT];
 };
 
+class Active : public ActiveBase<QP::QActive> {
+public:
+    Active(QP::QStateHandler const initial, Hsmn hsmn, char const *name) :
+        ActiveBase<QP::QActive>(initial, hsmn, name) {
+    }
+};
+
 } // namespace FW
 
 
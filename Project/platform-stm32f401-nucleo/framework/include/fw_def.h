@@ -87,6 +87,7 @@ typedef uint16_t Sequence;
 
 enum {
     CTRLC = 0x03,
+    CTRLD = 0x04,
     BS  = 0x08,
     LF  = 0x0A,
     CR  = 0x0D,
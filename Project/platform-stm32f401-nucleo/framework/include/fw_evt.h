@@ -46,6 +46,13 @@
 #define EVT_CAST(e_)            static_cast<FW::Evt const &>(e_)
 #define ERROR_EVT_CAST(e_)      static_cast<FW::ErrorEvt const &>(e_)
 
+// Set FW_EVT_COUNT to 1 (e.g. in compiler options) to count live events by signal and by sender for
+// "sys pool". It adds a hashed table lookup in a critical section to every event creation and recycle.
+// Pool statistics are always kept. See Fw::OnEvtCreate().
+#ifndef FW_EVT_COUNT
+#define FW_EVT_COUNT 0
+#endif
+
 namespace FW {
 
 class Evt : public QP::QEvt {
@@ -54,7 +61,11 @@ public:
     static void operator delete(void *evt);
 
     Evt(QP::QSignal signal, Hsmn to, Hsmn from = HSM_UNDEF, Sequence seq = 0) :
-        QP::QEvt(signal), m_to(to), m_from(from), m_seq(seq) {}
+        QP::QEvt(signal), m_to(to), m_from(from), m_seq(seq) {
+#if FW_EVT_COUNT
+        OnCreate(this);
+#endif
+    }
     ~Evt() {}
 
     Hsmn GetTo() const { return m_to; }
@@ -62,6 +73,10 @@ public:
     Sequence GetSeq() const { return m_seq; }
 
 protected:
+#if FW_EVT_COUNT
+    static void OnCreate(Evt const *e);
+#endif
+
     Hsmn m_to;
     Hsmn m_from;
     Sequence m_seq;
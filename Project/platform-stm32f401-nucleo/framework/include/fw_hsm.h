@@ -60,7 +60,8 @@ typedef Map<Hsmn, Sequence> HsmnSeqMap;
 
 class Hsm {
 public:
-    Hsm(Hsmn hsmn, char const *name, QP::QHsm *qhsm);
+    // isMsm is true if qhsm is a QMsm or QMActive (see MRegion and MActive).
+    Hsm(Hsmn hsmn, char const *name, QP::QHsm *qhsm, bool isMsm = false);
     void Init(QP::QActive *container);
 
     Hsmn GetHsmn() const { return m_hsmn; }
@@ -106,6 +107,12 @@ public:
     void PostReminder(QP::QEvt const *e) { m_reminderQueue.post(e, QP::QF_NO_MARGIN); }
     void DispatchReminder();
 
+    // High-water marks since initialization. Capacity of a queue includes its front event.
+    uint32_t GetDeferCapacity() const { return DEFER_QUEUE_COUNT + 1; }
+    uint32_t GetDeferHighWater() const { return GetDeferCapacity() - m_deferEQueue.getNMin(); }
+    uint32_t GetReminderCapacity() const { return REMINDER_QUEUE_COUNT + 1; }
+    uint32_t GetReminderHighWater() const { return GetReminderCapacity() - m_reminderQueue.getNMin(); }
+
 protected:
     enum {
         OUT_HSMN_SEQ_MAP_COUNT = 16,
@@ -116,6 +123,7 @@ protected:
     Hsmn m_hsmn;
     char const * m_name;
     QP::QHsm *m_qhsm;
+    bool m_isMsm;
     char const *m_state;
     Sequence m_nextSequence;
     DeferEQueue m_deferEQueue;
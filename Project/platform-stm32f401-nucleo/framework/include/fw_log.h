@@ -39,6 +39,8 @@
 #ifndef FW_LOG_H
 #define FW_LOG_H
 
+#include <stdarg.h>
+#include <type_traits>
 #include "fw_def.h"
 #include "fw_error.h"
 #include "fw_map.h"
@@ -49,27 +51,57 @@
 
 #define FW_LOG_ASSERT(t_) ((t_) ? (void)0 : Q_onAssert("fw_log.h", (int_t)__LINE__))
 
+// Set FW_LOG_BIN to 0 (e.g. in compiler options) to remove binary logging. See Log::BinMode.
+#ifndef FW_LOG_BIN
+#define FW_LOG_BIN 1
+#endif
+
+// Set FW_LOG_LOSSLESS to 0 (e.g. in compiler options) to remove lossless mode and its stage pool of
+// FW_LOG_STAGE_COUNT records of Log::BUF_LEN bytes each. See Log::SetLossless().
+#ifndef FW_LOG_LOSSLESS
+#define FW_LOG_LOSSLESS 1
+#endif
+#ifndef FW_LOG_STAGE_COUNT
+#define FW_LOG_STAGE_COUNT 16
+#endif
+
 namespace FW {
 
 #define SET_EVT_NAME(evtHsmn_)   Log::SetEvtName(evtHsmn_, timerEvtName, ARRAY_COUNT(timerEvtName), \
                                                  internalEvtName, ARRAY_COUNT(internalEvtName), \
                                                  interfaceEvtName, ARRAY_COUNT(interfaceEvtName))
 #define PRINT(format_, ...)      Log::Print(HSM_UNDEF, format_, ## __VA_ARGS__)
+// Compile-time verbosity ceiling of the HSM class of "me". The default LOG_CEILING is defined in Active and
+// Region. A derived class may redefine it so that log calls of types at or above it compile to nothing.
+#define LOG_CEILING()            (std::remove_pointer<decltype(me)>::type::LOG_CEILING)
+#define LOG_DEBUG(type_, format_, ...) \
+    (Log::IsCompiled(type_, LOG_CEILING()) ? Log::Debug(type_, me->GetHsm().GetHsmn(), format_, ## __VA_ARGS__) : (void)0)
 // The following macros can only be used within an HSM. Newline is automatically appended.
-#define EVENT(e_)                Log::Event(Log::TYPE_LOG, me->GetHsm().GetHsmn(), e_, __FUNCTION__);
-#define INFO(format_, ...)       Log::Debug(Log::TYPE_INFO, me->GetHsm().GetHsmn(), format_, ## __VA_ARGS__)
-#define LOG(format_, ...)        Log::Debug(Log::TYPE_LOG, me->GetHsm().GetHsmn(), format_, ## __VA_ARGS__)
-#define CRITICAL(format_, ...)   Log::Debug(Log::TYPE_CRITICAL, me->GetHsm().GetHsmn(), format_, ## __VA_ARGS__)
-#define WARNING(format_, ...)    Log::Debug(Log::TYPE_WARNING, me->GetHsm().GetHsmn(), format_, ## __VA_ARGS__)
-#define ERROR(format_, ...)      Log::Debug(Log::TYPE_ERROR, me->GetHsm().GetHsmn(), format_, ## __VA_ARGS__)
+// When EVENT is compiled out, it still tracks the current state on entry.
+#define EVENT_STATE(e_, state_)  (Log::IsCompiled(Log::TYPE_LOG, LOG_CEILING()) ? \
+                                  Log::Event(Log::TYPE_LOG, me->GetHsm().GetHsmn(), e_, state_) : \
+                                  (((e_)->sig == Q_ENTRY_SIG) ? me->GetHsm().SetState(state_) : (void)0));
+#define EVENT(e_)                EVENT_STATE(e_, __FUNCTION__)
+// For entry, exit and initial actions of QMsm-style states (see MRegion) which are not passed an event.
+// The state name is passed explicitly since the function name has a suffix, e.g. EVENT_ENTRY(On) in On_e().
+#define EVENT_ENTRY(state_)      EVENT_STATE(Log::GetBuiltinEvt(Q_ENTRY_SIG), #state_)
+#define EVENT_EXIT(state_)       EVENT_STATE(Log::GetBuiltinEvt(Q_EXIT_SIG), #state_)
+#define EVENT_INIT(state_)       EVENT_STATE(Log::GetBuiltinEvt(Q_INIT_SIG), #state_)
+#define INFO(format_, ...)       LOG_DEBUG(Log::TYPE_INFO, format_, ## __VA_ARGS__)
+#define LOG(format_, ...)        LOG_DEBUG(Log::TYPE_LOG, format_, ## __VA_ARGS__)
+#define CRITICAL(format_, ...)   LOG_DEBUG(Log::TYPE_CRITICAL, format_, ## __VA_ARGS__)
+#define WARNING(format_, ...)    LOG_DEBUG(Log::TYPE_WARNING, format_, ## __VA_ARGS__)
+#define ERROR(format_, ...)      LOG_DEBUG(Log::TYPE_ERROR, format_, ## __VA_ARGS__)
 
 #define PRINT_BUF(buf_, len_, unit_, label_)    Log::PrintBuf(HSM_UNDEF, buf_, len_, unit_, label_)
+#define LOG_DEBUG_BUF(type_, buf_, len_, unit_, label_) \
+    (Log::IsCompiled(type_, LOG_CEILING()) ? Log::DebugBuf(type_, me->GetHsm().GetHsmn(), buf_, len_, unit_, label_) : (void)0)
 // The following macros can only be used within an HSM. Newline is automatically appended.
-#define INFO_BUF(buf_, len_, unit_, label_)     Log::DebugBuf(Log::TYPE_INFO, me->GetHsm().GetHsmn(), buf_, len_, unit_, label_)
-#define LOG_BUF(buf_, len_, unit_, label_)      Log::DebugBuf(Log::TYPE_LOG, me->GetHsm().GetHsmn(), buf_, len_, unit_, label_)
-#define CRITICAL_BUF(buf_, len_, unit_, label_) Log::DebugBuf(Log::TYPE_CRITICAL, me->GetHsm().GetHsmn(), buf_, len_, unit_, label_)
-#define WARNING_BUF(buf_, len_, unit_, label_)  Log::DebugBuf(Log::TYPE_WARNING, me->GetHsm().GetHsmn(), buf_, len_, unit_, label_)
-#define ERROR_BUF(buf_, len_, unit_, label_)    Log::DebugBuf(Log::TYPE_ERROR, me->GetHsm().GetHsmn(), buf_, len_, unit_, label_)
+#define INFO_BUF(buf_, len_, unit_, label_)     LOG_DEBUG_BUF(Log::TYPE_INFO, buf_, len_, unit_, label_)
+#define LOG_BUF(buf_, len_, unit_, label_)      LOG_DEBUG_BUF(Log::TYPE_LOG, buf_, len_, unit_, label_)
+#define CRITICAL_BUF(buf_, len_, unit_, label_) LOG_DEBUG_BUF(Log::TYPE_CRITICAL, buf_, len_, unit_, label_)
+#define WARNING_BUF(buf_, len_, unit_, label_)  LOG_DEBUG_BUF(Log::TYPE_WARNING, buf_, len_, unit_, label_)
+#define ERROR_BUF(buf_, len_, unit_, label_)    LOG_DEBUG_BUF(Log::TYPE_ERROR, buf_, len_, unit_, label_)
 
 class Log {
 public:
@@ -100,12 +132,27 @@ public:
         BYTE_PER_LINE = 16
     };
 
+    enum {
+        MAX_DEFAULT_INF = 4,    // Maximum number of default interfaces.
+        STAGE_COUNT = FW_LOG_LOSSLESS ? FW_LOG_STAGE_COUNT : 0,    // Number of records in the stage pool.
+    };
+
+    // In binary modes, Event() and Debug() only record the format string address and raw arguments
+    // into a ring. Formatting is deferred to FlushBin() which is called in idle time.
+    enum BinMode {
+        BIN_OFF,                // Format immediately (default).
+        BIN_TEXT,               // Records are rendered to text by FlushBin().
+        BIN_RAW,                // Records are written as hex lines to be decoded on host by LogDecode.py.
+        NUM_BIN_MODE
+    };
+
     // Set event names for an HSM.
     static void SetEvtName(Hsmn evtHsmn, EvtName timerEvtName, EvtCount timerEvtCount,
                            EvtName internalEvtName, EvtCount internalEvtCount,
                            EvtName interfaceEvtName, EvtCount interfaceEvtCount);
     static char const *GetEvtName(QP::QSignal signal);
     static char const *GetBuiltinEvtName(QP::QSignal signal);
+    static QP::QEvt const *GetBuiltinEvt(QP::QSignal signal);
     static char const *GetUndefName() { return m_undefName; }
 
     // Add and remove output device interface.
@@ -119,6 +166,8 @@ public:
     static uint32_t PutStr(Hsmn infHsmn, char const *str);
     static void PutStrOver(Hsmn infHsmn, char const *str, uint32_t oldLen);
     static uint32_t Print(Hsmn infHsmn, char const *format, ...);
+    static uint32_t PrintFifo(Fifo &fifo, bool *status, char const *format, ...);
+    static uint32_t VPrintFifo(Fifo &fifo, bool *status, char const *format, va_list arg);
     static uint32_t PrintItem(Hsmn infHsmn, uint32_t index, uint32_t minWidth, uint32_t itemPerLine, char const *format, ...);
     static void Event(Type type, Hsmn hsmn, QP::QEvt const *e, char const *func);
     static void Debug(Type type, Hsmn hsmn, char const *format, ...);
@@ -126,6 +175,9 @@ public:
     static uint32_t PrintBuf(Hsmn infHsmn, uint8_t const *dataBuf, uint32_t dataLen, uint8_t align = 1, uint32_t label = 0);
     static void DebugBuf(Type type, Hsmn hsmn, uint8_t const *dataBuf, uint32_t dataLen, uint8_t align = 1, uint32_t label = 0);
 
+    // True if a log call of type is compiled in an HSM class with the verbosity ceiling. See LOG_CEILING().
+    static constexpr bool IsCompiled(Type type, uint32_t ceiling) { return static_cast<uint32_t>(type) < ceiling; }
+
     static uint8_t GetVerbosity() { return m_verbosity; }
     static void SetVerbosity(uint8_t v) {
         FW_LOG_ASSERT(v <= MAX_VERBOSITY);
@@ -137,6 +189,40 @@ public:
     static void OffAll();
     static bool IsOn(Hsmn hsmn) { return m_on.IsSet(hsmn); }
 
+#if FW_LOG_BIN
+    static BinMode GetBinMode() { return m_binMode; }
+    static void SetBinMode(BinMode mode) {
+        FW_LOG_ASSERT(mode < NUM_BIN_MODE);
+        m_binMode = mode;
+    }
+    static char const *GetBinModeName(BinMode mode);
+    static bool FlushBin();
+#else
+    static BinMode GetBinMode() { return BIN_OFF; }
+    static void SetBinMode(BinMode mode) { (void)mode; }
+    static char const *GetBinModeName(BinMode mode) { (void)mode; return m_undefName; }
+    static bool FlushBin() { return false; }
+#endif
+
+    // In lossless mode, output to default interfaces which does not fit in a FIFO is staged in a pool rather
+    // than truncated, and written by FlushStaged() when the FIFO has drained (e.g. on UART_OUT_EMPTY_IND).
+    // Output longer than BUF_LEN is staged in consecutive records. Output is only dropped when the pool is
+    // exhausted.
+#if FW_LOG_LOSSLESS
+    static bool IsLossless() { return m_lossless; }
+    static void SetLossless(bool lossless) { m_lossless = lossless; }
+    static void FlushStaged(Hsmn infHsmn);
+#else
+    static bool IsLossless() { return false; }
+    static void SetLossless(bool lossless) { (void)lossless; }
+    static void FlushStaged(Hsmn infHsmn) { (void)infHsmn; }
+#endif
+    // @param dropByteCnt - Number of bytes dropped due to full FIFOs or pool.
+    // @param stallCnt - Number of writes which found a FIFO full in lossless mode.
+    // @param stageCnt - Number of records currently staged.
+    static void GetStat(uint32_t &dropByteCnt, uint32_t &stallCnt, uint32_t &stageCnt);
+    static void ClearStat();
+
     static char const *GetHsmName(Hsmn hsmn);
     static char const *GetTypeName(Type type);
     static char const *GetState(Hsmn hsmn);
@@ -164,16 +250,128 @@ private:
     typedef KeyValue<Hsmn, Inf> HsmnInf;
     typedef Map<Hsmn, Inf> HsmnInfMap;
 
+    // An entry in the compact list of default interfaces, so that writes in default mode do not need to
+    // search m_hsmnInfMap.
+    class DefaultInf {
+    public:
+        Hsmn m_hsmn;
+        Fifo *m_fifo;
+        QP::QSignal m_sig;
+        uint32_t m_stageCnt;    // Number of records staged for this interface. Always 0 without lossless mode.
+    };
+
+#if FW_LOG_LOSSLESS
+    // A record staged in lossless mode. A record in m_stageStor is free if m_infHsmn is HSM_UNDEF.
+    class StageRec {
+    public:
+        StageRec *m_next;
+        Hsmn m_infHsmn;
+        uint32_t m_len;
+        uint8_t m_buf[BUF_LEN];
+    };
+#endif
+
+    // A line of output being formatted directly into the reserved free space of a FIFO.
+    // See BeginLine(), AppendLine() and EndLine().
+    class Line {
+    public:
+        Line() : m_fifo(NULL), m_infHsmn(HSM_UNDEF), m_sig(0), m_isDefault(false),
+                 m_len(0), m_ok(false) {}
+        Fifo *m_fifo;           // FIFO in which space is reserved.
+        Hsmn m_infHsmn;         // HSMN of the interface owning m_fifo. HSM_UNDEF if not an interface.
+        QP::QSignal m_sig;      // Signal to notify the interface. 0 if not an interface.
+        bool m_isDefault;       // True if the line is to be written to all default interfaces.
+        Fifo::Span m_span;      // Reserved space.
+        uint32_t m_len;         // Length formatted so far.
+        bool m_ok;              // False if formatting has failed, e.g. not enough space.
+    };
+#if FW_LOG_BIN
+    enum {
+        BIN_RECORD_ORDER = 5,
+        BIN_RECORD_COUNT = 1 << BIN_RECORD_ORDER,
+        BIN_ARG_COUNT = 8,      // Maximum number of 32-bit words of arguments per record.
+        BIN_SPEC_LEN = 16,      // Maximum length of a conversion specification, e.g. "%-08lx".
+        BIN_EVENT = NUM_TYPE    // Type of a record made by Event().
+    };
+
+    // Argument class of a conversion specification. It determines the type passed to va_arg().
+    enum ArgClass {
+        ARG_NONE,               // "%%"
+        ARG_INT,
+        ARG_LONG,
+        ARG_LONG_LONG,
+        ARG_SIZE,
+        ARG_DOUBLE,
+        ARG_PTR,
+        ARG_STR,
+        ARG_INVALID
+    };
+
+    class BinRecord {
+    public:
+        uint32_t m_time;            // System time in ms.
+        char const *m_name;         // HSM name.
+        char const *m_format;
+        Hsmn m_hsmn;
+        uint8_t m_type;             // Type, or BIN_EVENT.
+        uint8_t m_argCnt;           // Number of words used in m_arg.
+        uint32_t m_arg[BIN_ARG_COUNT];
+    };
+
+    static bool RecordBin(uint8_t type, Hsmn hsmn, char const *name, char const *format, ...);
+    static bool VRecordBin(uint8_t type, Hsmn hsmn, char const *name, char const *format, va_list arg);
+    static bool PutBinArg(BinRecord &rec, void const *val, uint32_t size);
+    static void GetBinArg(BinRecord const &rec, uint32_t &index, void *val, uint32_t size);
+    static uint32_t RenderBin(BinRecord const &rec, char *buf, uint32_t bufLen);
+    static uint32_t EncodeBin(BinRecord const &rec, char *buf, uint32_t bufLen);
+    static char const *ParseSpec(char const *p, ArgClass &argClass, uint32_t &starCnt);
+    static bool IsConstAddr(void const *addr);
+#endif
+
+    static bool WriteDefaultNoCrit(DefaultInf &inf, uint8_t const *buf0, uint32_t len0,
+                                   uint8_t const *buf1 = NULL, uint32_t len1 = 0);
+#if FW_LOG_LOSSLESS
+    static bool StageNoCrit(DefaultInf &inf, uint8_t const *buf0, uint32_t len0, uint8_t const *buf1, uint32_t len1);
+    static void FreeStagedNoCrit(Hsmn infHsmn);
+#endif
+
+    static bool BeginLine(Line &line, Hsmn infHsmn, Fifo *fifo = NULL);
+    static void AppendLine(Line &line, char const *format, ...);
+    static void VAppendLine(Line &line, char const *format, va_list arg);
+    static bool EndLine(Line &line, bool *status = NULL);
+
     static uint8_t m_verbosity;
     static uint32_t m_onStor[ROUND_UP_DIV(MAX_HSM_COUNT, 32)];
     static Bitset m_on;
     static HsmnInf m_hsmnInfStor[MAX_HSM_COUNT];
     static HsmnInfMap m_hsmnInfMap;
+    static DefaultInf m_defaultInf[MAX_DEFAULT_INF];
+    static uint32_t m_defaultInfCount;
+#if FW_LOG_LOSSLESS
+    static bool m_lossless;
+    static StageRec m_stageStor[STAGE_COUNT];
+    static StageRec *m_stageHead;       // Staged records of all default interfaces in order written.
+    static StageRec *m_stageTail;
+    static uint32_t m_stageCnt;
+#endif
+    static uint32_t m_dropByteCnt;
+    static uint32_t m_stallCnt;
     static char const * const m_typeName[NUM_TYPE];
     static char const m_truncatedError[];
     static QP::QSignal const m_entrySig;
     static char const * const m_builtinEvtName[];
+    static QP::QEvt const m_builtinEvt[];
     static char const m_undefName[];
+    static char const m_evtFromFormat[];
+    static char const m_evtFormat[];
+#if FW_LOG_BIN
+    static BinMode m_binMode;
+    static char const * const m_binModeName[NUM_BIN_MODE];
+    static BinRecord m_binRing[BIN_RECORD_COUNT];
+    static uint32_t m_binHead;          // Index of next record to write. Wraps around naturally.
+    static uint32_t m_binTail;          // Index of next record to flush.
+    static uint32_t m_binDropCnt;       // Number of records dropped since ring is full.
+#endif
 };
 
 } // namespace FW
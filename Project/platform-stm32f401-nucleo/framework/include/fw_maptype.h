@@ -46,12 +46,10 @@
 namespace FW {
 
 class Region;
+class MRegion;
 class Hsm;
 
 // Common map types used by the framework.
-typedef KeyValue<Hsmn, Region *> HsmnReg;
-typedef Map<Hsmn, Region *> HsmnRegMap;
-
 typedef KeyValue<Hsm *, QP::QActive *> HsmAct;
 typedef Map<Hsm *, QP::QActive *> HsmActMap;
 
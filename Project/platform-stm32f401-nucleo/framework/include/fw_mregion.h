@@ -0,0 +1,90 @@
+/*******************************************************************************
+ * Copyright (C) Gallium Studio LLC. All rights reserved.
+ *
+ * This program is open source software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Alternatively, this program may be distributed and modified under the
+ * terms of Gallium Studio LLC commercial licenses, which expressly supersede
+ * the GNU General Public License and are specifically designed for licensees
+ * interested in retaining the proprietary status of their code.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * Contact information:
+ * Website - https://www.galliumstudio.com
+ * Source repository - https://github.com/galliumstudio
+ * Email - admin@galliumstudio.com
+ ******************************************************************************/
+
+#ifndef FW_MREGION_H
+#define FW_MREGION_H
+
+#include <stdint.h>
+#include "qpcpp.h"
+#include "fw_hsm.h"
+#include "fw_evt.h"
+#include "fw_log.h"
+
+namespace FW {
+
+class Active;
+class MActive;
+class XThread;
+
+// Region based on QMsm. Transitions execute transition-action tables prepared at compile time instead of
+// discovering the exit and entry paths at runtime. It supports the same Hsm features as Region, and can be
+// contained in an Active, MActive or XThread.
+// States are coded in the QMsm style (see Fan). Use EVENT_ENTRY(), EVENT_EXIT() and EVENT_INIT() with the state
+// name in entry, exit and initial actions which are not passed an event.
+class MRegion : public QP::QMsm {
+public:
+    MRegion(QP::QStateHandler const initial, Hsmn hsmn, char const *name) :
+        QP::QMsm(initial),
+        m_hsm(hsmn, name, this, true),
+        m_container(NULL) {}
+
+    void Init(Active *container);
+    void Init(MActive *container);
+    void Init(XThread *container);
+    Hsm &GetHsm() { return m_hsm; }
+    Hsmn GetHsmn() const { return m_hsm.GetHsmn(); }
+    Sequence GenSeq() { return m_hsm.GenSeq(); }
+
+    // Compile-time log verbosity ceiling. A derived class may redefine it. See LOG_CEILING() in fw_log.h.
+    enum {
+        LOG_CEILING = Log::MAX_VERBOSITY
+    };
+
+    virtual void dispatch(QP::QEvt const * const e);
+
+protected:
+    void PostSync(Evt const *e);
+    QP::QActive *GetContainer() { return m_container; }
+
+    Hsm m_hsm;
+    QP::QActive *m_container;
+};
+
+} // namespace FW
+
+#endif // FW_MREGION_H
@@ -52,9 +52,33 @@ namespace FW {
 template <class Type>
 class Pipe {
 public:
+    enum {
+        COMPACT_CHUNK = 32      // Maximum number of entries moved in a critical section by Commit().
+    };
+
+    // Free space reserved by Reserve(). It consists of up to two contiguous blocks. The second block
+    // is non-empty only when the reserved space wraps around the end of storage.
+    class Span {
+    public:
+        Span() { Clear(); }
+        void Clear() {
+            m_buf[0] = m_buf[1] = NULL;
+            m_len[0] = m_len[1] = 0;
+        }
+        Type *GetBuf(uint32_t i) const { FW_PIPE_ASSERT(i < 2); return m_buf[i]; }
+        uint32_t GetLen(uint32_t i) const { FW_PIPE_ASSERT(i < 2); return m_len[i]; }
+        uint32_t GetTotalLen() const { return m_len[0] + m_len[1]; }
+    private:
+        Type *m_buf[2];
+        uint32_t m_len[2];
+        friend class Pipe;
+        // Use built-in memberwise copy constructor and assignment operator.
+    };
+
     Pipe(Type stor[], uint8_t order) :
         m_stor(stor), m_mask(BIT_MASK_OF_SIZE(order)),
-        m_writeIndex(0), m_readIndex(0), m_truncated(false) {
+        m_writeIndex(0), m_readIndex(0), m_truncated(false), m_reserved(false),
+        m_reserveIndex(0), m_reserveCount(0) {
         // Arithmetic in this class (m_mask + 1) assumes order < 32.
         // BIT_MASK_OF_SIZE() assumes order > 0
         FW_PIPE_ASSERT(stor && (order > 0) and (order < 32));
@@ -67,9 +91,13 @@ public:
         m_writeIndex = 0;
         m_readIndex = 0;
         m_truncated = false;
+        m_reserved = false;
+        m_reserveIndex = 0;
+        m_reserveCount = 0;
         QF_CRIT_EXIT(crit);
     }
     bool IsTruncated() const { return m_truncated; }
+    bool IsReserved() const { return m_reserved; }
     uint32_t GetWriteIndex() const { return m_writeIndex; }
     uint32_t GetReadIndex() const { return m_readIndex; }
     uint32_t GetUsedCount() const {
@@ -79,8 +107,9 @@ public:
         QF_CRIT_EXIT(crit);
         return count;
     }
+    // While a reservation is outstanding, only the entries before it are regarded as used (i.e. readable).
     uint32_t GetUsedCountNoCrit() const {
-        return (m_writeIndex - m_readIndex) & m_mask;
+        return ((m_reserved ? m_reserveIndex : m_writeIndex) - m_readIndex) & m_mask;
     }
     uint32_t GetAvailCount() const {
         QF_CRIT_STAT_TYPE crit;
@@ -140,9 +169,11 @@ public:
     }
 
     // Without critical section.
+    // While a reservation is outstanding (see Reserve()), the entries are written after the reserved space
+    // and do not become visible to the reader until Commit() is called.
     uint32_t WriteNoCrit(Type const *src, uint32_t count, bool *status = NULL) {
         FW_PIPE_ASSERT(src);
-        bool wasEmpty = IsEmpty();
+        bool wasEmpty = IsEmpty() && !m_reserved;
         if (count > GetAvailCountNoCrit()) {
             m_truncated = true;
             count = 0;
@@ -166,6 +197,108 @@ public:
         return count;
     }
 
+    // Reserves up to maxCount entries of free space starting at the write index, so that a producer can
+    // fill them in place (e.g. format text directly into them) rather than writing through an intermediate
+    // buffer. The reserved entries are not visible to the reader until Commit() is called.
+    // Only one reservation can be outstanding at a time. While it is outstanding, another Reserve() returns 0
+    // and Write() writes after the reserved space. The caller should reserve no more than it needs, and must
+    // release it with Commit() or Cancel() as soon as possible.
+    // Return the total count reserved, which can be less than maxCount (or 0 if the pipe is full).
+    // span is set to the reserved space.
+    uint32_t Reserve(uint32_t maxCount, Span &span) {
+        QF_CRIT_STAT_TYPE crit;
+        QF_CRIT_ENTRY(crit);
+        maxCount = ReserveNoCrit(maxCount, span);
+        QF_CRIT_EXIT(crit);
+        return maxCount;
+    }
+
+    // Without critical section.
+    uint32_t ReserveNoCrit(uint32_t maxCount, Span &span) {
+        span.Clear();
+        if (m_reserved) {
+            return 0;
+        }
+        uint32_t count = LESS(maxCount, GetAvailCountNoCrit());
+        if (count == 0) {
+            return 0;
+        }
+        m_reserved = true;
+        m_reserveIndex = m_writeIndex;
+        m_reserveCount = count;
+        uint32_t partial = LESS(count, m_mask + 1 - m_writeIndex);
+        span.m_buf[0] = &m_stor[m_writeIndex];
+        span.m_len[0] = partial;
+        if (count > partial) {
+            span.m_buf[1] = &m_stor[0];
+            span.m_len[1] = count - partial;
+        }
+        IncIndex(m_writeIndex, count);
+        return count;
+    }
+
+    // Publishes the first count entries of the outstanding reservation (count can be less than the count
+    // reserved) and releases the reservation, along with any entries written after it in the meantime.
+    // The unused part of the reservation is removed by moving those entries back. It is done in steps of
+    // at most COMPACT_CHUNK entries, each in its own critical section (see Compact()), so that the
+    // interrupt latency does not depend on how much has been written during the reservation.
+    // status has the same meaning as in Write().
+    // It does not affect m_truncated, so that a truncation before or during the reservation is still
+    // reported by IsTruncated().
+    void Commit(uint32_t count, bool *status = NULL) {
+        QF_CRIT_STAT_TYPE crit;
+        QF_CRIT_ENTRY(crit);
+        bool pending = CommitNoCrit(count, status);
+        QF_CRIT_EXIT(crit);
+        if (pending) {
+            bool compactStatus = false;
+            Compact(&compactStatus);
+            if (status) {
+                *status = *status || compactStatus;
+            }
+        }
+    }
+
+    // Without critical section.
+    // It publishes the committed entries and moves at most COMPACT_CHUNK entries. If it returns true,
+    // the pipe stays reserved (i.e. Reserve() returns 0 and entries written meanwhile are not visible)
+    // until the caller has called Compact() outside the critical section.
+    bool CommitNoCrit(uint32_t count, bool *status = NULL) {
+        FW_PIPE_ASSERT(m_reserved && (count <= m_reserveCount));
+        bool wasEmpty = IsEmpty();
+        IncIndex(m_reserveIndex, count);
+        m_reserveCount -= count;
+        bool pending = CompactNoCrit();
+        if (status) {
+            *status = (wasEmpty && !IsEmpty());
+        }
+        return pending;
+    }
+
+    // Releases the outstanding reservation without publishing anything.
+    void Cancel() { Commit(0); }
+    bool CancelNoCrit() { return CommitNoCrit(0); }
+
+    // Completes a commit for which CommitNoCrit() has returned true. status has the same meaning as in
+    // Write(). It is set if any step has made the pipe non-empty, e.g. after the reader has emptied it
+    // between steps.
+    void Compact(bool *status = NULL) {
+        bool pending = true;
+        if (status) {
+            *status = false;
+        }
+        while (pending) {
+            QF_CRIT_STAT_TYPE crit;
+            QF_CRIT_ENTRY(crit);
+            bool wasEmpty = IsEmpty();
+            pending = CompactNoCrit();
+            if (status && wasEmpty && !IsEmpty()) {
+                *status = true;
+            }
+            QF_CRIT_EXIT(crit);
+        }
+    }
+
     // Return actual read count. Okay if data in pipe < count.
     uint32_t Read(Type *dest, uint32_t count, bool *status = NULL) {
         QF_CRIT_STAT_TYPE crit;
@@ -289,8 +422,31 @@ protected:
     void DecIndex(uint32_t &index, uint32_t count) {
         index = (index - count) & m_mask;
     }
+    // Moves at most COMPACT_CHUNK entries written after the unused reserved space (if any) to the start of it.
+    // Each step slides the unused space forward, making the moved entries visible to the reader.
+    // Return true if there are more entries to move. Otherwise the reservation is released.
+    // Without critical section.
+    bool CompactNoCrit() {
+        FW_PIPE_ASSERT(m_reserved);
+        if (m_reserveCount) {
+            uint32_t src = (m_reserveIndex + m_reserveCount) & m_mask;
+            uint32_t count = LESS(GetDiff(m_writeIndex, src), static_cast<uint32_t>(COMPACT_CHUNK));
+            for (uint32_t i = count; i > 0; i--) {
+                m_stor[m_reserveIndex] = m_stor[src];
+                IncIndex(m_reserveIndex, 1);
+                IncIndex(src, 1);
+            }
+            if (src != m_writeIndex) {
+                return true;
+            }
+            m_writeIndex = m_reserveIndex;
+        }
+        m_reserved = false;
+        return false;
+    }
+    // From the reader's point of view. See GetUsedCountNoCrit().
     bool IsEmpty() {
-        return (m_readIndex == m_writeIndex);
+        return (GetUsedCountNoCrit() == 0);
     }
 
     Type *      m_stor;
@@ -298,6 +454,9 @@ protected:
     uint32_t    m_writeIndex;
     uint32_t    m_readIndex;
     bool        m_truncated;
+    bool        m_reserved;     // True if a reservation is outstanding. See Reserve().
+    uint32_t    m_reserveIndex; // Start of the outstanding reservation, or of the unused space being removed.
+    uint32_t    m_reserveCount; // Count of the above. m_writeIndex is after it.
     // For future enhancement.
     //QP::QSignal m_halfEmptySig; // signal to send when pipe has just crossed half-empty threshold upon read.
 
@@ -0,0 +1,128 @@
+/*******************************************************************************
+ * Copyright (C) Gallium Studio LLC. All rights reserved.
+ *
+ * This program is open source software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Alternatively, this program may be distributed and modified under the
+ * terms of Gallium Studio LLC commercial licenses, which expressly supersede
+ * the GNU General Public License and are specifically designed for licensees
+ * interested in retaining the proprietary status of their code.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * Contact information:
+ * Website - https://www.galliumstudio.com
+ * Source repository - https://github.com/galliumstudio
+ * Email - admin@galliumstudio.com
+ ******************************************************************************/
+#ifndef FW_PROF_H
+#define FW_PROF_H
+
+#include <stdint.h>
+#include "qpcpp.h"
+#include "fw_def.h"
+
+// Set FW_PROF to 0 (e.g. in compiler options) to remove dispatch profiling.
+#ifndef FW_PROF
+#define FW_PROF 1
+#endif
+
+namespace FW {
+
+// Profiler of run-to-completion time of event dispatching, keyed by (HSMN, signal).
+// Time is measured in CPU cycles with DWT CYCCNT on target, or in nanoseconds of a
+// monotonic clock on host. It is wall time and includes preemption by higher priority
+// threads and interrupts, and any region dispatched synchronously within it.
+// Usage:
+//     uint32_t startTime = Prof::GetTime();
+//     ... dispatch e to HSM hsmn ...
+//     Prof::Record(hsmn, e->sig, startTime);
+//
+// It also keeps the queueing latency (from post to dispatch) of each active object or thread,
+// indexed by QP priority. Post time is kept by Fw for dynamic events and by Timer for timer events.
+// Optionally a warning is printed when an event queue goes above a percentage of its capacity.
+class Prof {
+public:
+    enum {
+        HIST_COUNT = 16,        // Number of log2 histogram buckets.
+        HIST_MIN_ORDER = 6,     // Bucket 0 is for time < 2^(HIST_MIN_ORDER + 1).
+                                // Last bucket is for time >= 2^(HIST_MIN_ORDER + HIST_COUNT - 1).
+        ENTRY_ORDER = 7,        // Entry table is hashed with linear probing.
+        ENTRY_COUNT = 1 << ENTRY_ORDER,
+        MAX_PROBE = 8,          // Maximum number of probes per lookup, bounding the cost when the table is full.
+    };
+
+    class Entry {
+    public:
+        QP::QSignal m_sig;
+        Hsmn m_hsmn;            // HSM_UNDEF if entry is unused.
+        uint32_t m_count;
+        uint32_t m_min;
+        uint32_t m_max;
+        uint64_t m_total;
+        uint16_t m_hist[HIST_COUNT];    // Saturates at 0xFFFF.
+    };
+
+    class Queue {
+    public:
+        Hsmn m_hsmn;            // HSM of active object. HSM_UNDEF for XThread.
+        bool m_warned;          // True if warning has been printed since going above threshold.
+        uint16_t m_capacity;    // Event queue capacity including the front event. 0 if unused.
+        uint32_t m_count;
+        uint32_t m_max;
+        uint64_t m_total;
+        uint16_t m_hist[HIST_COUNT];    // Saturates at 0xFFFF.
+    };
+
+    static void Init();
+#if FW_PROF
+    static uint32_t GetTime();
+    static void Record(Hsmn hsmn, QP::QSignal sig, uint32_t startTime);
+    static void RecordLatency(uint8_t prio, QP::QEvt const *e, uint32_t nFree);
+#else
+    static uint32_t GetTime() { return 0; }
+    static void Record(Hsmn hsmn, QP::QSignal sig, uint32_t startTime) { (void)hsmn; (void)sig; (void)startTime; }
+    static void RecordLatency(uint8_t prio, QP::QEvt const *e, uint32_t nFree) { (void)prio; (void)e; (void)nFree; }
+#endif
+    static void AddQueue(uint8_t prio, Hsmn hsmn, uint32_t capacity);
+    static void Reset();
+    static void ResetQueue();
+    static bool GetEntry(uint32_t index, Entry &entry);
+    static bool GetQueue(uint8_t prio, Queue &queue);
+    static uint32_t GetOverflowCnt() { return m_overflowCnt; }
+    static void SetWarnPercent(uint32_t percent) { m_warnPercent = percent; }
+    static uint32_t GetWarnPercent() { return m_warnPercent; }
+    static char const *GetUnit();
+
+protected:
+    static uint32_t GetBucket(uint32_t time);
+
+    static Entry m_entry[ENTRY_COUNT];
+    static Queue m_queue[QF_MAX_ACTIVE + 1];
+    static uint32_t m_overflowCnt;      // Number of dispatches not recorded since no slot is found.
+    static uint32_t m_warnPercent;      // Event queue warning threshold in percentage. 0 to disable.
+};
+
+} // namespace FW
+
+#endif // FW_PROF_H
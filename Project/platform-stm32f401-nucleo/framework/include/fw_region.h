@@ -43,10 +43,12 @@
 #include "qpcpp.h"
 #include "fw_hsm.h"
 #include "fw_evt.h"
+#include "fw_log.h"
 
 namespace FW {
 
 class Active;
+class MActive;
 class XThread;
 
 class Region : public QP::QHsm {
@@ -57,11 +59,17 @@ public:
         m_container(NULL) {}
 
     void Init(Active *container);
+    void Init(MActive *container);
     void Init(XThread *container);
     Hsm &GetHsm() { return m_hsm; }
     Hsmn GetHsmn() const { return m_hsm.GetHsmn(); }
     Sequence GenSeq() { return m_hsm.GenSeq(); }
 
+    // Compile-time log verbosity ceiling. A derived class may redefine it. See LOG_CEILING() in fw_log.h.
+    enum {
+        LOG_CEILING = Log::MAX_VERBOSITY
+    };
+
     virtual void dispatch(QP::QEvt const * const e);
 
 protected:
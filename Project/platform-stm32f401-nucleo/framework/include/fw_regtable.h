@@ -0,0 +1,94 @@
+/*******************************************************************************
+ * Copyright (C) Gallium Studio LLC. All rights reserved.
+ *
+ * This program is open source software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Alternatively, this program may be distributed and modified under the
+ * terms of Gallium Studio LLC commercial licenses, which expressly supersede
+ * the GNU General Public License and are specifically designed for licensees
+ * interested in retaining the proprietary status of their code.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Contact information:
+ * Website - https://www.galliumstudio.com
+ * Source repository - https://github.com/galliumstudio
+ * Email - admin@galliumstudio.com
+ ******************************************************************************/
+
+#ifndef FW_REGTABLE_H
+#define FW_REGTABLE_H
+
+#include <stdint.h>
+#include <string.h>
+#include "qpcpp.h"
+#include "fw_def.h"
+#include "fw_assert.h"
+
+#define FW_REGTABLE_ASSERT(t_) ((t_) ? (void)0 : Q_onAssert("fw_regtable.h", (int_t)__LINE__))
+
+namespace FW {
+
+// Direct-indexed table of the regions (Region or MRegion) contained in an active object or thread.
+// m_index[] maps an HSMN to (slot + 1) in m_reg[], with 0 meaning "not a contained region".
+// Lookup cost is constant and independent of the number of regions (N).
+// Critical sections MUST be enforced externally by caller.
+template <uint32_t N>
+class HsmnRegTable {
+public:
+    HsmnRegTable() : m_count(0) {
+        Q_ASSERT_COMPILE(N < 0xFF);
+        memset(m_index, 0, sizeof(m_index));
+        memset(m_reg, 0, sizeof(m_reg));
+    }
+
+    // Each region can only be added once. By design there is no "Remove" function.
+    void Add(Hsmn hsmn, QP::QHsm *reg) {
+        FW_REGTABLE_ASSERT(reg && (hsmn != HSM_UNDEF) && (hsmn < MAX_HSM_COUNT));
+        FW_REGTABLE_ASSERT((m_index[hsmn] == 0) && (m_count < N));
+        m_reg[m_count++] = reg;
+        m_index[hsmn] = m_count;
+    }
+    // Returns NULL if hsmn does not refer to a contained region (including HSM_UNDEF).
+    QP::QHsm *Get(Hsmn hsmn) const {
+        if (hsmn >= MAX_HSM_COUNT) {
+            return NULL;
+        }
+        uint8_t slot = m_index[hsmn];
+        return slot ? m_reg[slot - 1] : NULL;
+    }
+    uint32_t GetCount() const { return m_count; }
+
+protected:
+    uint8_t m_index[MAX_HSM_COUNT];
+    QP::QHsm *m_reg[N];
+    uint8_t m_count;
+
+    // Unimplemented to disallow built-in memberwise copy constructor and assignment operator.
+    HsmnRegTable(HsmnRegTable const &);
+    HsmnRegTable& operator= (HsmnRegTable const &);
+};
+
+} // namespace FW
+
+#endif // FW_REGTABLE_H
@@ -0,0 +1,224 @@
+/*******************************************************************************
+ * Copyright (C) Gallium Studio LLC. All rights reserved.
+ *
+ * This program is open source software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Alternatively, this program may be distributed and modified under the
+ * terms of Gallium Studio LLC commercial licenses, which expressly supersede
+ * the GNU General Public License and are specifically designed for licensees
+ * interested in retaining the proprietary status of their code.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Contact information:
+ * Website - https://www.galliumstudio.com
+ * Source repository - https://github.com/galliumstudio
+ * Email - admin@galliumstudio.com
+ ******************************************************************************/
+
+#ifndef FW_SPSCPIPE_H
+#define FW_SPSCPIPE_H
+
+#include "fw_def.h"
+#include "fw_assert.h"
+
+#define FW_SPSCPIPE_ASSERT(t_) ((t_) ? (void)0 : Q_onAssert("fw_spscpipe.h", (int_t)__LINE__))
+
+namespace FW {
+
+// Lock-free single-producer/single-consumer variant of Pipe. It provides the same read/write API as Pipe
+// but never enters a critical section. It is only valid when:
+// 1. There is exactly one writer (e.g. an ISR, DMA-owning region or active object), which is the only one
+//    to call Write(), IncWriteIndex() and GetWriteRef().
+// 2. There is exactly one reader, which is the only one to call Read(), IncReadIndex() and GetReadRef().
+// Each index is only stored by its owner and is published with release semantics. The other side loads it
+// with acquire semantics, so data in the storage are always visible before the index that covers them.
+// Since the indices are never written by both sides, Delete() is not supported (use Pipe instead).
+// Reset() must only be called when neither side is accessing the pipe.
+template <class Type>
+class SpscPipe {
+public:
+    SpscPipe(Type stor[], uint8_t order) :
+        m_stor(stor), m_mask(BIT_MASK_OF_SIZE(order)),
+        m_writeIndex(0), m_readIndex(0), m_truncated(false) {
+        // Arithmetic in this class (m_mask + 1) assumes order < 32.
+        // BIT_MASK_OF_SIZE() assumes order > 0
+        FW_SPSCPIPE_ASSERT(stor && (order > 0) and (order < 32));
+    }
+    virtual ~SpscPipe() {}
+
+    void Reset() {
+        StoreIndex(m_writeIndex, 0);
+        StoreIndex(m_readIndex, 0);
+        m_truncated = false;
+    }
+    bool IsTruncated() const { return m_truncated; }
+    uint32_t GetWriteIndex() const { return LoadIndex(m_writeIndex); }
+    uint32_t GetReadIndex() const { return LoadIndex(m_readIndex); }
+    // When called by either side, the count returned is a conservative snapshot. The actual used count
+    // can only increase from the reader's point of view and only decrease from the writer's point of view.
+    uint32_t GetUsedCount() const {
+        return (LoadIndex(m_writeIndex) - LoadIndex(m_readIndex)) & m_mask;
+    }
+    uint32_t GetUsedCountNoCrit() const { return GetUsedCount(); }
+    // Since (m_readIndex == m_writeIndex) is regarded as empty, the maximum available count =
+    // total storage - 1, i.e. m_mask.
+    uint32_t GetAvailCount() const {
+        return (LoadIndex(m_readIndex) - LoadIndex(m_writeIndex) - 1) & m_mask;
+    }
+    uint32_t GetAvailCountNoCrit() const { return GetAvailCount(); }
+    uint32_t GetDiff(uint32_t a, uint32_t b) { return (a - b) & m_mask; }
+    uint32_t GetAddr(uint32_t index) { return reinterpret_cast<uint32_t>(&m_stor[index & m_mask]); }
+    Type&    GetRef(uint32_t index) { return m_stor[index & m_mask]; }
+    uint32_t GetWriteAddr() { return GetAddr(GetWriteIndex()); }
+    Type&    GetWriteRef() { return GetRef(GetWriteIndex()); }
+    uint32_t GetReadAddr() { return GetAddr(GetReadIndex()); }
+    Type&    GetReadRef() { return GetRef(GetReadIndex()); }
+    // Returns one byte past the max buffer address. Important - It is not valid to write to /read from this address.
+    uint32_t GetEndAddr() { return reinterpret_cast<uint32_t>(&m_stor[m_mask + 1]); }
+    uint32_t GetBufSize() { return (m_mask + 1); }
+    // To be called by the writer only, after it has filled count entries starting at the write index
+    // (e.g. by DMA).
+    void IncWriteIndex(uint32_t count) {
+        StoreIndex(m_writeIndex, (m_writeIndex + count) & m_mask);
+    }
+    // To be called by the reader only, after it has consumed count entries starting at the read index.
+    void IncReadIndex(uint32_t count) {
+        StoreIndex(m_readIndex, (m_readIndex + count) & m_mask);
+    }
+    void IncWriteIndexNoCrit(uint32_t count) { IncWriteIndex(count); }
+    void IncReadIndexNoCrit(uint32_t count) { IncReadIndex(count); }
+
+    // Writer only.
+    // Return written count. If not enough space to write all, return 0 (i.e. no partial write).
+    // If overflow has occurred set m_truncated; otherwise clear m_truncated.
+    // If status is not NULL, it is set to true if the reader may have found the pipe empty before
+    // this write was published, i.e. the reader needs to be notified.
+    uint32_t Write(Type const *src, uint32_t count, bool *status = NULL) {
+        FW_SPSCPIPE_ASSERT(src);
+        // m_writeIndex is owned by the writer, so it is safe to access it directly.
+        uint32_t writeIndex = m_writeIndex;
+        uint32_t avail = (LoadIndex(m_readIndex) - writeIndex - 1) & m_mask;
+        if (count > avail) {
+            m_truncated = true;
+            count = 0;
+        } else {
+            m_truncated = false;
+            if ((writeIndex + count) <= (m_mask + 1)) {
+                CopyBlock(&m_stor[writeIndex], src, count);
+            } else {
+                uint32_t partial = m_mask + 1 - writeIndex;
+                CopyBlock(&m_stor[writeIndex], src, partial);
+                CopyBlock(&m_stor[0], src + partial, count - partial);
+            }
+            StoreIndex(m_writeIndex, (writeIndex + count) & m_mask);
+        }
+        if (status) {
+            // The full barrier orders the store to m_writeIndex above before the load of m_readIndex below.
+            // It pairs with the one in Read() so that either the reader sees the new data on its next
+            // read, or the writer sees that the reader has caught up with the old write index.
+            __atomic_thread_fence(__ATOMIC_SEQ_CST);
+            *status = (count && (LoadIndex(m_readIndex) == writeIndex));
+        }
+        return count;
+    }
+    uint32_t WriteNoCrit(Type const *src, uint32_t count, bool *status = NULL) {
+        return Write(src, count, status);
+    }
+
+    // Reader only.
+    // Return actual read count. Okay if data in pipe < count.
+    uint32_t Read(Type *dest, uint32_t count, bool *status = NULL) {
+        FW_SPSCPIPE_ASSERT(dest);
+        // m_readIndex is owned by the reader, so it is safe to access it directly.
+        uint32_t readIndex = m_readIndex;
+        uint32_t writeIndex = LoadIndex(m_writeIndex);
+        uint32_t used = (writeIndex - readIndex) & m_mask;
+        count = LESS(count, used);
+        if ((readIndex + count) <= (m_mask + 1)) {
+            CopyBlock(dest, &m_stor[readIndex], count);
+        } else {
+            uint32_t partial = m_mask + 1 - readIndex;
+            CopyBlock(dest, &m_stor[readIndex], partial);
+            CopyBlock(dest + partial, &m_stor[0], count - partial);
+        }
+        readIndex = (readIndex + count) & m_mask;
+        StoreIndex(m_readIndex, readIndex);
+        // See Write().
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+        if (status) {
+            // Currently use "empty" as condition, but it can be half-empty, etc.
+            *status = (count && (LoadIndex(m_writeIndex) == readIndex));
+        }
+        return count;
+    }
+    uint32_t ReadNoCrit(Type *dest, uint32_t count, bool *status = NULL) {
+        return Read(dest, count, status);
+    }
+
+    // See Pipe::CacheOp().
+    void CacheOp(void (*op)(uint32_t addr, uint32_t len), uint32_t count) {
+        uint32_t readIndex = LoadIndex(m_readIndex);
+        if ((readIndex + count) <= (m_mask + 1)) {
+            op(GetAddr(readIndex), count * sizeof(Type));
+        } else {
+            uint32_t partial = m_mask + 1 - readIndex;
+            op(GetAddr(readIndex), partial * sizeof(Type));
+            op(GetAddr(0), (count - partial) * sizeof(Type));
+        }
+    }
+    void CacheOpNoCrit(void (*op)(uint32_t addr, uint32_t len), uint32_t count) {
+        CacheOp(op, count);
+    }
+
+protected:
+    // Copy contiguous block. count can be 0.
+    static void CopyBlock(Type *dest, Type const *src, uint32_t count) {
+        for (uint32_t i = 0; i < count; i++) {
+            dest[i] = src[i];
+        }
+    }
+    static uint32_t LoadIndex(uint32_t const &index) {
+        return __atomic_load_n(&index, __ATOMIC_ACQUIRE);
+    }
+    static void StoreIndex(uint32_t &index, uint32_t value) {
+        __atomic_store_n(&index, value, __ATOMIC_RELEASE);
+    }
+
+    Type *      m_stor;
+    uint32_t    m_mask;
+    uint32_t    m_writeIndex;
+    uint32_t    m_readIndex;
+    bool        m_truncated;
+
+    // Unimplemented to disallow built-in memberwise copy constructor and assignment operator.
+    SpscPipe(SpscPipe const &);
+    SpscPipe& operator= (SpscPipe const &);
+};
+
+// Common template instantiation
+typedef SpscPipe<uint8_t> SpscFifo;
+
+} // namespace FW
+
+#endif // FW_SPSCPIPE_H
@@ -43,6 +43,14 @@
 #include "qpcpp.h"
 #include "fw.h"
 
+// Set FW_TIMER_WHEEL to 1 (e.g. in compiler options) to run Timer on a hierarchical timing wheel
+// driven by Timer::Tick(), rather than on the list of armed QTimeEvt scanned by QF::tickX_().
+// The cost per tick of the wheel depends on the number of expiring timers rather than armed timers.
+// It is required by tickless idle (ENABLE_TICKLESS_IDLE in bsp.cpp).
+#ifndef FW_TIMER_WHEEL
+#define FW_TIMER_WHEEL 0
+#endif
+
 namespace FW {
 
 class Timer : public QP::QTimeEvt {
@@ -57,21 +65,64 @@ public:
     ~Timer() {}
 
     Hsmn GetHsmn() const { return m_hsmn; }
+    uint32_t GetPostTime() const { return m_postTime; }
     void Start(uint32_t timeoutMs, Type type = ONCE);
     void Stop();
     void Restart(uint32_t timeoutMs, Type type = ONCE);
 
+    // Must be called from the tick ISR after QF::tickX_(). No-op unless FW_TIMER_WHEEL is set.
+    static void Tick();
+    // For tickless idle. Returns the number of ticks up to and including the one at which the
+    // next timer expires, limited to maxTicks. Returns 0 unless FW_TIMER_WHEEL is set.
+    static uint32_t GetIdleTicks(uint32_t maxTicks);
+    // For tickless idle. Accounts for ticks skipped while sleeping.
+    static void Skip(uint32_t ticks);
+    // Must be called when a timer event is taken from an event queue.
+    static bool IsValid(QP::QEvt const *e);
+
 protected:
-    bool IsMatch(QEvt const *other) {
-        // For a match, both the signal and the associated hsmn must match
-        // since the same signal can be used by multiple region instances.
-        // Note if sig matches, it is guaranteed that 'other' is a timer event,
-        // so casting is safe.
-        return (other->sig == sig) &&
-               (static_cast<Timer const *>(other)->GetHsmn() == m_hsmn);
-    }
+    void OnPost();
 
     Hsmn m_hsmn;
+    // Stale timeout events are dropped at dispatch rather than removed from the event queue.
+    // Both counters are only accessed within critical sections.
+    uint8_t m_queued;       // Number of timeout events of this timer in the event queue.
+    uint8_t m_stale;        // Number of the oldest queued timeout events posted before the last Stop().
+    uint32_t m_postTime;    // Time of the last timeout event posted. See Prof.
+
+    friend class QP::QF;
+
+#if FW_TIMER_WHEEL
+    enum {
+        WHEEL_LEVEL_COUNT = 5,
+        WHEEL_SLOT_ORDER = 6,
+        WHEEL_SLOT_COUNT = 1 << WHEEL_SLOT_ORDER,
+        WHEEL_SLOT_MASK = WHEEL_SLOT_COUNT - 1,
+        // Timeout in ticks must be less than this. At 1ms per tick it is over 12 days.
+        WHEEL_MAX_TICK = 1UL << (WHEEL_LEVEL_COUNT * WHEEL_SLOT_ORDER)
+    };
+
+    bool IsWheelArmed() const { return m_wheelPrevNext != NULL; }
+    void WheelLink(Timer **head);
+    void WheelUnlink();
+    void WheelAdd();
+    static void WheelCascade(uint32_t level);
+    static void WheelSetBusy(uint32_t level, uint32_t index) { m_wheelBusy[level] |= (1ULL << index); }
+    static void WheelClearBusy(uint32_t level, uint32_t index) { m_wheelBusy[level] &= ~(1ULL << index); }
+
+    Timer *m_wheelNext;             // Next timer in the same slot.
+    Timer **m_wheelPrevNext;        // Link pointing to this timer. NULL if not armed.
+    QP::QActive *m_wheelAct;        // Container to post timeout event to.
+    uint32_t m_wheelExpire;         // Absolute tick at which the timer expires.
+    uint32_t m_wheelInterval;       // Reload in ticks for a periodic timer, 0 for one-shot.
+
+    // Level n holds timers expiring within WHEEL_SLOT_COUNT^(n+1) ticks, indexed by bits
+    // [n*WHEEL_SLOT_ORDER, (n+1)*WHEEL_SLOT_ORDER) of their expiry tick.
+    static Timer *m_wheel[WHEEL_LEVEL_COUNT][WHEEL_SLOT_COUNT];
+    static uint64_t m_wheelBusy[WHEEL_LEVEL_COUNT];    // Bit n is set if slot n of a level is not empty.
+    static Timer *m_wheelExpiring;  // Timers expiring in the current tick, not posted yet.
+    static uint32_t m_wheelTick;    // Next tick to be processed.
+#endif
 };
 
 } // namespace FW
@@ -42,6 +42,7 @@
 #include <stdint.h>
 #include "qpcpp.h"
 #include "fw_maptype.h"
+#include "fw_regtable.h"
 #include "fw_evt.h"
 #include "bsp.h"
 
@@ -52,24 +53,25 @@ namespace FW {
 class XThread : public QP::QXThread {
 public:
     XThread() :
-        QP::QXThread(XThreadHandler),
-        m_hsmnRegMap(m_hsmnRegStor, ARRAY_COUNT(m_hsmnRegStor), HsmnReg(HSM_UNDEF, NULL)) {
+        QP::QXThread(XThreadHandler) {
     }
     void Start(uint8_t prio);
     void Add(Region *reg);
+    void Add(MRegion *reg);
     void DelayMs(uint32_t ms) { delay(BSP_MSEC_TO_TICK(ms)); }
 
 protected:
     virtual void OnRun() = 0;
+    void AddRegion(Hsm &hsm, QP::QHsm *reg);
     void PostSync(Evt const *e);
+    void PublishSync(Evt const *e);
 
     enum {
         MAX_REGION_COUNT = 8,
         EVT_QUEUE_COUNT = 16,
         STACK_SIZE_BYTE = 4096
     };
-    HsmnReg m_hsmnRegStor[MAX_REGION_COUNT];
-    HsmnRegMap m_hsmnRegMap;
+    HsmnRegTable<MAX_REGION_COUNT> m_hsmnRegTable;
     QP::QEvt const *m_evtQueueStor[EVT_QUEUE_COUNT];
     uint64_t m_stackSto[ROUND_UP_DIV_8(STACK_SIZE_BYTE)];
 
@@ -84,6 +86,7 @@ private:
         }
     }
     void Dispatch(QP::QEvt const * const e);
+    void DispatchTo(Hsmn hsmn, QP::QEvt const * const e);
 };
 
 } // namespace FW
@@ -39,6 +39,7 @@
 #include "qpcpp.h"
 #include "fw_active.h"
 #include "fw.h"
+#include "fw_prof.h"
 #include "fw_assert.h"
 
 FW_DEFINE_THIS_FILE("fw.cpp")
@@ -52,6 +53,18 @@ HsmActMap Fw::m_hsmActMap(m_hsmActStor, ARRAY_COUNT(m_hsmActStor), HsmAct(NULL,
 uint32_t Fw::m_evtPoolSmall[ROUND_UP_DIV_4(EVT_SIZE_SMALL * EVT_COUNT_SMALL)];
 uint32_t Fw::m_evtPoolMedium[ROUND_UP_DIV_4(EVT_SIZE_MEDIUM * EVT_COUNT_MEDIUM)];
 uint32_t Fw::m_evtPoolLarge[ROUND_UP_DIV_4(EVT_SIZE_LARGE * EVT_COUNT_LARGE)];
+uint32_t const Fw::m_evtPoolSize[EVT_POOL_COUNT] = { EVT_SIZE_SMALL, EVT_SIZE_MEDIUM, EVT_SIZE_LARGE };
+uint32_t const Fw::m_evtPoolCount[EVT_POOL_COUNT] = { EVT_COUNT_SMALL, EVT_COUNT_MEDIUM, EVT_COUNT_LARGE };
+Fw::PoolStat Fw::m_poolStat[EVT_POOL_COUNT];
+#if FW_EVT_COUNT
+Fw::SigCount Fw::m_sigCount[SIG_COUNT_SIZE];
+Fw::EvtCount Fw::m_senderCount[MAX_HSM_COUNT];
+uint32_t Fw::m_sigOverflowCnt;
+#endif
+uint32_t Fw::m_postTime[EVT_BLOCK_COUNT];
+Fw::Subscr Fw::m_subscr[SUBSCR_SIZE];
+
+Q_ASSERT_COMPILE(MAX_HSM_COUNT <= (8 * sizeof(Fw::HsmnSet)));
 
 void Fw::Init() {
     // Initialize QP. It must be done before BspInit() since the latter may enable
@@ -61,6 +74,7 @@ void Fw::Init() {
     QF::poolInit(m_evtPoolMedium, sizeof(m_evtPoolMedium), EVT_SIZE_MEDIUM);
     QF::poolInit(m_evtPoolLarge, sizeof(m_evtPoolLarge), EVT_SIZE_LARGE);
     // Any necessary framework initialization will be placed here.
+    Prof::Init();
     // ...
     // Initialize BSP include HAL.
     BspInit();
@@ -84,6 +98,7 @@ void Fw::Post(Evt const *e) {
     FW_ASSERT(e);
     QActive *act = m_hsmActMap.GetByIndex(e->GetTo())->GetValue();
     if (act) {
+        SetPostTime(e);
         act->post_(e, 0);
     } else {
         QF::gc(e);
@@ -100,4 +115,349 @@ QActive *Fw::GetContainer(Hsmn hsmn) {
     return m_hsmActMap.GetByIndex(hsmn)->GetValue();
 }
 
+// Typically called on entry to the root state of the subscriber.
+void Fw::Subscribe(QSignal sig, Hsmn hsmn) {
+    FW_ASSERT(IS_EVT_HSMN_VALID(sig) && (hsmn != HSM_UNDEF) && (hsmn < MAX_HSM_COUNT));
+    QF_CRIT_STAT_TYPE crit;
+    QF_CRIT_ENTRY(crit);
+    Subscr *subscr = FindSubscr(sig, true);
+    if (subscr) {
+        subscr->m_hsmnSet |= static_cast<HsmnSet>(1) << hsmn;
+    }
+    QF_CRIT_EXIT(crit);
+    // Subscriber table full. Increase SUBSCR_ORDER.
+    FW_ASSERT(subscr);
+}
+
+// The entry is kept when its last subscriber is removed so that probing sequences stay intact.
+void Fw::Unsubscribe(QSignal sig, Hsmn hsmn) {
+    FW_ASSERT((hsmn != HSM_UNDEF) && (hsmn < MAX_HSM_COUNT));
+    QF_CRIT_STAT_TYPE crit;
+    QF_CRIT_ENTRY(crit);
+    Subscr *subscr = FindSubscr(sig, false);
+    if (subscr) {
+        subscr->m_hsmnSet &= ~(static_cast<HsmnSet>(1) << hsmn);
+    }
+    QF_CRIT_EXIT(crit);
+}
+
+// e must be sent to HSM_UNDEF. Like QF::publish_(), e is posted to the container of each subscriber with its
+// reference count incremented per post. A container with several subscribers gets e once and dispatches it
+// to each of them (see ActiveBase::dispatch() and XThread::Dispatch()).
+// The scheduler is locked while posting so that a higher priority container cannot process and recycle e
+// before it has been posted to all containers. This is not needed in ISR which cannot be preempted by them.
+void Fw::Publish(Evt const *e) {
+    FW_ASSERT(e && (e->GetTo() == HSM_UNDEF));
+    HsmnSet subscr = GetSubscriber(e->sig);
+    QPSet prioSet;
+    prioSet.setEmpty();
+    for (uint32_t hsmn = 0; subscr; hsmn++) {
+        HsmnSet bit = static_cast<HsmnSet>(1) << hsmn;
+        if (subscr & bit) {
+            subscr &= ~bit;
+            QActive *act = GetContainer(hsmn);
+            if (act) {
+                prioSet.insert(act->getPrio());
+            }
+        }
+    }
+    if (prioSet.isEmpty()) {
+        QF::gc(e);
+        return;
+    }
+    SetPostTime(e);
+    bool isr = QXK_ISR_CONTEXT_();
+    QSchedStatus lockStat = 0;
+    if (!isr) {
+        lockStat = QXK::schedLock(QF_MAX_ACTIVE);
+    }
+    do {
+        uint_fast8_t prio = prioSet.findMax();
+        prioSet.remove(prio);
+        QF::active_[prio]->post_(e, 0);
+    } while (prioSet.notEmpty());
+    if (!isr) {
+        QXK::schedUnlock(lockStat);
+    }
+}
+
+// If container is not NULL, only subscribers within that container are returned.
+Fw::HsmnSet Fw::GetSubscriber(QSignal sig, QActive const *container) {
+    QF_CRIT_STAT_TYPE crit;
+    QF_CRIT_ENTRY(crit);
+    Subscr *subscr = FindSubscr(sig, false);
+    HsmnSet hsmnSet = subscr ? subscr->m_hsmnSet : 0;
+    QF_CRIT_EXIT(crit);
+    if (container) {
+        HsmnSet remaining = hsmnSet;
+        for (uint32_t hsmn = 0; remaining; hsmn++) {
+            HsmnSet bit = static_cast<HsmnSet>(1) << hsmn;
+            if (remaining & bit) {
+                remaining &= ~bit;
+                if (GetContainer(hsmn) != container) {
+                    hsmnSet &= ~bit;
+                }
+            }
+        }
+    }
+    return hsmnSet;
+}
+
+// Allocates an event in the same way as QF::newX_(), i.e. from the smallest pool that fits, and counts
+// the allocation or failure in that pool. Pools are initialized in ascending order of block size, so
+// the pool index found here is the one QF::newX_() uses. Margin is 0 so that newX_() returns NULL
+// rather than asserting on exhaustion and the failure can be counted first.
+void *Fw::AllocEvt(uint32_t evtSize) {
+    uint32_t i = 0;
+    while ((i < EVT_POOL_COUNT) && (evtSize > m_evtPoolSize[i])) {
+        i++;
+    }
+    FW_ASSERT(i < EVT_POOL_COUNT);
+    QEvt *e = QF::newX_(evtSize, 0, 0);
+    QF_CRIT_STAT_TYPE crit;
+    QF_CRIT_ENTRY(crit);
+    PoolStat &stat = m_poolStat[i];
+    if (e) {
+        stat.m_allocCnt++;
+        stat.m_reqBytes += evtSize;
+        stat.m_maxReqSize = GREATER(stat.m_maxReqSize, static_cast<uint16_t>(evtSize));
+        if (++stat.m_inUse > stat.m_peak) {
+            stat.m_peak = stat.m_inUse;
+        }
+    } else {
+        stat.m_failCnt++;
+    }
+    QF_CRIT_EXIT(crit);
+    // The pool that fits is exhausted.
+    FW_ASSERT(e);
+    // For events posted other than by Post(), latency is measured from allocation.
+    SetPostTime(e);
+    return e;
+}
+
+#if FW_EVT_COUNT
+// Called by Evt constructor. Only built with FW_EVT_COUNT since it runs for every event.
+void Fw::OnEvtCreate(Evt const *e) {
+    if (GetBlockIndex(e) == EVT_BLOCK_COUNT) {
+        return;
+    }
+    QF_CRIT_STAT_TYPE crit;
+    QF_CRIT_ENTRY(crit);
+    EvtCount *sigCount = FindSigCount(e->sig, true);
+    if (sigCount) {
+        IncCount(*sigCount);
+    } else {
+        m_sigOverflowCnt++;
+    }
+    Hsmn from = e->GetFrom();
+    if (from < MAX_HSM_COUNT) {
+        IncCount(m_senderCount[from]);
+    }
+    QF_CRIT_EXIT(crit);
+}
+#endif
+
+// Called by QF::gc() when the last reference to a dynamic event is released.
+// All dynamic events are allocated through Evt::operator new, so the cast is safe.
+void Fw::OnEvtRecycle(QEvt const *e, uint32_t poolIdx) {
+    FW_ASSERT(poolIdx < EVT_POOL_COUNT);
+    QF_CRIT_STAT_TYPE crit;
+    QF_CRIT_ENTRY(crit);
+    PoolStat &stat = m_poolStat[poolIdx];
+    if (stat.m_inUse) {
+        stat.m_inUse--;
+    }
+#if !FW_EVT_COUNT
+    (void)e;    // Avoid warning.
+#else
+    EvtCount *sigCount = FindSigCount(e->sig, false);
+    if (sigCount) {
+        DecCount(*sigCount);
+    }
+    Hsmn from = static_cast<Evt const *>(e)->GetFrom();
+    if (from < MAX_HSM_COUNT) {
+        DecCount(m_senderCount[from]);
+    }
+#endif
+    QF_CRIT_EXIT(crit);
+}
+
+// Post time is only kept for dynamic events. It is ignored for static events.
+void Fw::SetPostTime(QEvt const *e) {
+    uint32_t index = GetBlockIndex(e);
+    if (index < EVT_BLOCK_COUNT) {
+        m_postTime[index] = Prof::GetTime();
+    }
+}
+
+// Returns false if e is not a dynamic event.
+bool Fw::GetPostTime(QEvt const *e, uint32_t &time) {
+    uint32_t index = GetBlockIndex(e);
+    if (index < EVT_BLOCK_COUNT) {
+        time = m_postTime[index];
+        return true;
+    }
+    return false;
+}
+
+uint32_t Fw::GetPoolEvtSize(uint32_t index) {
+    FW_ASSERT(index < EVT_POOL_COUNT);
+    return m_evtPoolSize[index];
+}
+
+uint32_t Fw::GetPoolEvtCount(uint32_t index) {
+    FW_ASSERT(index < EVT_POOL_COUNT);
+    return m_evtPoolCount[index];
+}
+
+void Fw::GetPoolStat(uint32_t index, PoolStat &stat) {
+    FW_ASSERT(index < EVT_POOL_COUNT);
+    QF_CRIT_STAT_TYPE crit;
+    QF_CRIT_ENTRY(crit);
+    stat = m_poolStat[index];
+    QF_CRIT_EXIT(crit);
+}
+
+#if FW_EVT_COUNT
+// Returns false if the entry at index is unused.
+bool Fw::GetSigCount(uint32_t index, QSignal &sig, EvtCount &count) {
+    FW_ASSERT(index < SIG_COUNT_SIZE);
+    QF_CRIT_STAT_TYPE crit;
+    QF_CRIT_ENTRY(crit);
+    sig = m_sigCount[index].m_sig;
+    count = m_sigCount[index].m_count;
+    QF_CRIT_EXIT(crit);
+    return sig != 0;
+}
+
+void Fw::GetSenderCount(Hsmn hsmn, EvtCount &count) {
+    FW_ASSERT(hsmn < MAX_HSM_COUNT);
+    QF_CRIT_STAT_TYPE crit;
+    QF_CRIT_ENTRY(crit);
+    count = m_senderCount[hsmn];
+    QF_CRIT_EXIT(crit);
+}
+#endif
+
+// Clears counters and restarts peaks from the current number of live events.
+// Signal entries are kept since live events still refer to them.
+void Fw::ResetEvtStat() {
+    QF_CRIT_STAT_TYPE crit;
+    QF_CRIT_ENTRY(crit);
+    for (uint32_t i = 0; i < EVT_POOL_COUNT; i++) {
+        PoolStat &stat = m_poolStat[i];
+        stat.m_allocCnt = 0;
+        stat.m_failCnt = 0;
+        stat.m_reqBytes = 0;
+        stat.m_maxReqSize = 0;
+        stat.m_peak = stat.m_inUse;
+    }
+#if FW_EVT_COUNT
+    for (uint32_t i = 0; i < SIG_COUNT_SIZE; i++) {
+        m_sigCount[i].m_count.m_peak = m_sigCount[i].m_count.m_curr;
+        m_sigCount[i].m_count.m_total = 0;
+    }
+    for (uint32_t i = 0; i < MAX_HSM_COUNT; i++) {
+        m_senderCount[i].m_peak = m_senderCount[i].m_curr;
+        m_senderCount[i].m_total = 0;
+    }
+    m_sigOverflowCnt = 0;
+#endif
+    QF_CRIT_EXIT(crit);
+}
+
+// Since QEvt leaves poolId_ uninitialized for events on the stack, an event is identified as dynamic
+// by its address being within one of the pools. Blocks of all pools are numbered consecutively.
+// Returns EVT_BLOCK_COUNT if e is not a dynamic event.
+uint32_t Fw::GetBlockIndex(void const *e) {
+    uint8_t const *addr = reinterpret_cast<uint8_t const *>(e);
+    uint8_t const *small = reinterpret_cast<uint8_t const *>(m_evtPoolSmall);
+    uint8_t const *medium = reinterpret_cast<uint8_t const *>(m_evtPoolMedium);
+    uint8_t const *large = reinterpret_cast<uint8_t const *>(m_evtPoolLarge);
+    if ((addr >= small) && (addr < (small + sizeof(m_evtPoolSmall)))) {
+        return (addr - small) / EVT_SIZE_SMALL;
+    }
+    if ((addr >= medium) && (addr < (medium + sizeof(m_evtPoolMedium)))) {
+        return EVT_COUNT_SMALL + (addr - medium) / EVT_SIZE_MEDIUM;
+    }
+    if ((addr >= large) && (addr < (large + sizeof(m_evtPoolLarge)))) {
+        return EVT_COUNT_SMALL + EVT_COUNT_MEDIUM + (addr - large) / EVT_SIZE_LARGE;
+    }
+    return EVT_BLOCK_COUNT;
+}
+
+#if FW_EVT_COUNT
+// Must be called within critical section.
+// Returns NULL if not found, or if add is true and the table is full.
+Fw::EvtCount *Fw::FindSigCount(QSignal sig, bool add) {
+    uint32_t index = HashSig(sig, SIG_COUNT_ORDER);
+    for (uint32_t i = 0; i < SIG_COUNT_SIZE; i++) {
+        SigCount &entry = m_sigCount[index];
+        if (entry.m_sig == sig) {
+            return &entry.m_count;
+        }
+        if (entry.m_sig == 0) {
+            if (!add) {
+                return NULL;
+            }
+            entry.m_sig = sig;
+            return &entry.m_count;
+        }
+        index = (index + 1) & (SIG_COUNT_SIZE - 1);
+    }
+    return NULL;
+}
+#endif
+
+// Must be called within critical section.
+// Returns NULL if not found, or if add is true and the table is full.
+Fw::Subscr *Fw::FindSubscr(QSignal sig, bool add) {
+    uint32_t index = HashSig(sig, SUBSCR_ORDER);
+    for (uint32_t i = 0; i < SUBSCR_SIZE; i++) {
+        Subscr &entry = m_subscr[index];
+        if (entry.m_sig == sig) {
+            return &entry;
+        }
+        if (entry.m_sig == 0) {
+            if (!add) {
+                return NULL;
+            }
+            entry.m_sig = sig;
+            return &entry;
+        }
+        index = (index + 1) & (SUBSCR_SIZE - 1);
+    }
+    return NULL;
+}
+
+// Fibonacci hashing of 16-bit signal to a table of 2^order entries.
+uint32_t Fw::HashSig(QSignal sig, uint32_t order) {
+    return ((static_cast<uint32_t>(sig) * 40503) & 0xFFFF) >> (16 - order);
+}
+
+#if FW_EVT_COUNT
+void Fw::IncCount(EvtCount &count) {
+    count.m_total++;
+    if (++count.m_curr > count.m_peak) {
+        count.m_peak = count.m_curr;
+    }
+}
+
+void Fw::DecCount(EvtCount &count) {
+    if (count.m_curr) {
+        count.m_curr--;
+    }
+}
+#endif
+
 } // namespace FW
+
+// Callback from QF::gc(). As a member of QF it has access to poolId_ of QEvt.
+// It is called after QF::gc() has left its critical section, which is safe since the reference count
+// has already dropped to zero there, so no other context can use or recycle e, and e is not put back
+// to its pool until onGc() returns, so it cannot be reallocated meanwhile. OnEvtRecycle() updates the
+// statistics in its own critical section. An allocation preempting in between still sees the block
+// as in use, which it is.
+void QF::onGc(QEvt const *e) {
+    FW::Fw::OnEvtRecycle(e, e->poolId_ - 1);
+}
@@ -39,8 +39,10 @@
 #include "qpcpp.h"
 #include "fw_active.h"
 #include "fw_region.h"
+#include "fw_mregion.h"
 #include "fw_evt.h"
 #include "fw_timer.h"
+#include "fw_prof.h"
 #include "fw.h"
 #include "fw_assert.h"
 
@@ -50,53 +52,106 @@ using namespace QP;
 
 namespace FW {
 
-void Active::Start(uint8_t prio) {
+template <class QBase>
+void ActiveBase<QBase>::Start(uint8_t prio) {
     Fw::Add(m_hsm.GetHsmn(), &m_hsm, this);
     m_hsm.Init(this);
-    QActive::start(prio, m_evtQueueStor, ARRAY_COUNT(m_evtQueueStor), NULL, 0);
+    // Event queue capacity includes the front event.
+    Prof::AddQueue(prio, m_hsm.GetHsmn(), ARRAY_COUNT(m_evtQueueStor) + 1);
+    QBase::start(prio, m_evtQueueStor, ARRAY_COUNT(m_evtQueueStor), NULL, 0);
 }
 
-void Active::Add(Region *reg) {
+template <class QBase>
+void ActiveBase<QBase>::Add(Region *reg) {
     FW_ASSERT(reg);
-    Hsmn regHsmn = reg->GetHsm().GetHsmn();
+    AddRegion(reg->GetHsm(), reg);
+}
+
+template <class QBase>
+void ActiveBase<QBase>::Add(MRegion *reg) {
+    FW_ASSERT(reg);
+    AddRegion(reg->GetHsm(), reg);
+}
+
+template <class QBase>
+void ActiveBase<QBase>::AddRegion(Hsm &hsm, QHsm *reg) {
+    Hsmn regHsmn = hsm.GetHsmn();
     FW_ASSERT(regHsmn != HSM_UNDEF);
-    HsmnReg *existing = m_hsmnRegMap.GetByKey(regHsmn);
-    FW_ASSERT(existing == NULL);
-    m_hsmnRegMap.Save(HsmnReg(regHsmn, reg));
-    Fw::Add(regHsmn, &reg->GetHsm(), this);
+    FW_ASSERT(m_hsmnRegTable.Get(regHsmn) == NULL);
+    m_hsmnRegTable.Add(regHsmn, reg);
+    Fw::Add(regHsmn, &hsm, this);
 }
 
-void Active::dispatch(QEvt const * const e) {
+template <class QBase>
+void ActiveBase<QBase>::dispatch(QEvt const * const e) {
     Hsmn hsmn;
     // Discard event if it is associated with an undefined HSM.
-    // This happens when a timer event already posted is canceled.
+    // This happens to internal time events of QP.
     if (!IS_EVT_HSMN_VALID(e->sig)) {
         return;
     }
     if (IS_TIMER_EVT(e->sig)) {
+        // Discard timeout event posted before its timer was stopped.
+        if (!Timer::IsValid(e)) {
+            return;
+        }
         Timer const *timerEvt = static_cast<Timer const *>(e);
         hsmn = timerEvt->GetHsmn();
     } else {
         Evt const *evt = static_cast<Evt const *>(e);
         hsmn = evt->GetTo();
     }
+    Prof::RecordLatency(this->getPrio(), e, this->m_eQueue.getNFree());
+    if (hsmn == HSM_UNDEF) {
+        // Published event. Dispatch to each subscriber in this active object. See Fw::Publish().
+        Fw::HsmnSet subscr = Fw::GetSubscriber(e->sig, this);
+        for (uint32_t i = 0; subscr; i++) {
+            Fw::HsmnSet bit = static_cast<Fw::HsmnSet>(1) << i;
+            if (subscr & bit) {
+                subscr &= ~bit;
+                DispatchTo(i, e);
+            }
+        }
+    } else {
+        DispatchTo(hsmn, e);
+    }
+}
+
+template <class QBase>
+void ActiveBase<QBase>::DispatchTo(Hsmn hsmn, QEvt const * const e) {
     if (hsmn == m_hsm.GetHsmn()) {
         // For active object, e must be from the active object's event queue (dynamic or static/timer).
         // Garbage collection, if needed, is done by the caller.
-        QHsm::dispatch(e);
+        // QBase::dispatch() is QHsm::dispatch() for QActive and QMsm::dispatch() for QMActive.
+        uint32_t startTime = Prof::GetTime();
+        QBase::dispatch(e);
         // Handle all reminder events generated as a result of e.
         m_hsm.DispatchReminder();
+        Prof::Record(hsmn, e->sig, startTime);
     } else {
-        HsmnReg *hsmnReg = m_hsmnRegMap.GetByKey(hsmn);
-        if (hsmnReg && hsmnReg->GetValue()) {
-            hsmnReg->GetValue()->dispatch(e);
+        QHsm *reg = m_hsmnRegTable.Get(hsmn);
+        if (reg) {
+            reg->dispatch(e);
         }
     }
 }
 
-void Active::PostSync(Evt const *e) {
+template <class QBase>
+void ActiveBase<QBase>::PostSync(Evt const *e) {
     FW_ASSERT(e);
-    postLIFO(e);
+    Fw::SetPostTime(e);
+    this->postLIFO(e);
 }
 
+// Publishes e (sent to HSM_UNDEF) to the subscribers within this container only. Like PostSync(), e is
+// dispatched before any other event in the queue. Subscribers in other containers do not receive it.
+template <class QBase>
+void ActiveBase<QBase>::PublishSync(Evt const *e) {
+    FW_ASSERT(e && (e->GetTo() == HSM_UNDEF));
+    PostSync(e);
+}
+
+template class ActiveBase<QActive>;
+template class ActiveBase<QMActive>;
+
 } // namespace FW
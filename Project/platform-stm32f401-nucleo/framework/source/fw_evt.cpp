@@ -38,6 +38,7 @@
 
 #include "qpcpp.h"
 #include "fw_evt.h"
+#include "fw.h"
 #include "fw_assert.h"
 
 FW_DEFINE_THIS_FILE("fw_evt.cpp")
@@ -47,7 +48,7 @@ using namespace QP;
 namespace FW {
 
 void *Evt::operator new(size_t evtSize) {
-    return QF::newX_(evtSize, 0, 0);
+    return Fw::AllocEvt(evtSize);
 }
 
 void Evt::operator delete(void *evt) {
@@ -55,4 +56,11 @@ void Evt::operator delete(void *evt) {
     FW_ASSERT(0);
 }
 
+#if FW_EVT_COUNT
+// Updates event statistics for dynamic events. See Fw::OnEvtCreate().
+void Evt::OnCreate(Evt const *e) {
+    Fw::OnEvtCreate(e);
+}
+#endif
+
 } // namespace FW
@@ -48,8 +48,8 @@ using namespace QP;
 
 namespace FW {
 
-Hsm::Hsm(Hsmn hsmn, char const *name, QP::QHsm *qhsm) :
-    m_hsmn(hsmn), m_name(name), m_qhsm(qhsm), m_state(Log::GetUndefName()),
+Hsm::Hsm(Hsmn hsmn, char const *name, QP::QHsm *qhsm, bool isMsm) :
+    m_hsmn(hsmn), m_name(name), m_qhsm(qhsm), m_isMsm(isMsm), m_state(Log::GetUndefName()),
     m_nextSequence(0), m_inHsmnSeq(HSM_UNDEF, 0),
     m_outHsmnSeqMap(m_outHsmnSeqStor, ARRAY_COUNT(m_outHsmnSeqStor), HsmnSeq(HSM_UNDEF, 0)) {}
 
@@ -97,7 +97,12 @@ bool Hsm::HandleCfmRsp(ErrorEvt const &e, bool &allReceived) {
 
 void Hsm::DispatchReminder() {
     while (QEvt const *reminder = m_reminderQueue.get()) {
-        m_qhsm->QHsm::dispatch(reminder);
+        if (m_isMsm) {
+            // Like QMActive::dispatch(), relies on QMActive having the same layout as QMsm.
+            reinterpret_cast<QMsm *>(m_qhsm)->QMsm::dispatch(reminder);
+        } else {
+            m_qhsm->QHsm::dispatch(reminder);
+        }
         // A reminder event must be dynamic and is garbage collected after being processed.
         FW_ASSERT(QF_EVT_POOL_ID_(reminder) != 0);
         // A reminder event must be an internal or interface event (but not a timer event).
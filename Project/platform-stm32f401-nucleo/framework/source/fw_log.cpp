@@ -38,6 +38,7 @@
 
 #include <stdarg.h>
 #include <stdio.h>
+#include <string.h>
 #include "bsp.h"
 #include "qpcpp.h"
 #include "fw_hsm.h"
@@ -57,6 +58,17 @@ uint32_t Log::m_onStor[ROUND_UP_DIV(MAX_HSM_COUNT, 32)];
 Bitset Log::m_on(m_onStor, ARRAY_COUNT(m_onStor), MAX_HSM_COUNT);
 Log::HsmnInf Log::m_hsmnInfStor[MAX_HSM_COUNT];
 Log::HsmnInfMap Log::m_hsmnInfMap(m_hsmnInfStor, ARRAY_COUNT(m_hsmnInfStor), HsmnInf(HSM_UNDEF, Inf(NULL, 0, false)));
+Log::DefaultInf Log::m_defaultInf[MAX_DEFAULT_INF];
+uint32_t Log::m_defaultInfCount;
+#if FW_LOG_LOSSLESS
+bool Log::m_lossless;
+Log::StageRec Log::m_stageStor[STAGE_COUNT];
+Log::StageRec *Log::m_stageHead;
+Log::StageRec *Log::m_stageTail;
+uint32_t Log::m_stageCnt;
+#endif
+uint32_t Log::m_dropByteCnt;
+uint32_t Log::m_stallCnt;
 
 char const * const Log::m_typeName[NUM_TYPE] = {
     "<ERROR>",
@@ -74,7 +86,40 @@ char const * const Log::m_builtinEvtName[] = {
     "EXIT",
     "INIT"
 };
+QEvt const Log::m_builtinEvt[] = {
+    QEvt(0, QEvt::STATIC_EVT),
+    QEvt(1, QEvt::STATIC_EVT),
+    QEvt(2, QEvt::STATIC_EVT),
+    QEvt(3, QEvt::STATIC_EVT)
+};
 char const Log::m_undefName[] = "UNDEF";
+char const Log::m_evtFromFormat[] = "%s %s from %s(%d) seq=%d";
+char const Log::m_evtFormat[] = "%s %s";
+
+#if FW_LOG_BIN
+Log::BinMode Log::m_binMode = BIN_OFF;
+char const * const Log::m_binModeName[NUM_BIN_MODE] = {
+    "off",
+    "text",
+    "raw"
+};
+Log::BinRecord Log::m_binRing[BIN_RECORD_COUNT];
+uint32_t Log::m_binHead;
+uint32_t Log::m_binTail;
+uint32_t Log::m_binDropCnt;
+
+// Formats a single conversion specification. starCnt ints for '*' width and precision precede val.
+template <typename T>
+static int FormatArg(char *buf, uint32_t bufLen, char const *spec, uint32_t starCnt, int const *star, T val) {
+    if (starCnt == 2) {
+        return snprintf(buf, bufLen, spec, star[0], star[1], val);
+    }
+    if (starCnt == 1) {
+        return snprintf(buf, bufLen, spec, star[0], val);
+    }
+    return snprintf(buf, bufLen, spec, val);
+}
+#endif
 
 Log::EvtSetStor Log::GetEvtSetStor() {
     // Event names for each HSM. Only the 1st HSM of an event interface is actually used.
@@ -120,11 +165,25 @@ char const *Log::GetBuiltinEvtName(QP::QSignal signal) {
     return GetUndefName();
 }
 
+// Returns a static event of a built-in signal (e.g. Q_ENTRY_SIG) to log QMsm entry, exit and initial actions.
+QEvt const *Log::GetBuiltinEvt(QSignal signal) {
+    FW_ASSERT(signal < ARRAY_COUNT(m_builtinEvt));
+    return &m_builtinEvt[signal];
+}
+
 void Log::AddInterface(Hsmn infHsmn, Fifo *fifo, QSignal sig, bool isDefault) {
     FW_LOG_ASSERT((infHsmn != HSM_UNDEF) && fifo && sig);
     QF_CRIT_STAT_TYPE crit;
     QF_CRIT_ENTRY(crit);
     m_hsmnInfMap.Save(HsmnInf(infHsmn, Inf(fifo, sig, isDefault)));
+    if (isDefault) {
+        FW_ASSERT(m_defaultInfCount < MAX_DEFAULT_INF);
+        DefaultInf &inf = m_defaultInf[m_defaultInfCount++];
+        inf.m_hsmn = infHsmn;
+        inf.m_fifo = fifo;
+        inf.m_sig = sig;
+        inf.m_stageCnt = 0;
+    }
     QF_CRIT_EXIT(crit);
 }
 
@@ -132,12 +191,21 @@ void Log::RemoveInterface(Hsmn infHsmn) {
     QF_CRIT_STAT_TYPE crit;
     QF_CRIT_ENTRY(crit);
     m_hsmnInfMap.ClearByKey(infHsmn);
+    for (uint32_t i = 0; i < m_defaultInfCount; i++) {
+        if (m_defaultInf[i].m_hsmn == infHsmn) {
+#if FW_LOG_LOSSLESS
+            FreeStagedNoCrit(infHsmn);
+#endif
+            m_defaultInf[i] = m_defaultInf[--m_defaultInfCount];
+            break;
+        }
+    }
     QF_CRIT_EXIT(crit);
 }
 
 // @param infHsmn - HSMN of the interface object to write to.
 //                  If it is HSM_UNDEF, it writes to all "default" interfaces (default mode).
-//                  In default mode when a FIFO is full, the message is truncated.
+//                  In default mode when a FIFO is full, the message is truncated, or staged in lossless mode.
 // @param buf - Pointer to byte buffer.
 // @param len - Length in bytes.
 // @return Number of bytes written. In default mode, it is always equal to len, even when message is truncated.
@@ -173,42 +241,33 @@ uint32_t Log::Write(Hsmn infHsmn, char const *buf, uint32_t len) {
     return result;
 }
 
-// @description Writes to all "default" interfaces. If a FIFO is full, the message is truncated.
+// @description Writes to all "default" interfaces. If a FIFO is full, the message is truncated, or staged in
+//              lossless mode.
 // @param buf - Pointer to byte buffer.
 // @param len - Length in bytes.
 void Log::WriteDefault(char const *buf, uint32_t len) {
     uint32_t writeCount = 0;
-    uint32_t index = m_hsmnInfMap.GetTotalCount();
-    while (index--) {
-        HsmnInf *kv = m_hsmnInfMap.GetByIndex(index);
+    for (uint32_t i = 0; ; i++) {
         // Maintain critical section within loop to reduce interrupt latency.
-        // Okay to miss a new entry after passing its index.
+        // Okay to miss an interface added or removed meanwhile.
         QF_CRIT_STAT_TYPE crit;
         QF_CRIT_ENTRY(crit);
-        Hsmn infHsmn = kv->GetKey();
-        if ((infHsmn != HSM_UNDEF) && (kv->GetValue().IsDefault())) {
-            Fifo *fifo = kv->GetValue().GetFifo();
-            FW_ASSERT(fifo);
-            bool status1 = false;
-            bool status2 = false;
-            if (fifo->IsTruncated()) {
-                fifo->WriteNoCrit(reinterpret_cast<uint8_t const *>(m_truncatedError), CONST_STRING_LEN(m_truncatedError), &status1);
-            }
-            if (!fifo->IsTruncated()) {
-                fifo->WriteNoCrit(reinterpret_cast<uint8_t const *>(buf), len, &status2);
-            }
-            QF_CRIT_EXIT(crit);
-            // Post MUST be outside critical section.
-            if (status1 || status2) {
-                QSignal sig = kv->GetValue().GetSig();
-                FW_ASSERT(sig);
-                Evt *evt = new Evt(sig, infHsmn);
-                Fw::Post(evt);
-            }
-            writeCount++;
-        } else {
+        if (i >= m_defaultInfCount) {
             QF_CRIT_EXIT(crit);
+            break;
+        }
+        DefaultInf &inf = m_defaultInf[i];
+        Hsmn infHsmn = inf.m_hsmn;
+        QSignal sig = inf.m_sig;
+        bool notify = WriteDefaultNoCrit(inf, reinterpret_cast<uint8_t const *>(buf), len);
+        QF_CRIT_EXIT(crit);
+        // Post MUST be outside critical section.
+        if (notify) {
+            FW_ASSERT(sig);
+            Evt *evt = new Evt(sig, infHsmn);
+            Fw::Post(evt);
         }
+        writeCount++;
     }
     if (writeCount == 0) {
         // Gallium - If no FIFO has been setup, write to BSP usart directly.
@@ -216,6 +275,198 @@ void Log::WriteDefault(char const *buf, uint32_t len) {
     }
 }
 
+// @description Writes a message made of up to two blocks to a default interface. Must be called within
+//              critical section. If the FIFO is full, the message is truncated. In lossless mode, it is
+//              staged instead, as are all messages after it until the staged ones have been flushed.
+// @return True if the interface needs to be notified.
+bool Log::WriteDefaultNoCrit(DefaultInf &inf, uint8_t const *buf0, uint32_t len0, uint8_t const *buf1, uint32_t len1) {
+    Fifo *fifo = inf.m_fifo;
+    FW_ASSERT(fifo);
+    uint32_t len = len0 + len1;
+    bool fit = (fifo->GetAvailCountNoCrit() >= len);
+    bool status1 = false;
+    bool status2 = false;
+#if FW_LOG_LOSSLESS
+    if (m_lossless) {
+        if (fit && (inf.m_stageCnt == 0)) {
+            fifo->WriteNoCrit(buf0, len0, &status2);
+            if (len1) {
+                fifo->WriteNoCrit(buf1, len1);
+            }
+            return status2;
+        }
+        m_stallCnt++;
+        return StageNoCrit(inf, buf0, len0, buf1, len1);
+    }
+#endif
+    if (fifo->IsTruncated()) {
+        fifo->WriteNoCrit(reinterpret_cast<uint8_t const *>(m_truncatedError), CONST_STRING_LEN(m_truncatedError), &status1);
+        fit = !fifo->IsTruncated() && (fifo->GetAvailCountNoCrit() >= len);
+    }
+    if (fit) {
+        fifo->WriteNoCrit(buf0, len0, &status2);
+        if (len1) {
+            fifo->WriteNoCrit(buf1, len1);
+        }
+    } else {
+        if (!fifo->IsTruncated()) {
+            // Sets truncated without writing anything.
+            fifo->WriteNoCrit(buf0, len);
+        }
+        m_dropByteCnt += len;
+    }
+    return status1 || status2;
+}
+
+#if FW_LOG_LOSSLESS
+// @description Stages a message made of up to two blocks for a default interface in lossless mode. Must be called
+//              within critical section. A message longer than BUF_LEN is split into consecutive records, which
+//              FlushStaged() writes in order. The message is dropped as a whole if the pool does not have
+//              enough free records.
+// @return True if the interface needs to be notified (always false).
+bool Log::StageNoCrit(DefaultInf &inf, uint8_t const *buf0, uint32_t len0, uint8_t const *buf1, uint32_t len1) {
+    uint32_t len = len0 + len1;
+    if (ROUND_UP_DIV(len, BUF_LEN) > (STAGE_COUNT - m_stageCnt)) {
+        m_dropByteCnt += len;
+        return false;
+    }
+    uint32_t offset = 0;
+    for (uint32_t i = 0; offset < len; i++) {
+        FW_ASSERT(i < STAGE_COUNT);
+        StageRec &rec = m_stageStor[i];
+        if (rec.m_infHsmn != HSM_UNDEF) {
+            continue;
+        }
+        uint32_t recLen = LESS(len - offset, static_cast<uint32_t>(BUF_LEN));
+        uint32_t copyLen = 0;
+        if (offset < len0) {
+            copyLen = LESS(len0 - offset, recLen);
+            memcpy(rec.m_buf, buf0 + offset, copyLen);
+        }
+        if (copyLen < recLen) {
+            memcpy(rec.m_buf + copyLen, buf1 + (offset + copyLen - len0), recLen - copyLen);
+        }
+        rec.m_next = NULL;
+        rec.m_infHsmn = inf.m_hsmn;
+        rec.m_len = recLen;
+        if (m_stageTail) {
+            m_stageTail->m_next = &rec;
+        } else {
+            m_stageHead = &rec;
+        }
+        m_stageTail = &rec;
+        m_stageCnt++;
+        inf.m_stageCnt++;
+        offset += recLen;
+    }
+    return false;
+}
+
+// Releases all records staged for an interface, e.g. when it is removed. Must be called within critical section.
+void Log::FreeStagedNoCrit(Hsmn infHsmn) {
+    StageRec *prev = NULL;
+    StageRec *rec = m_stageHead;
+    while (rec) {
+        StageRec *next = rec->m_next;
+        if (rec->m_infHsmn == infHsmn) {
+            if (prev) {
+                prev->m_next = next;
+            } else {
+                m_stageHead = next;
+            }
+            if (m_stageTail == rec) {
+                m_stageTail = prev;
+            }
+            m_dropByteCnt += rec->m_len;
+            rec->m_infHsmn = HSM_UNDEF;
+            m_stageCnt--;
+        } else {
+            prev = rec;
+        }
+        rec = next;
+    }
+}
+
+// @description Writes records staged for a default interface in lossless mode, in order, as long as they fit
+//              in its FIFO. It is called by the client of the interface when the FIFO has drained, e.g. on
+//              UART_OUT_EMPTY_IND.
+// @param infHsmn - HSMN of the interface.
+void Log::FlushStaged(Hsmn infHsmn) {
+    QSignal sig = 0;
+    bool notify = false;
+    bool done = false;
+    while (!done) {
+        // Writes one record per critical section to reduce interrupt latency.
+        QF_CRIT_STAT_TYPE crit;
+        QF_CRIT_ENTRY(crit);
+        done = true;
+        DefaultInf *inf = NULL;
+        for (uint32_t i = 0; i < m_defaultInfCount; i++) {
+            if (m_defaultInf[i].m_hsmn == infHsmn) {
+                inf = &m_defaultInf[i];
+                break;
+            }
+        }
+        if (inf && inf->m_stageCnt) {
+            StageRec *prev = NULL;
+            StageRec *rec = m_stageHead;
+            while (rec->m_infHsmn != infHsmn) {
+                prev = rec;
+                rec = rec->m_next;
+                FW_ASSERT(rec);
+            }
+            Fifo *fifo = inf->m_fifo;
+            if (fifo->GetAvailCountNoCrit() >= rec->m_len) {
+                bool status = false;
+                fifo->WriteNoCrit(rec->m_buf, rec->m_len, &status);
+                notify = notify || status;
+                sig = inf->m_sig;
+                if (prev) {
+                    prev->m_next = rec->m_next;
+                } else {
+                    m_stageHead = rec->m_next;
+                }
+                if (m_stageTail == rec) {
+                    m_stageTail = prev;
+                }
+                rec->m_infHsmn = HSM_UNDEF;
+                inf->m_stageCnt--;
+                m_stageCnt--;
+                done = false;
+            }
+        }
+        QF_CRIT_EXIT(crit);
+    }
+    // Post MUST be outside critical section.
+    if (notify) {
+        FW_ASSERT(sig);
+        Evt *evt = new Evt(sig, infHsmn);
+        Fw::Post(evt);
+    }
+}
+#endif // FW_LOG_LOSSLESS
+
+void Log::GetStat(uint32_t &dropByteCnt, uint32_t &stallCnt, uint32_t &stageCnt) {
+    QF_CRIT_STAT_TYPE crit;
+    QF_CRIT_ENTRY(crit);
+    dropByteCnt = m_dropByteCnt;
+    stallCnt = m_stallCnt;
+#if FW_LOG_LOSSLESS
+    stageCnt = m_stageCnt;
+#else
+    stageCnt = 0;
+#endif
+    QF_CRIT_EXIT(crit);
+}
+
+void Log::ClearStat() {
+    QF_CRIT_STAT_TYPE crit;
+    QF_CRIT_ENTRY(crit);
+    m_dropByteCnt = 0;
+    m_stallCnt = 0;
+    QF_CRIT_EXIT(crit);
+}
+
 uint32_t Log::PutChar(Hsmn infHsmn, char c) {
     return Write(infHsmn, &c, 1);
 }
@@ -245,6 +496,17 @@ void Log::PutStrOver(Hsmn infHsmn, char const *str, uint32_t oldLen) {
 uint32_t Log::Print(Hsmn infHsmn, char const *format, ...) {
     va_list arg;
     va_start(arg, format);
+    Line line;
+    if (BeginLine(line, infHsmn)) {
+        VAppendLine(line, format, arg);
+        if (EndLine(line)) {
+            va_end(arg);
+            return line.m_len;
+        }
+        // Fall back to using a local buffer.
+        va_end(arg);
+        va_start(arg, format);
+    }
     char buf[BUF_LEN];
     uint32_t len = vsnprintf(buf, sizeof(buf), format, arg);
     va_end(arg);
@@ -291,9 +553,22 @@ void Log::Event(Type type, Hsmn hsmn, QP::QEvt const *e, char const *func) {
     if (IS_EVT_HSMN_VALID(e->sig) && !IS_TIMER_EVT(e->sig)) {
         Evt const *evt = static_cast<Evt const *>(e);
         Hsmn from = evt->GetFrom();
+#if FW_LOG_BIN
+        if ((m_binMode != BIN_OFF) &&
+            RecordBin(BIN_EVENT, hsmn, hsm->GetName(), m_evtFromFormat, func, GetEvtName(e->sig), GetHsmName(from),
+                      from, evt->GetSeq())) {
+            return;
+        }
+#endif
         Print(HSM_UNDEF, "%lu %s(%u): %s %s from %s(%d) seq=%d\n\r",
               GetSystemMs(), hsm->GetName(), hsmn, func, GetEvtName(e->sig), GetHsmName(from), from, evt->GetSeq());
     } else {
+#if FW_LOG_BIN
+        if ((m_binMode != BIN_OFF) &&
+            RecordBin(BIN_EVENT, hsmn, hsm->GetName(), m_evtFormat, func, GetEvtName(e->sig))) {
+            return;
+        }
+#endif
         Print(HSM_UNDEF, "%lu %s(%u): %s %s\n\r", GetSystemMs(), hsm->GetName(), hsmn, func, GetEvtName(e->sig));
     }
 }
@@ -304,6 +579,32 @@ void Log::Debug(Type type, Hsmn hsmn, char const *format, ...) {
     if (!IsOutput(type, hsmn)) {
         return;
     }
+#if FW_LOG_BIN
+    if (m_binMode != BIN_OFF) {
+        va_list arg;
+        va_start(arg, format);
+        bool recorded = VRecordBin(type, hsmn, hsm->GetName(), format, arg);
+        va_end(arg);
+        if (recorded) {
+            return;
+        }
+        // Fall back to formatting immediately, e.g. for a string argument not in flash.
+    }
+#endif
+    Line line;
+    if (BeginLine(line, HSM_UNDEF)) {
+        // Note there is no space after type name.
+        AppendLine(line, "%lu %s(%u): %s", GetSystemMs(), hsm->GetName(), hsmn, GetTypeName(type));
+        va_list arg;
+        va_start(arg, format);
+        VAppendLine(line, format, arg);
+        va_end(arg);
+        AppendLine(line, "\n\r");
+        if (EndLine(line)) {
+            return;
+        }
+        // Fall back to using a local buffer.
+    }
     char buf[BUF_LEN];
     // Reserve 2 bytes for newline.
     const uint32_t MAX_LEN = sizeof(buf) - 2;
@@ -324,6 +625,38 @@ void Log::Debug(Type type, Hsmn hsmn, char const *format, ...) {
     Write(HSM_UNDEF, buf, len);
 }
 
+// @description Formats to a FIFO which is not necessarily a registered interface, e.g. a command FIFO.
+//              The formatted string is written directly into the free space of the FIFO if possible.
+//              Caller must ensure no other writes to fifo are made by higher priority contexts.
+// @param fifo - FIFO to write to.
+// @param status - Set to true if the FIFO was empty before this write (i.e. the reader needs to be notified).
+// @return Number of bytes written. 0 if the FIFO does not have enough space (i.e. no partial write).
+uint32_t Log::PrintFifo(Fifo &fifo, bool *status, char const *format, ...) {
+    va_list arg;
+    va_start(arg, format);
+    uint32_t len = VPrintFifo(fifo, status, format, arg);
+    va_end(arg);
+    return len;
+}
+
+uint32_t Log::VPrintFifo(Fifo &fifo, bool *status, char const *format, va_list arg) {
+    Line line;
+    if (BeginLine(line, HSM_UNDEF, &fifo)) {
+        va_list argCopy;
+        va_copy(argCopy, arg);
+        VAppendLine(line, format, argCopy);
+        va_end(argCopy);
+        if (EndLine(line, status)) {
+            return line.m_len;
+        }
+        // Fall back to using a local buffer.
+    }
+    char buf[BUF_LEN];
+    uint32_t len = vsnprintf(buf, sizeof(buf), format, arg);
+    len = LESS(len, sizeof(buf) - 1);
+    return fifo.Write(reinterpret_cast<uint8_t const *>(buf), len, status);
+}
+
 uint32_t Log::PrintBufLine(Hsmn infHsmn, uint8_t const *lineBuf, uint32_t lineLen, uint8_t unit, uint32_t lineLabel) {
     char buf[BUF_LEN];
     // Reserve 2 bytes for newline.
@@ -398,6 +731,161 @@ void Log::DebugBuf(Type type, Hsmn hsmn, uint8_t const *dataBuf, uint32_t dataLe
     }
 }
 
+// @description Begins formatting a line directly into the free space of an output FIFO, which removes the
+//              copy from a local buffer. Up to BUF_LEN bytes are reserved, so that other writers (including
+//              ISRs) preempting the caller can still write to the FIFO after the reserved space. Another
+//              writer that finds the FIFO already reserved falls back to its local buffer.
+//              It is not supported in ISR, or when the FIFO has been truncated (in which case the truncation
+//              mark must be written first). In those cases it returns false and the caller must fall back
+//              to formatting into a local buffer.
+// @param line - Line to initialize.
+// @param infHsmn - HSMN of the interface object to write to. If it is HSM_UNDEF, the line is formatted into
+//                  the FIFO of the first default interface and copied to the others in EndLine().
+// @param fifo - If not NULL, the FIFO to write to directly (infHsmn is ignored).
+// @return True if space has been reserved and AppendLine() and EndLine() can be called.
+bool Log::BeginLine(Line &line, Hsmn infHsmn, Fifo *fifo) {
+    if (QXK_ISR_CONTEXT_()) {
+        return false;
+    }
+    QF_CRIT_STAT_TYPE crit;
+    QF_CRIT_ENTRY(crit);
+    if (fifo) {
+        line.m_fifo = fifo;
+    } else if (infHsmn == HSM_UNDEF) {
+        // Falls back when records are staged for the interface, so that they are written first.
+        if (m_defaultInfCount && (m_defaultInf[0].m_stageCnt == 0)) {
+            line.m_fifo = m_defaultInf[0].m_fifo;
+            line.m_infHsmn = m_defaultInf[0].m_hsmn;
+            line.m_sig = m_defaultInf[0].m_sig;
+            FW_ASSERT(line.m_fifo && line.m_sig);
+        }
+        line.m_isDefault = true;
+    } else {
+        HsmnInf *kv = m_hsmnInfMap.GetByKey(infHsmn);
+        if (kv) {
+            line.m_fifo = kv->GetValue().GetFifo();
+            line.m_infHsmn = kv->GetKey();
+            line.m_sig = kv->GetValue().GetSig();
+            FW_ASSERT(line.m_fifo && line.m_sig);
+        }
+    }
+    line.m_len = 0;
+    line.m_ok = line.m_fifo && !line.m_fifo->IsTruncated() &&
+                line.m_fifo->ReserveNoCrit(BUF_LEN, line.m_span);
+    QF_CRIT_EXIT(crit);
+    return line.m_ok;
+}
+
+void Log::AppendLine(Line &line, char const *format, ...) {
+    va_list arg;
+    va_start(arg, format);
+    VAppendLine(line, format, arg);
+    va_end(arg);
+}
+
+// @description Appends formatted string to a line started by BeginLine(). If the string crosses the
+//              wraparound point of the reserved space, it is formatted again at the start of the second
+//              block and its head is moved to the end of the first block. Since this only happens once
+//              per pass over the FIFO, it is cheaper than always formatting into a local buffer.
+//              If there is not enough space, the line is marked as failed and the caller must fall back.
+void Log::VAppendLine(Line &line, char const *format, va_list arg) {
+    if (!line.m_ok) {
+        return;
+    }
+    Fifo::Span const &span = line.m_span;
+    uint32_t len0 = span.GetLen(0);
+    char *dest = NULL;
+    uint32_t room = 0;
+    if (line.m_len < len0) {
+        dest = reinterpret_cast<char *>(span.GetBuf(0)) + line.m_len;
+        room = len0 - line.m_len;
+    } else if (span.GetLen(1)) {
+        dest = reinterpret_cast<char *>(span.GetBuf(1)) + (line.m_len - len0);
+        room = span.GetLen(1) - (line.m_len - len0);
+    }
+    va_list argCopy;
+    va_copy(argCopy, arg);
+    int result = vsnprintf(dest, room, format, arg);
+    if (result < 0) {
+        line.m_ok = false;
+    } else if (static_cast<uint32_t>(result) < room) {
+        line.m_len += result;
+    } else if ((line.m_len < len0) && (static_cast<uint32_t>(result) < span.GetLen(1))) {
+        // Crossing wraparound point. Note vsnprintf() needs space for the null terminator.
+        char *buf1 = reinterpret_cast<char *>(span.GetBuf(1));
+        vsnprintf(buf1, span.GetLen(1), format, argCopy);
+        memcpy(dest, buf1, room);
+        memmove(buf1, buf1 + room, result - room);
+        line.m_len += result;
+    } else {
+        line.m_ok = false;
+    }
+    va_end(argCopy);
+}
+
+// @description Ends a line started by BeginLine(). If formatting was successful, the line is committed
+//              and the interface is notified. Otherwise the reserved space is released.
+//              In default mode, the line is also copied to all other default interfaces. It is done before
+//              the commit in the same critical section, since the reserved space can be read and reused
+//              as soon as it is committed.
+// @param line - Line started by BeginLine().
+// @param status - Optional. See Pipe::Write(). Only meaningful for a FIFO passed to BeginLine() directly.
+// @return True if the line has been written. False if the caller must fall back.
+bool Log::EndLine(Line &line, bool *status) {
+    FW_ASSERT(line.m_fifo);
+    bool notify = false;
+    bool compact = false;
+    // Other default interfaces to notify.
+    Hsmn infHsmn[MAX_DEFAULT_INF];
+    QSignal infSig[MAX_DEFAULT_INF];
+    uint32_t infCount = 0;
+    QF_CRIT_STAT_TYPE crit;
+    QF_CRIT_ENTRY(crit);
+    if (line.m_ok) {
+        if (line.m_isDefault) {
+            Fifo::Span const &span = line.m_span;
+            uint32_t len0 = LESS(line.m_len, span.GetLen(0));
+            for (uint32_t i = 0; i < m_defaultInfCount; i++) {
+                DefaultInf &inf = m_defaultInf[i];
+                if ((inf.m_hsmn != line.m_infHsmn) &&
+                    WriteDefaultNoCrit(inf, span.GetBuf(0), len0, span.GetBuf(1), line.m_len - len0)) {
+                    infHsmn[infCount] = inf.m_hsmn;
+                    infSig[infCount] = inf.m_sig;
+                    infCount++;
+                }
+            }
+        }
+        compact = line.m_fifo->CommitNoCrit(line.m_len, &notify);
+    } else {
+        compact = line.m_fifo->CancelNoCrit();
+    }
+    QF_CRIT_EXIT(crit);
+    if (compact) {
+        // Moves entries written by preempting writers in bounded steps.
+        bool compactNotify = false;
+        line.m_fifo->Compact(&compactNotify);
+        notify = notify || compactNotify;
+    }
+    if (status) {
+        *status = notify;
+    }
+    // Post MUST be outside critical section.
+    if (notify && line.m_sig) {
+        Evt *evt = new Evt(line.m_sig, line.m_infHsmn);
+        Fw::Post(evt);
+    }
+    for (uint32_t i = 0; i < infCount; i++) {
+        FW_ASSERT(infSig[i]);
+        Evt *evt = new Evt(infSig[i], infHsmn[i]);
+        Fw::Post(evt);
+    }
+    if (IsLossless() && line.m_isDefault && (line.m_infHsmn != HSM_UNDEF)) {
+        // Records may have been staged (e.g. in ISR) while the FIFO was full.
+        FlushStaged(line.m_infHsmn);
+    }
+    return line.m_ok;
+}
+
 void Log::On(Hsmn hsmn) {
     QF_CRIT_STAT_TYPE crit;
     QF_CRIT_ENTRY(crit);
@@ -430,6 +918,335 @@ bool Log::IsOutput(Type type, Hsmn hsmn) {
     return (type < m_verbosity) && IsOn(hsmn);
 }
 
+#if FW_LOG_BIN
+char const *Log::GetBinModeName(BinMode mode) {
+    FW_ASSERT(mode < NUM_BIN_MODE);
+    return m_binModeName[mode];
+}
+
+// @description Writes out one pending binary log record, as text or as a hex line depending on the mode.
+//              It is called in idle time so that formatting is off the path of active objects.
+//              When the ring has been emptied after an overflow, a drop mark with the number of dropped
+//              records is written.
+// @return True if anything has been written, in which case the caller should call it again before idling.
+bool Log::FlushBin() {
+    BinRecord rec;
+    uint32_t dropCnt = 0;
+    bool found = false;
+    QF_CRIT_STAT_TYPE crit;
+    QF_CRIT_ENTRY(crit);
+    if (m_binTail != m_binHead) {
+        rec = m_binRing[m_binTail & (BIN_RECORD_COUNT - 1)];
+        m_binTail++;
+        found = true;
+    } else {
+        dropCnt = m_binDropCnt;
+        m_binDropCnt = 0;
+    }
+    QF_CRIT_EXIT(crit);
+    char buf[BUF_LEN];
+    uint32_t len;
+    if (found) {
+        len = (m_binMode == BIN_RAW) ? EncodeBin(rec, buf, sizeof(buf)) : RenderBin(rec, buf, sizeof(buf));
+    } else if (dropCnt) {
+        len = snprintf(buf, sizeof(buf), "<##DROP %lu##>\n\r", dropCnt);
+        len = LESS(len, sizeof(buf) - 1);
+    } else {
+        return false;
+    }
+    Write(HSM_UNDEF, buf, len);
+    return true;
+}
+
+bool Log::RecordBin(uint8_t type, Hsmn hsmn, char const *name, char const *format, ...) {
+    va_list arg;
+    va_start(arg, format);
+    bool result = VRecordBin(type, hsmn, name, format, arg);
+    va_end(arg);
+    return result;
+}
+
+// @description Records a log call into the binary ring without formatting. Arguments are fetched per the
+//              conversion specifications of format and stored as raw words. Since formatting is deferred,
+//              the format string and any string arguments must be in flash to stay valid.
+// @return False if the call cannot be recorded and must be formatted immediately, e.g. for a string argument
+//         on the stack or too many arguments. True if recorded, or dropped since the ring is full.
+bool Log::VRecordBin(uint8_t type, Hsmn hsmn, char const *name, char const *format, va_list arg) {
+    if (!IsConstAddr(name) || !IsConstAddr(format)) {
+        return false;
+    }
+    BinRecord rec;
+    rec.m_time = GetSystemMs();
+    rec.m_name = name;
+    rec.m_format = format;
+    rec.m_hsmn = hsmn;
+    rec.m_type = type;
+    rec.m_argCnt = 0;
+    char const *p = format;
+    while ((p = strchr(p, '%')) != NULL) {
+        ArgClass argClass;
+        uint32_t starCnt;
+        p = ParseSpec(p + 1, argClass, starCnt);
+        while (starCnt--) {
+            int star = va_arg(arg, int);
+            if (!PutBinArg(rec, &star, sizeof(star))) {
+                return false;
+            }
+        }
+        bool ok = true;
+        switch (argClass) {
+            case ARG_NONE: break;
+            case ARG_INT: {
+                int val = va_arg(arg, int);
+                ok = PutBinArg(rec, &val, sizeof(val));
+                break;
+            }
+            case ARG_LONG: {
+                long val = va_arg(arg, long);
+                ok = PutBinArg(rec, &val, sizeof(val));
+                break;
+            }
+            case ARG_LONG_LONG: {
+                long long val = va_arg(arg, long long);
+                ok = PutBinArg(rec, &val, sizeof(val));
+                break;
+            }
+            case ARG_SIZE: {
+                size_t val = va_arg(arg, size_t);
+                ok = PutBinArg(rec, &val, sizeof(val));
+                break;
+            }
+            case ARG_DOUBLE: {
+                double val = va_arg(arg, double);
+                ok = PutBinArg(rec, &val, sizeof(val));
+                break;
+            }
+            case ARG_PTR: {
+                void *val = va_arg(arg, void *);
+                ok = PutBinArg(rec, &val, sizeof(val));
+                break;
+            }
+            case ARG_STR: {
+                char const *val = va_arg(arg, char const *);
+                ok = IsConstAddr(val) && PutBinArg(rec, &val, sizeof(val));
+                break;
+            }
+            default: ok = false; break;
+        }
+        if (!ok) {
+            return false;
+        }
+    }
+    QF_CRIT_STAT_TYPE crit;
+    QF_CRIT_ENTRY(crit);
+    if ((m_binHead - m_binTail) < BIN_RECORD_COUNT) {
+        m_binRing[m_binHead & (BIN_RECORD_COUNT - 1)] = rec;
+        m_binHead++;
+    } else {
+        m_binDropCnt++;
+    }
+    QF_CRIT_EXIT(crit);
+    return true;
+}
+
+// Returns false if there is no room for val.
+bool Log::PutBinArg(BinRecord &rec, void const *val, uint32_t size) {
+    uint32_t wordCnt = ROUND_UP_DIV_4(size);
+    if ((rec.m_argCnt + wordCnt) > BIN_ARG_COUNT) {
+        return false;
+    }
+    memcpy(&rec.m_arg[rec.m_argCnt], val, size);
+    rec.m_argCnt += wordCnt;
+    return true;
+}
+
+// Gets an argument stored by PutBinArg() at index which is then advanced.
+void Log::GetBinArg(BinRecord const &rec, uint32_t &index, void *val, uint32_t size) {
+    uint32_t wordCnt = ROUND_UP_DIV_4(size);
+    FW_ASSERT((index + wordCnt) <= rec.m_argCnt);
+    memcpy(val, &rec.m_arg[index], size);
+    index += wordCnt;
+}
+
+// Renders a record to the same text as formatting it immediately. Each conversion specification is
+// formatted separately with its argument since a va_list cannot be constructed from stored words.
+uint32_t Log::RenderBin(BinRecord const &rec, char *buf, uint32_t bufLen) {
+    // Reserve 2 bytes for newline.
+    const uint32_t MAX_LEN = bufLen - 2;
+    uint32_t len = snprintf(buf, MAX_LEN, "%lu %s(%u): %s", rec.m_time, rec.m_name, rec.m_hsmn,
+                            (rec.m_type < NUM_TYPE) ? GetTypeName(static_cast<Type>(rec.m_type)) : "");
+    len = LESS(len, (MAX_LEN - 1));
+    uint32_t index = 0;
+    char const *p = rec.m_format;
+    while (*p && (len < (MAX_LEN - 1))) {
+        if (*p != '%') {
+            buf[len++] = *p++;
+            continue;
+        }
+        ArgClass argClass;
+        uint32_t starCnt;
+        char const *end = ParseSpec(p + 1, argClass, starCnt);
+        char spec[BIN_SPEC_LEN];
+        uint32_t specLen = end - p;
+        // Specifications have been validated by VRecordBin().
+        FW_ASSERT(specLen < sizeof(spec));
+        memcpy(spec, p, specLen);
+        spec[specLen] = 0;
+        p = end;
+        int star[2];
+        for (uint32_t i = 0; i < starCnt; i++) {
+            GetBinArg(rec, index, &star[i], sizeof(star[i]));
+        }
+        char *dest = &buf[len];
+        uint32_t room = MAX_LEN - len;
+        int result = 0;
+        switch (argClass) {
+            case ARG_NONE: result = snprintf(dest, room, "%%"); break;
+            case ARG_INT: {
+                int val;
+                GetBinArg(rec, index, &val, sizeof(val));
+                result = FormatArg(dest, room, spec, starCnt, star, val);
+                break;
+            }
+            case ARG_LONG: {
+                long val;
+                GetBinArg(rec, index, &val, sizeof(val));
+                result = FormatArg(dest, room, spec, starCnt, star, val);
+                break;
+            }
+            case ARG_LONG_LONG: {
+                long long val;
+                GetBinArg(rec, index, &val, sizeof(val));
+                result = FormatArg(dest, room, spec, starCnt, star, val);
+                break;
+            }
+            case ARG_SIZE: {
+                size_t val;
+                GetBinArg(rec, index, &val, sizeof(val));
+                result = FormatArg(dest, room, spec, starCnt, star, val);
+                break;
+            }
+            case ARG_DOUBLE: {
+                double val;
+                GetBinArg(rec, index, &val, sizeof(val));
+                result = FormatArg(dest, room, spec, starCnt, star, val);
+                break;
+            }
+            case ARG_PTR: {
+                void *val;
+                GetBinArg(rec, index, &val, sizeof(val));
+                result = FormatArg(dest, room, spec, starCnt, star, val);
+                break;
+            }
+            case ARG_STR: {
+                char const *val;
+                GetBinArg(rec, index, &val, sizeof(val));
+                result = FormatArg(dest, room, spec, starCnt, star, val);
+                break;
+            }
+            default: FW_ASSERT(0); break;
+        }
+        if (result > 0) {
+            len += LESS(static_cast<uint32_t>(result), room - 1);
+        }
+    }
+    len = LESS(len, MAX_LEN - 1);
+    buf[len++] = '\n';
+    buf[len++] = '\r';
+    buf[len] = 0;
+    return len;
+}
+
+// Encodes a record as a hex line "#B time hsmn type name format arg..." for LogDecode.py, which reads
+// the strings from the ELF file.
+uint32_t Log::EncodeBin(BinRecord const &rec, char *buf, uint32_t bufLen) {
+    uint32_t len = snprintf(buf, bufLen, "#B %lx %x %x %lx %lx", rec.m_time, rec.m_hsmn, rec.m_type,
+                            static_cast<uint32_t>(reinterpret_cast<uintptr_t>(rec.m_name)),
+                            static_cast<uint32_t>(reinterpret_cast<uintptr_t>(rec.m_format)));
+    for (uint32_t i = 0; (i < rec.m_argCnt) && (len < bufLen); i++) {
+        len += snprintf(&buf[len], bufLen - len, " %lx", rec.m_arg[i]);
+    }
+    len += snprintf(&buf[len], bufLen - len, "\n\r");
+    // The longest line with BIN_ARG_COUNT arguments fits in BUF_LEN.
+    FW_ASSERT(len < bufLen);
+    return len;
+}
+
+// @description Parses a conversion specification of printf().
+// @param p - Points to the character after '%'.
+// @param argClass - Returns the argument class. ARG_INVALID if not supported or too long.
+// @param starCnt - Returns the number of '*' for width and precision, each taking an int argument.
+// @return Points to the character after the specification.
+char const *Log::ParseSpec(char const *p, ArgClass &argClass, uint32_t &starCnt) {
+    char const *start = p;
+    starCnt = 0;
+    while (*p && strchr("-+ #0", *p)) {
+        p++;
+    }
+    for (uint32_t field = 0; field < 2; field++) {
+        if (field == 1) {
+            if (*p != '.') {
+                break;
+            }
+            p++;
+        }
+        if (*p == '*') {
+            starCnt++;
+            p++;
+        } else {
+            while ((*p >= '0') && (*p <= '9')) {
+                p++;
+            }
+        }
+    }
+    uint32_t longCnt = 0;
+    bool isSize = false;
+    bool isOther = false;
+    while (*p && strchr("hlzjtL", *p)) {
+        if (*p == 'l') {
+            longCnt++;
+        } else if (*p == 'z') {
+            isSize = true;
+        } else if (*p != 'h') {
+            isOther = true;
+        }
+        p++;
+    }
+    char conv = *p;
+    if (conv) {
+        p++;
+    }
+    if (isOther || (longCnt > 2) || (static_cast<uint32_t>(p - start) >= (BIN_SPEC_LEN - 1))) {
+        argClass = ARG_INVALID;
+    } else if (conv == '%') {
+        argClass = ARG_NONE;
+    } else if (conv && strchr("diuxXoc", conv)) {
+        argClass = isSize ? ARG_SIZE : (longCnt == 2) ? ARG_LONG_LONG : (longCnt == 1) ? ARG_LONG : ARG_INT;
+    } else if (conv && strchr("eEfFgGaA", conv) && !longCnt && !isSize) {
+        argClass = ARG_DOUBLE;
+    } else if ((conv == 'p') && !longCnt && !isSize) {
+        argClass = ARG_PTR;
+    } else if ((conv == 's') && !longCnt && !isSize) {
+        argClass = ARG_STR;
+    } else {
+        argClass = ARG_INVALID;
+    }
+    return p;
+}
+
+// Returns true if addr is in flash. It then stays valid for deferred rendering and can be read
+// from the ELF file by the host decoder.
+bool Log::IsConstAddr(void const *addr) {
+#if defined(FLASH_BASE) && defined(FLASH_END)
+    uintptr_t a = reinterpret_cast<uintptr_t>(addr);
+    return (a >= FLASH_BASE) && (a <= FLASH_END);
+#else
+    (void)addr;
+    return false;
+#endif
+}
+#endif // FW_LOG_BIN
+
 // Must allow HSM_UNDEF since the "m_from" hsmn of an event is optional
 // (e.g. an internal event or event sent from main).
 char const *Log::GetHsmName(Hsmn hsmn) {
@@ -0,0 +1,275 @@
+/*******************************************************************************
+ * Copyright (C) Gallium Studio LLC. All rights reserved.
+ *
+ * This program is open source software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Alternatively, this program may be distributed and modified under the
+ * terms of Gallium Studio LLC commercial licenses, which expressly supersede
+ * the GNU General Public License and are specifically designed for licensees
+ * interested in retaining the proprietary status of their code.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * Contact information:
+ * Website - https://www.galliumstudio.com
+ * Source repository - https://github.com/galliumstudio
+ * Email - admin@galliumstudio.com
+ ******************************************************************************/
+
+#include <string.h>
+#include "qpcpp.h"
+#include "fw_prof.h"
+#include "fw_macro.h"
+#include "fw_timer.h"
+#include "fw_log.h"
+#include "fw.h"
+#include "fw_assert.h"
+#ifdef __arm__
+#include "bsp.h"
+#else
+#include <time.h>
+#endif
+
+FW_DEFINE_THIS_FILE("fw_prof.cpp")
+
+using namespace QP;
+
+namespace FW {
+
+uint32_t Prof::m_overflowCnt;
+uint32_t Prof::m_warnPercent;
+
+#if FW_PROF
+
+Prof::Entry Prof::m_entry[ENTRY_COUNT];
+Prof::Queue Prof::m_queue[QF_MAX_ACTIVE + 1];
+
+// Enables DWT cycle counter on target.
+void Prof::Init() {
+#ifdef __arm__
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+    Reset();
+}
+
+uint32_t Prof::GetTime() {
+#ifdef __arm__
+    return DWT->CYCCNT;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint32_t>(ts.tv_sec * 1000000000ULL + ts.tv_nsec);
+#endif
+}
+
+// Elapsed time is computed with unsigned wraparound, so it is correct for durations less than 2^32 units.
+// The slot is looked up outside critical section with at most MAX_PROBE probes. It is safe since a used
+// entry is only released by Reset(), and the slot is checked again in critical section before it is
+// updated. If another (HSM, signal) has taken the free slot in between, the dispatch is counted as not
+// recorded.
+void Prof::Record(Hsmn hsmn, QSignal sig, uint32_t startTime) {
+    uint32_t time = GetTime() - startTime;
+    uint32_t bucket = GetBucket(time);
+    // Fibonacci hashing of (hsmn, signal).
+    uint32_t key = (static_cast<uint32_t>(hsmn) << 16) | sig;
+    uint32_t index = static_cast<uint32_t>(key * 2654435761U) >> (32 - ENTRY_ORDER);
+    uint32_t i = 0;
+    for (; i < MAX_PROBE; i++) {
+        Entry const &entry = m_entry[index];
+        if ((entry.m_hsmn == HSM_UNDEF) || ((entry.m_hsmn == hsmn) && (entry.m_sig == sig))) {
+            break;
+        }
+        index = (index + 1) & (ENTRY_COUNT - 1);
+    }
+    QF_CRIT_STAT_TYPE crit;
+    QF_CRIT_ENTRY(crit);
+    if (i < MAX_PROBE) {
+        Entry &entry = m_entry[index];
+        if (entry.m_hsmn == HSM_UNDEF) {
+            entry.m_hsmn = hsmn;
+            entry.m_sig = sig;
+        }
+        if ((entry.m_hsmn == hsmn) && (entry.m_sig == sig)) {
+            entry.m_count++;
+            entry.m_min = LESS(entry.m_min, time);
+            entry.m_max = GREATER(entry.m_max, time);
+            entry.m_total += time;
+            if (entry.m_hist[bucket] < 0xFFFF) {
+                entry.m_hist[bucket]++;
+            }
+            QF_CRIT_EXIT(crit);
+            return;
+        }
+    }
+    m_overflowCnt++;
+    QF_CRIT_EXIT(crit);
+}
+
+// Called by active object or thread when it takes event e from its event queue, which has nFree
+// free entries left.
+void Prof::RecordLatency(uint8_t prio, QEvt const *e, uint32_t nFree) {
+    FW_ASSERT(prio <= QF_MAX_ACTIVE);
+    uint32_t now = GetTime();
+    uint32_t postTime;
+    bool hasTime = true;
+    if (IS_TIMER_EVT(e->sig)) {
+        postTime = static_cast<Timer const *>(e)->GetPostTime();
+    } else {
+        hasTime = Fw::GetPostTime(e, postTime);
+    }
+    Queue &queue = m_queue[prio];
+    bool warn = false;
+    uint32_t used = 0;
+    QF_CRIT_STAT_TYPE crit;
+    QF_CRIT_ENTRY(crit);
+    if (hasTime) {
+        uint32_t time = now - postTime;
+        queue.m_count++;
+        queue.m_max = GREATER(queue.m_max, time);
+        queue.m_total += time;
+        uint32_t bucket = GetBucket(time);
+        if (queue.m_hist[bucket] < 0xFFFF) {
+            queue.m_hist[bucket]++;
+        }
+    }
+    // Warns once when going above threshold, and rearms when dropping below half of it.
+    if (m_warnPercent && queue.m_capacity && (nFree <= queue.m_capacity)) {
+        used = queue.m_capacity - nFree;
+        if (!queue.m_warned && ((used * 100) >= (m_warnPercent * queue.m_capacity))) {
+            queue.m_warned = true;
+            warn = true;
+        } else if (queue.m_warned && ((used * 200) < (m_warnPercent * queue.m_capacity))) {
+            queue.m_warned = false;
+        }
+    }
+    QF_CRIT_EXIT(crit);
+    if (warn) {
+        Log::Print(HSM_UNDEF, "WARNING: event queue of %s (prio %u) at %lu/%u\n\r",
+                   Log::GetHsmName(queue.m_hsmn), prio, used, queue.m_capacity);
+    }
+}
+
+void Prof::AddQueue(uint8_t prio, Hsmn hsmn, uint32_t capacity) {
+    FW_ASSERT((prio <= QF_MAX_ACTIVE) && (capacity <= 0xFFFF));
+    QF_CRIT_STAT_TYPE crit;
+    QF_CRIT_ENTRY(crit);
+    m_queue[prio].m_hsmn = hsmn;
+    m_queue[prio].m_capacity = capacity;
+    QF_CRIT_EXIT(crit);
+}
+
+// Resets both dispatch profile and queueing latency.
+void Prof::Reset() {
+    QF_CRIT_STAT_TYPE crit;
+    QF_CRIT_ENTRY(crit);
+    memset(m_entry, 0, sizeof(m_entry));
+    for (uint32_t i = 0; i < ENTRY_COUNT; i++) {
+        m_entry[i].m_min = 0xFFFFFFFF;
+    }
+    m_overflowCnt = 0;
+    QF_CRIT_EXIT(crit);
+    ResetQueue();
+}
+
+// Resets queueing latency only.
+// Event queue high-water marks are kept by QEQueue and cannot be reset.
+void Prof::ResetQueue() {
+    QF_CRIT_STAT_TYPE crit;
+    QF_CRIT_ENTRY(crit);
+    for (uint32_t i = 0; i <= QF_MAX_ACTIVE; i++) {
+        Queue &queue = m_queue[i];
+        queue.m_count = 0;
+        queue.m_max = 0;
+        queue.m_total = 0;
+        memset(queue.m_hist, 0, sizeof(queue.m_hist));
+    }
+    QF_CRIT_EXIT(crit);
+}
+
+// Returns false if the entry at index is unused.
+bool Prof::GetEntry(uint32_t index, Entry &entry) {
+    FW_ASSERT(index < ENTRY_COUNT);
+    QF_CRIT_STAT_TYPE crit;
+    QF_CRIT_ENTRY(crit);
+    entry = m_entry[index];
+    QF_CRIT_EXIT(crit);
+    return entry.m_hsmn != HSM_UNDEF;
+}
+
+// Returns false if no active object or thread has been added at prio.
+bool Prof::GetQueue(uint8_t prio, Queue &queue) {
+    FW_ASSERT(prio <= QF_MAX_ACTIVE);
+    QF_CRIT_STAT_TYPE crit;
+    QF_CRIT_ENTRY(crit);
+    queue = m_queue[prio];
+    QF_CRIT_EXIT(crit);
+    return queue.m_capacity != 0;
+}
+
+uint32_t Prof::GetBucket(uint32_t time) {
+    uint32_t order = (time == 0) ? 0 : (31 - __builtin_clz(time));
+    return (order <= HIST_MIN_ORDER) ? 0 : LESS(order - HIST_MIN_ORDER, HIST_COUNT - 1);
+}
+
+#else
+
+void Prof::Init() {
+}
+
+void Prof::Reset() {
+}
+
+void Prof::ResetQueue() {
+}
+
+bool Prof::GetEntry(uint32_t index, Entry &entry) {
+    (void)index;
+    (void)entry;
+    return false;
+}
+
+void Prof::AddQueue(uint8_t prio, Hsmn hsmn, uint32_t capacity) {
+    (void)prio;
+    (void)hsmn;
+    (void)capacity;
+}
+
+bool Prof::GetQueue(uint8_t prio, Queue &queue) {
+    (void)prio;
+    (void)queue;
+    return false;
+}
+
+#endif // FW_PROF
+
+char const *Prof::GetUnit() {
+#ifdef __arm__
+    return "cycles";
+#else
+    return "ns";
+#endif
+}
+
+} // namespace FW
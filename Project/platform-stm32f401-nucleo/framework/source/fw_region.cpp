@@ -39,7 +39,10 @@
 #include "qpcpp.h"
 #include "fw_region.h"
 #include "fw_active.h"
+#include "fw_mactive.h"
 #include "fw_xthread.h"
+#include "fw_prof.h"
+#include "fw.h"
 #include "fw_assert.h"
 
 FW_DEFINE_THIS_FILE("fw_region.cpp")
@@ -56,6 +59,14 @@ void Region::Init(Active *container) {
     QHsm::init();
 }
 
+void Region::Init(MActive *container) {
+    FW_ASSERT(container);
+    m_container = container;
+    container->Add(this);
+    m_hsm.Init(container);
+    QHsm::init();
+}
+
 void Region::Init(XThread *container) {
     FW_ASSERT(container);
     m_container = container;
@@ -68,13 +79,17 @@ void Region::dispatch(QEvt const * const e) {
     // For region, e can be from the container active object's event queue (dynamic or static/timer),
     // or be a static event on the stack of the container active object.
     // Garbage collection, if needed, is done by the caller.
+    // Regions of both Active and XThread are profiled here.
+    uint32_t startTime = Prof::GetTime();
     QHsm::dispatch(e);
     // Handle all reminder events generated as a result of e.
     m_hsm.DispatchReminder();
+    Prof::Record(m_hsm.GetHsmn(), e->sig, startTime);
 }
 
 void Region::PostSync(Evt const *e) {
     FW_ASSERT(e && m_container);
+    Fw::SetPostTime(e);
     m_container->postLIFO(e);
 }
 
@@ -40,6 +40,7 @@
 #include "qpcpp.h"
 #include "fw_active.h"
 #include "fw_timer.h"
+#include "fw_prof.h"
 #include "fw_inline.h"
 #include "fw_assert.h"
 
@@ -49,84 +50,262 @@ using namespace QP;
 
 namespace FW {
 
-// The timer signal is set to Q_USER_SIG which is associated with an undefined HSM.
-// It will be discarded by Active::dispatch().
-// The signal is set to Q_USER_SIG in case the QTimeEvt constructor asserts (signal >= Q_USER_SIG).
-Timer const CANCELED_TIMER(HSM_UNDEF, Q_USER_SIG);
+#if FW_TIMER_WHEEL
+Timer *Timer::m_wheel[WHEEL_LEVEL_COUNT][WHEEL_SLOT_COUNT];
+uint64_t Timer::m_wheelBusy[WHEEL_LEVEL_COUNT];
+Timer *Timer::m_wheelExpiring;
+uint32_t Timer::m_wheelTick;
+#endif
 
 // Allow hsmn == HSM_UNDEF. In that case GetContainer() returns NULL.
 Timer::Timer(Hsmn hsmn, QP::QSignal signal) :
     QTimeEvt(signal),
-    m_hsmn(hsmn) {
+    m_hsmn(hsmn),
+    m_queued(0),
+    m_stale(0),
+    m_postTime(0)
+#if FW_TIMER_WHEEL
+    , m_wheelNext(NULL), m_wheelPrevNext(NULL), m_wheelAct(NULL), m_wheelExpire(0), m_wheelInterval(0)
+#endif
+{
 }
 
 void Timer::Start(uint32_t timeoutMs, Type type) {
     QTimeEvtCtr timeoutTick = ROUND_UP_DIV(timeoutMs, BSP_MSEC_PER_TICK);
     QActive *act = Fw::GetContainer(m_hsmn);
     FW_ASSERT(act && (type < INVALID));
+#if FW_TIMER_WHEEL
+    FW_ASSERT((timeoutTick > 0) && (timeoutTick < WHEEL_MAX_TICK));
+    QF_CRIT_STAT_TYPE crit;
+    QF_CRIT_ENTRY(crit);
+    // Same as QTimeEvt::armX(), a timer must not be started when it is already armed.
+    FW_ASSERT(!IsWheelArmed());
+    m_wheelAct = act;
+    m_wheelExpire = m_wheelTick + timeoutTick - 1;
+    m_wheelInterval = (type == ONCE) ? 0 : timeoutTick;
+    WheelAdd();
+    QF_CRIT_EXIT(crit);
+#else
     if (type == ONCE) {
         QTimeEvt::postIn(act, timeoutTick);
     } else {
         QTimeEvt::postEvery(act, timeoutTick);
     }
+#endif
 }
 
+// Rather than removing timeout events already in the event queue, they are marked stale by
+// counting them, so the critical section does not depend on the queue depth.
+// A periodic timer may have more than one timeout event in the queue.
 void Timer::Stop() {
-    // Doesn't care what disarm returns. For a periodic timer, even when it is still armed
-    // a previous timeout event might still be in event queue and must be removed.
-    // In any cases we need to purge residue timer events in event queue.
+    QF_CRIT_STAT_TYPE crit;
+    QF_CRIT_ENTRY(crit);
+#if FW_TIMER_WHEEL
+    if (IsWheelArmed()) {
+        WheelUnlink();
+    }
+#else
+    // Doesn't care what disarm returns. Critical section must support nesting.
     QTimeEvt::disarm();
-    QActive *act = Fw::GetContainer(m_hsmn);
-    FW_ASSERT(act);
-    QEQueue *eQueue = &act->m_eQueue;
-    FW_ASSERT(eQueue);
-    QEQueueCtr queueCount = 0;
-    QEvt const **queueStor = eQueue->getStor(&queueCount);
-    FW_ASSERT(queueStor && queueCount);
-    // Critical section must support nesting.
+#endif
+    m_stale = m_queued;
+    QF_CRIT_EXIT(crit);
+}
+
+void Timer::Restart(uint32_t timeoutMs, Type type) {
+    Stop();
+    Start(timeoutMs, type);
+}
+
+// Returns false if e is a stale timeout event of a stopped timer, which must be discarded.
+// Since events are queued in FIFO order, the stale ones are always the oldest.
+bool Timer::IsValid(QEvt const *e) {
+    FW_ASSERT(e && IS_TIMER_EVT(e->sig));
+    // Timer events are static, so casting away const is safe.
+    Timer *timer = static_cast<Timer *>(const_cast<QEvt *>(e));
+    bool valid = true;
+    QF_CRIT_STAT_TYPE crit;
+    QF_CRIT_ENTRY(crit);
+    FW_ASSERT(timer->m_queued);
+    timer->m_queued--;
+    if (timer->m_stale) {
+        timer->m_stale--;
+        valid = false;
+    }
+    QF_CRIT_EXIT(crit);
+    return valid;
+}
+
+// Must be called within critical section.
+void Timer::OnPost() {
+    FW_ASSERT(m_queued < 0xFF);
+    m_queued++;
+    m_postTime = Prof::GetTime();
+}
+
+#if FW_TIMER_WHEEL
+
+// Timers in the level-0 slot of the current tick are moved to m_wheelExpiring and posted one at
+// a time, with the critical section released around each post. A timer stopped in the meantime
+// simply unlinks itself from m_wheelExpiring.
+// When the level-0 index wraps around, the next slot of level 1 is redistributed to lower levels,
+// and so on for higher levels (cascading).
+void Timer::Tick() {
+    QF_CRIT_STAT_TYPE crit;
+    QF_CRIT_ENTRY(crit);
+    uint32_t index = m_wheelTick & WHEEL_SLOT_MASK;
+    for (uint32_t level = 1; (index == 0) && (level < WHEEL_LEVEL_COUNT); level++) {
+        index = (m_wheelTick >> (level * WHEEL_SLOT_ORDER)) & WHEEL_SLOT_MASK;
+        WheelCascade(level);
+    }
+    index = m_wheelTick & WHEEL_SLOT_MASK;
+    FW_ASSERT(m_wheelExpiring == NULL);
+    Timer *t = m_wheel[0][index];
+    if (t) {
+        m_wheel[0][index] = NULL;
+        WheelClearBusy(0, index);
+        m_wheelExpiring = t;
+        t->m_wheelPrevNext = &m_wheelExpiring;
+    }
+    m_wheelTick++;
+    while ((t = m_wheelExpiring) != NULL) {
+        t->WheelUnlink();
+        QActive *act = t->m_wheelAct;
+        t->OnPost();
+        if (t->m_wheelInterval) {
+            t->m_wheelExpire += t->m_wheelInterval;
+            t->WheelAdd();
+        }
+        QF_CRIT_EXIT(crit);
+        (void)act->POST(t, &m_wheelTick);   // asserts if queue overflows
+        QF_CRIT_ENTRY(crit);
+    }
+    QF_CRIT_EXIT(crit);
+}
+
+// Only the first non-empty slot of each level, found with m_wheelBusy, is walked, since a timer in a
+// later slot of the same level expires after all timers in that slot. The time spent in the critical
+// section is therefore bounded by the number of timers in those slots rather than all armed timers.
+// On level 0 the slots are in expiry order starting from the current one. On a higher level the
+// current slot is last, since it has already been cascaded unless the lower levels have just wrapped
+// around (i.e. it is to be cascaded in the next tick).
+uint32_t Timer::GetIdleTicks(uint32_t maxTicks) {
+    uint32_t idleTicks = maxTicks;
     QF_CRIT_STAT_TYPE crit;
     QF_CRIT_ENTRY(crit);
-    // Remove timer event in front of queue.
-    QEvt const * frontEvt = eQueue->get();
-    if (frontEvt) {
-        // Check if a queued event matches the timer event being stopped.
-        if (IsMatch(frontEvt)) {
-            // frontEvt must be a timer event and static.
-            FW_ASSERT(IS_TIMER_EVT(frontEvt->sig) && QF_EVT_POOL_ID_(frontEvt) == 0);
-            frontEvt = &CANCELED_TIMER;
+    for (uint32_t level = 0; level < WHEEL_LEVEL_COUNT; level++) {
+        uint64_t busy = m_wheelBusy[level];
+        if (busy == 0) {
+            continue;
         }
-        // Put back front event.
-        eQueue->postLIFO(frontEvt);
-        // Since QEQueue::get() does not decrement reference counter, we need to
-        // decrement it explicitly after postLIFO() increments it again.
-        // We must only do it for dynamic events.
-        if (QF_EVT_POOL_ID_(frontEvt) != 0) {
-            FW_ASSERT(QF_EVT_REF_CTR_(frontEvt) > 1);
-            QF_EVT_REF_CTR_DEC_(frontEvt);
+        uint32_t shift = level * WHEEL_SLOT_ORDER;
+        uint32_t start = (m_wheelTick >> shift) & WHEEL_SLOT_MASK;
+        if (level && (m_wheelTick & BIT_MASK_OF_SIZE(shift))) {
+            start = (start + 1) & WHEEL_SLOT_MASK;
         }
-        // Remove timer event in queue storage if it is used.
-        // Note queueCount does NOT include frontEvt while getNFree() does include frontEvt.
-        // Since here frontEvt must be used, max of getNFree() is queueCount.
-        // If getNFree() < queueCount, one or more of queue storage must be in use.
-        // If a match is found, it is replaced with CANCELED_TIMER regardless to whether
-        // it is actually being used of not.
-        if (eQueue->getNFree() < queueCount) {
-            for (QEQueueCtr i = 0; i < queueCount; i++) {
-                if (IsMatch(queueStor[i])) {
-                    // Matched event must be a timer event and static.
-                    FW_ASSERT(IS_TIMER_EVT(queueStor[i]->sig) && QF_EVT_POOL_ID_(queueStor[i]) == 0);
-                    queueStor[i] = &CANCELED_TIMER;
-                }
-            }
+        // Rotates busy so that bit 0 is for the start slot.
+        if (start) {
+            busy = (busy >> start) | (busy << (WHEEL_SLOT_COUNT - start));
+        }
+        uint32_t index = (start + __builtin_ctzll(busy)) & WHEEL_SLOT_MASK;
+        for (Timer *t = m_wheel[level][index]; t; t = t->m_wheelNext) {
+            idleTicks = LESS(idleTicks, t->m_wheelExpire - m_wheelTick + 1);
         }
     }
-    // Nothing to do if queue empty (frontEvt == NULL).
     QF_CRIT_EXIT(crit);
+    return idleTicks;
 }
 
-void Timer::Restart(uint32_t timeoutMs, Type type) {
-    Stop();
-    Start(timeoutMs, type);
+// No timer expires within the skipped ticks, so this only advances the wheel and cascades.
+void Timer::Skip(uint32_t ticks) {
+    while (ticks--) {
+        Tick();
+    }
+}
+
+// Must be called within critical section.
+void Timer::WheelLink(Timer **head) {
+    m_wheelNext = *head;
+    if (m_wheelNext) {
+        m_wheelNext->m_wheelPrevNext = &m_wheelNext;
+    }
+    *head = this;
+    m_wheelPrevNext = head;
+}
+
+// Must be called within critical section.
+// If the timer is the only one in a wheel slot, the slot is marked empty.
+void Timer::WheelUnlink() {
+    *m_wheelPrevNext = m_wheelNext;
+    if (m_wheelNext) {
+        m_wheelNext->m_wheelPrevNext = m_wheelPrevNext;
+    } else {
+        uint32_t slot = m_wheelPrevNext - &m_wheel[0][0];
+        if ((slot < (WHEEL_LEVEL_COUNT * WHEEL_SLOT_COUNT)) && (*m_wheelPrevNext == NULL)) {
+            WheelClearBusy(slot >> WHEEL_SLOT_ORDER, slot & WHEEL_SLOT_MASK);
+        }
+    }
+    m_wheelNext = NULL;
+    m_wheelPrevNext = NULL;
+}
+
+// Must be called within critical section.
+// Places timer in the lowest level whose range covers the remaining ticks to expiry.
+void Timer::WheelAdd() {
+    uint32_t delta = m_wheelExpire - m_wheelTick;
+    uint32_t level = 0;
+    // A delta wrapped around (> WHEEL_MAX_TICK) means it has already expired. Place it in the current slot.
+    if (delta >= WHEEL_MAX_TICK) {
+        m_wheelExpire = m_wheelTick;
+    } else {
+        while (delta >= (1UL << ((level + 1) * WHEEL_SLOT_ORDER))) {
+            level++;
+        }
+    }
+    uint32_t index = (m_wheelExpire >> (level * WHEEL_SLOT_ORDER)) & WHEEL_SLOT_MASK;
+    WheelLink(&m_wheel[level][index]);
+    WheelSetBusy(level, index);
+}
+
+// Must be called within critical section.
+// Moves all timers in the current slot of a level down to lower levels.
+void Timer::WheelCascade(uint32_t level) {
+    uint32_t index = (m_wheelTick >> (level * WHEEL_SLOT_ORDER)) & WHEEL_SLOT_MASK;
+    Timer *t = m_wheel[level][index];
+    m_wheel[level][index] = NULL;
+    WheelClearBusy(level, index);
+    while (t) {
+        Timer *next = t->m_wheelNext;
+        t->m_wheelNext = NULL;
+        t->m_wheelPrevNext = NULL;
+        t->WheelAdd();
+        t = next;
+    }
+}
+
+#else
+
+void Timer::Tick() {
 }
 
+uint32_t Timer::GetIdleTicks(uint32_t maxTicks) {
+    (void)maxTicks;
+    return 0;
+}
+
+void Timer::Skip(uint32_t ticks) {
+    (void)ticks;
+}
+
+#endif // FW_TIMER_WHEEL
+
 } // namespace FW
+
+// Callback from QF::tickX_() within critical section. Time events with an undefined HSM in their
+// signals are internal to QP (e.g. QXThread timeouts) and are not FW::Timer objects.
+void QF::onTimeEvtPost(QTimeEvt *t) {
+    using namespace FW;
+    if (IS_EVT_HSMN_VALID(t->sig) && IS_TIMER_EVT(t->sig)) {
+        static_cast<Timer *>(t)->OnPost();
+    }
+}
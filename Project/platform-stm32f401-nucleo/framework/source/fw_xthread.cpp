@@ -39,8 +39,10 @@
 #include "qpcpp.h"
 #include "fw_xthread.h"
 #include "fw_region.h"
+#include "fw_mregion.h"
 #include "fw_evt.h"
 #include "fw_timer.h"
+#include "fw_prof.h"
 #include "fw.h"
 #include "fw_assert.h"
 
@@ -55,42 +57,81 @@ void XThread::Start(uint8_t prio) {
     // It allows an HSM/region to be registered to the framework (via its Init() method) before an event
     // is posted to it (which may happen right after this Start() function returns).
     OnRun();
+    // Event queue capacity includes the front event.
+    Prof::AddQueue(prio, HSM_UNDEF, ARRAY_COUNT(m_evtQueueStor) + 1);
     start(prio, m_evtQueueStor, ARRAY_COUNT(m_evtQueueStor), m_stackSto, sizeof(m_stackSto));
 }
 
 void XThread::Add(Region *reg) {
     FW_ASSERT(reg);
-    Hsmn regHsmn = reg->GetHsm().GetHsmn();
+    AddRegion(reg->GetHsm(), reg);
+}
+
+void XThread::Add(MRegion *reg) {
+    FW_ASSERT(reg);
+    AddRegion(reg->GetHsm(), reg);
+}
+
+void XThread::AddRegion(Hsm &hsm, QHsm *reg) {
+    Hsmn regHsmn = hsm.GetHsmn();
     FW_ASSERT(regHsmn != HSM_UNDEF);
-    HsmnReg *existing = m_hsmnRegMap.GetByKey(regHsmn);
-    FW_ASSERT(existing == NULL);
-    m_hsmnRegMap.Save(HsmnReg(regHsmn, reg));
-    Fw::Add(regHsmn, &reg->GetHsm(), this);
+    FW_ASSERT(m_hsmnRegTable.Get(regHsmn) == NULL);
+    m_hsmnRegTable.Add(regHsmn, reg);
+    Fw::Add(regHsmn, &hsm, this);
 }
 
 void XThread::Dispatch(QEvt const * const e) {
     Hsmn hsmn;
     // Discard event if it is sent to an undefined HSM.
-    // This happens when a timer event already posted is canceled.
+    // This happens to internal time events of QP.
     if (!IS_EVT_HSMN_VALID(e->sig)) {
         return;
     }
     if (IS_TIMER_EVT(e->sig)) {
+        // Discard timeout event posted before its timer was stopped.
+        if (!Timer::IsValid(e)) {
+            return;
+        }
         Timer const *timerEvt = static_cast<Timer const *>(e);
         hsmn = timerEvt->GetHsmn();
     } else {
         Evt const *evt = static_cast<Evt const *>(e);
         hsmn = evt->GetTo();
     }
-    HsmnReg *hsmnReg = m_hsmnRegMap.GetByKey(hsmn);
-    if (hsmnReg && hsmnReg->GetValue()) {
-        hsmnReg->GetValue()->dispatch(e);
+    Prof::RecordLatency(getPrio(), e, m_eQueue.getNFree());
+    if (hsmn == HSM_UNDEF) {
+        // Published event. Dispatch to each subscriber in this thread. See Fw::Publish().
+        Fw::HsmnSet subscr = Fw::GetSubscriber(e->sig, this);
+        for (uint32_t i = 0; subscr; i++) {
+            Fw::HsmnSet bit = static_cast<Fw::HsmnSet>(1) << i;
+            if (subscr & bit) {
+                subscr &= ~bit;
+                DispatchTo(i, e);
+            }
+        }
+    } else {
+        DispatchTo(hsmn, e);
+    }
+}
+
+void XThread::DispatchTo(Hsmn hsmn, QEvt const * const e) {
+    QHsm *reg = m_hsmnRegTable.Get(hsmn);
+    if (reg) {
+        reg->dispatch(e);
     }
 }
 
 void XThread::PostSync(Evt const *e) {
     FW_ASSERT(e);
+    Fw::SetPostTime(e);
     postLIFO(e);
 }
 
+// Publishes e (sent to HSM_UNDEF) to the subscribers within this container only. Like PostSync(), e is
+// dispatched before any other event in the queue. Subscribers in other containers do not receive it.
+void XThread::PublishSync(Evt const *e) {
+    FW_ASSERT(e && (e->GetTo() == HSM_UNDEF));
+    PostSync(e);
+}
+
 }
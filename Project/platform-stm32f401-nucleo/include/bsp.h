@@ -50,6 +50,15 @@
 #define BSP_MSEC_PER_TICK            (1000 / BSP_TICKS_PER_SEC)
 #define BSP_MSEC_TO_TICK(ms_)        ((ms_) / BSP_MSEC_PER_TICK)
 
+// Set ENABLE_TICKLESS_IDLE to 1 (e.g. in compiler options, together with FW_TIMER_WHEEL=1) to enable
+// tickless idle. When the system is idle, SysTick is reprogrammed to wake up at the next FW::Timer
+// expiry and the skipped ticks are accounted for on wakeup. The next expiry is only known with the
+// timing wheel, so FW_TIMER_WHEEL must be set as well (see fw_timer.h). See BspTicklessSleep().
+// Since WFI is used, see the caution about debugger connection in QXK::onIdle().
+#ifndef ENABLE_TICKLESS_IDLE
+#define ENABLE_TICKLESS_IDLE 0
+#endif
+
 enum KernelUnawareISRs { // see NOTE00
     // ...
     MAX_KERNEL_UNAWARE_CMSIS_PRI  // keep always last
@@ -91,5 +100,8 @@ void BspInit();
 void BspWrite(char const *buf, uint32_t len);
 uint32_t GetSystemMs();
 uint32_t GetIdleCnt();
+#if ENABLE_TICKLESS_IDLE
+uint32_t BspTicklessSleep();
+#endif
 
 #endif // BSP_H
@@ -253,12 +253,6 @@ public:
         return m_frontEvt == static_cast<QEvt const *>(0);
     }
 
-    // Gallium - Added for use by FW::Timer.
-    QEvt const **getStor(QEQueueCtr *count) {
-        if (count) { *count = m_end; }
-        return m_ring;
-    }
-
 private:
     //! disallow copying of QEQueue
     QEQueue(QEQueue const &);
@@ -582,6 +582,13 @@ public:
     //! Recycle a dynamic event.
     static void gc(QEvt const *e);
 
+    // Gallium - Added callback before a dynamic event is recycled. Used by FW for event pool statistics.
+    static void onGc(QEvt const *e);
+
+    // Gallium - Added callback within critical section before tickX_() posts a time event.
+    // Used by FW::Timer to count timeout events in event queues.
+    static void onTimeEvtPost(QTimeEvt *t);
+
     //! Internal QF implementation of creating new event reference.
     static QEvt const *newRef_(QEvt const * const e,
                                QEvt const * const evtRef);
@@ -235,6 +235,8 @@ void QF::gc(QEvt const * const e) {
             // pool ID must be in range
             Q_ASSERT_ID(410, idx < QF_maxPool_);
 
+            onGc(e); // Gallium - Added for event pool statistics.
+
 #ifdef Q_EVT_VIRTUAL
             // explicitly exectute the destructor'
             // NOTE: casting 'const' away is legitimate,
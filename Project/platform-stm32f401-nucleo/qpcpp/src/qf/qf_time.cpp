@@ -159,6 +159,8 @@ void QF::tickX_(uint_fast8_t const tickRate, void const * const sender)
                     QS_U8_(static_cast<uint8_t>(tickRate)); // tick rate
                 QS_END_NOCRIT_()
 
+                onTimeEvtPost(t); // Gallium - Added for FW::Timer.
+
                 QF_CRIT_EXIT_(); // exit crit. section before posting
 
                 (void)act->POST(t, sender); // asserts if queue overflows
@@ -113,17 +113,18 @@ static CmdStatus PostEvt(Console &console, Evt const *e) {
 }
 
 static CmdStatus List(Console &console, Evt const *e);
-static CmdHandler const cmdHandler[] = {
-    { "test",    Test,       "Test function", 0 },
-    { "o",       PostEvt,    "Opens the door", 0 },
+static constexpr CmdHandler cmdHandler[] = {
+    { "?",       List,       "List commands", 0 },
+    { "b",       PostEvt,    "Select wash BULKY", 0 },
     { "c",       PostEvt,    "Closes the door", 0 },
-    { "s",       PostEvt,    "Start/Pause button", 0 },
-    { "n",       PostEvt,    "Select wash NORMAL", 0 },
     { "d",       PostEvt,    "Select wash DELICATE", 0 },
-    { "b",       PostEvt,    "Select wash BULKY", 0 },
+    { "n",       PostEvt,    "Select wash NORMAL", 0 },
+    { "o",       PostEvt,    "Opens the door", 0 },
+    { "s",       PostEvt,    "Start/Pause button", 0 },
     { "t",       PostEvt,    "Select wash TOWELS", 0 },
-    { "?",       List,       "List commands", 0 },
+    { "test",    Test,       "Test function", 0 },
 };
+CMD_TABLE_ASSERT(cmdHandler);
 
 static CmdStatus List(Console &console, Evt const *e) {
     return console.ListCmd(e, cmdHandler, ARRAY_COUNT(cmdHandler));
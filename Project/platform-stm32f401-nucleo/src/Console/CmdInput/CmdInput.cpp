@@ -196,6 +196,16 @@ QState CmdInput::Edit(CmdInput * const me, QEvt const * const e) {
                 Evt *evt = new Evt(UPDATE, GET_HSMN());
                 me->GetHsm().PostReminder(evt);
                 return Q_HANDLED();
+            } else if (c == TAB) {
+                char suffix[MAX_LEN];
+                me->m_console.CompleteCmd(me->m_cmdHistory.EditBuf().GetRawConst(), suffix, sizeof(suffix));
+                for (char const *p = suffix; *p && !me->m_cmdHistory.EditBuf().IsFull(); p++) {
+                    me->m_console.PutChar(*p);
+                    me->m_cmdHistory.EditBuf().Append(*p);
+                }
+                Evt *evt = new Evt(UPDATE, GET_HSMN());
+                me->GetHsm().PostReminder(evt);
+                return Q_HANDLED();
             } else if ((c == CR) || (c == LF)) {
                 me->m_console.PutStr(CR_LF);
                 return Q_TRAN(&CmdInput::CmdReady);
@@ -56,6 +56,11 @@ class Console;
 
 class CmdInput : public Region {
 public:
+    // Log is turned off in main(). Only ERROR, WARNING and CRITICAL are compiled.
+    enum {
+        LOG_CEILING = Log::TYPE_LOG
+    };
+
     enum {
         MAX_LEN = 64
     };
@@ -41,6 +41,7 @@
 #include "fw_assert.h"
 #include "CmdParserInterface.h"
 #include "CmdParser.h"
+#include "CmdTokenizer.h"
 
 FW_DEFINE_THIS_FILE("CmdParser.cpp")
 
@@ -52,11 +53,6 @@ static char const * const timerEvtName[] = {
 
 static char const * const internalEvtName[] = {
     "DONE",
-    "STEP",
-    "CH_DELIM",
-    "CH_QUOTE",
-    "CH_SLASH",
-    "CH_OTHER"
 };
 
 static char const * const interfaceEvtName[] = {
@@ -66,7 +62,6 @@ static char const * const interfaceEvtName[] = {
 
 CmdParser::CmdParser(Hsmn hsmn, char const *name) :
     Region((QStateHandler)&CmdParser::InitialPseudoState, hsmn, name),
-    m_cmdStr(NULL), m_argv(NULL), m_argc(0), m_maxArgc(0), m_index(-1),
     m_stateTimer(this->GetHsm().GetHsmn(), STATE_TIMER) {
     SET_EVT_NAME(CMD_PARSER);
 }
@@ -91,15 +86,9 @@ QState CmdParser::Root(CmdParser * const me, QEvt const * const e) {
         }
         case CMD_PARSER_START_REQ: {
             EVENT(e);
+            // The whole line is parsed in this run-to-completion step.
             CmdParserStartReq const &req = static_cast<CmdParserStartReq const &>(*e);
-            me->m_cmdStr = req.GetCmdStr();
-            me->m_argv = req.GetArgv();
-            me->m_argc = req.GetArgc();
-            me->m_maxArgc = req.GetMaxArgc();
-            me->m_index = -1;
-            *me->m_argc = 0;
-            Evt *evt = new Evt(STEP, GET_HSMN());
-            me->GetHsm().PostReminder(evt);
+            *req.GetArgc() = CmdTokenizer::Parse(req.GetCmdStr(), req.GetArgv(), req.GetMaxArgc());
             return Q_TRAN(&CmdParser::Started);
         }
     }
@@ -134,120 +123,10 @@ QState CmdParser::Started(CmdParser * const me, QEvt const * const e) {
             EVENT(e);
             return Q_TRAN(&CmdParser::Stopped);
         }
-        case Q_INIT_SIG: {
-            return Q_TRAN(&CmdParser::Delimiter);
-        }
-        case STEP: {
-            char ch = me->m_cmdStr[++me->m_index];
-            if ((*me->m_argc >= me->m_maxArgc) or (ch == 0)) {
-                Evt *evt = new Evt(DONE, GET_HSMN());
-                me->GetHsm().PostReminder(evt);
-            } else {
-                if (ch == SP || ch == TAB) {
-                    Evt *evt = new Evt(CH_DELIM, GET_HSMN());
-                    me->GetHsm().PostReminder(evt);
-                } else if (ch == QUOTE) {
-                    Evt *evt = new Evt(CH_QUOTE, GET_HSMN());
-                    me->GetHsm().PostReminder(evt);
-                } else if (ch == SLASH) {
-                    Evt *evt = new Evt(CH_SLASH, GET_HSMN());
-                    me->GetHsm().PostReminder(evt);
-                } else {
-                    Evt *evt = new Evt(CH_OTHER, GET_HSMN());
-                    me->GetHsm().PostReminder(evt);
-                }
-                Evt *evt = new Evt(STEP, GET_HSMN());
-                me->GetHsm().PostReminder(evt);
-            }
-            return Q_HANDLED();
-        }
     }
     return Q_SUPER(&CmdParser::Root);
 }
 
-QState CmdParser::Delimiter(CmdParser * const me, QEvt const * const e) {
-    switch (e->sig) {
-        case Q_ENTRY_SIG: {
-            EVENT(e);
-            return Q_HANDLED();
-        }
-        case Q_EXIT_SIG: {
-            EVENT(e);
-            return Q_HANDLED();
-        }
-        case CH_SLASH:
-        case CH_OTHER: {
-            return Q_TRAN(&CmdParser::SimpleArg);
-        }
-        case CH_QUOTE: {
-            return Q_TRAN(&CmdParser::QuotedArg);
-        }
-    }
-    return Q_SUPER(&CmdParser::Started);
-}
-
-QState CmdParser::SimpleArg(CmdParser * const me, QEvt const * const e) {
-    switch (e->sig) {
-        case Q_ENTRY_SIG: {
-            EVENT(e);
-            me->m_argv[(*me->m_argc)++] = &me->m_cmdStr[me->m_index];
-            return Q_HANDLED();
-        }
-        case CH_DELIM: {
-            me->m_cmdStr[me->m_index] = 0;
-            return Q_TRAN(&CmdParser::Delimiter);
-        }
-        case CH_QUOTE: {
-            me->m_cmdStr[me->m_index] = 0;
-            return Q_TRAN(&CmdParser::QuotedArg);
-        }
-        case Q_EXIT_SIG: {
-            EVENT(e);
-            return Q_HANDLED();
-        }
-    }
-    return Q_SUPER(&CmdParser::Started);
-}
-
-QState CmdParser::QuotedArg(CmdParser * const me, QEvt const * const e) {
-    switch (e->sig) {
-        case Q_ENTRY_SIG: {
-            EVENT(e);
-            me->m_argv[(*me->m_argc)++] = &me->m_cmdStr[me->m_index + 1];
-            return Q_HANDLED();
-        }
-        case Q_EXIT_SIG: {
-            EVENT(e);
-            return Q_HANDLED();
-        }
-        case CH_QUOTE: {
-            me->m_cmdStr[me->m_index] = 0;
-            return Q_TRAN(&CmdParser::Delimiter);
-        }
-        case CH_SLASH: {
-            if (me->m_cmdStr[me->m_index + 1]) {
-                me->m_index++;
-            }
-            return Q_HANDLED();
-        }
-    }
-    return Q_SUPER(&CmdParser::Started);
-}
-
-QState CmdParser::Done(CmdParser * const me, QEvt const * const e) {
-    switch (e->sig) {
-        case Q_ENTRY_SIG: {
-            EVENT(e);
-            return Q_HANDLED();
-        }
-        case Q_EXIT_SIG: {
-            EVENT(e);
-            return Q_HANDLED();
-        }
-    }
-    return Q_SUPER(&CmdParser::Started);
-}
-
 /*
 QState CmdParser::MyState(CmdParser * const me, QEvt const * const e) {
     switch (e->sig) {
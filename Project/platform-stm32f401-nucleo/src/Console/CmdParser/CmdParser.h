@@ -52,6 +52,11 @@ namespace APP {
 
 class CmdParser : public Region {
 public:
+    // Log is turned off in main(). Only ERROR, WARNING and CRITICAL are compiled.
+    enum {
+        LOG_CEILING = Log::TYPE_LOG
+    };
+
     CmdParser(Hsmn hsmn, char const *name);
 
 protected:
@@ -59,17 +64,6 @@ protected:
     static QState Root(CmdParser * const me, QEvt const * const e);
         static QState Stopped(CmdParser * const me, QEvt const * const e);
         static QState Started(CmdParser * const me, QEvt const * const e);
-            static QState Delimiter(CmdParser * const me, QEvt const * const e);
-            static QState SimpleArg(CmdParser * const me, QEvt const * const e);
-            static QState QuotedArg(CmdParser * const me, QEvt const * const e);
-            static QState Done(CmdParser * const me, QEvt const * const e);
-
-    char *m_cmdStr;     // Pointer to command string passed in via CMD_PARSER_START_REQ.
-                        // It will be modified by this object.
-    char const **m_argv;
-    uint32_t *m_argc;
-    uint32_t m_maxArgc;
-    int32_t m_index;    // Current index to m_cmdStr. Must be signed since it is initialized to -1.
 
     Timer m_stateTimer;
 
@@ -79,11 +73,6 @@ protected:
 
     enum {
         DONE = INTERNAL_EVT_START(CMD_PARSER),
-        STEP,
-        CH_DELIM,
-        CH_QUOTE,
-        CH_SLASH,
-        CH_OTHER,
     };
 };
 
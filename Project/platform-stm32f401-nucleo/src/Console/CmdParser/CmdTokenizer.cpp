@@ -0,0 +1,121 @@
+/*******************************************************************************
+ * Copyright (C) Gallium Studio LLC. All rights reserved.
+ *
+ * This program is open source software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Alternatively, this program may be distributed and modified under the
+ * terms of Gallium Studio LLC commercial licenses, which expressly supersede
+ * the GNU General Public License and are specifically designed for licensees
+ * interested in retaining the proprietary status of their code.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * Contact information:
+ * Website - https://www.galliumstudio.com
+ * Source repository - https://github.com/galliumstudio
+ * Email - admin@galliumstudio.com
+ ******************************************************************************/
+
+#include "qpcpp.h"
+#include "fw_assert.h"
+#include "CmdTokenizer.h"
+
+FW_DEFINE_THIS_FILE("CmdTokenizer.cpp")
+
+namespace APP {
+
+// Indexed by current state and class of the current character.
+CmdTokenizer::Transition const CmdTokenizer::m_transition[TOKEN_STATE_COUNT][CLASS_COUNT] = {
+    // TOKEN_DELIM
+    {
+        { TOKEN_DELIM,  ACTION_NONE },                  // CLASS_DELIM
+        { TOKEN_QUOTED, ACTION_START_QUOTED },          // CLASS_QUOTE
+        { TOKEN_SIMPLE, ACTION_START },                 // CLASS_SLASH
+        { TOKEN_SIMPLE, ACTION_START },                 // CLASS_OTHER
+    },
+    // TOKEN_SIMPLE
+    {
+        { TOKEN_DELIM,  ACTION_END },                   // CLASS_DELIM
+        { TOKEN_QUOTED, ACTION_END_START_QUOTED },      // CLASS_QUOTE
+        { TOKEN_SIMPLE, ACTION_NONE },                  // CLASS_SLASH
+        { TOKEN_SIMPLE, ACTION_NONE },                  // CLASS_OTHER
+    },
+    // TOKEN_QUOTED
+    {
+        { TOKEN_QUOTED, ACTION_NONE },                  // CLASS_DELIM
+        { TOKEN_DELIM,  ACTION_END },                   // CLASS_QUOTE
+        { TOKEN_QUOTED, ACTION_ESCAPE },                // CLASS_SLASH
+        { TOKEN_QUOTED, ACTION_NONE },                  // CLASS_OTHER
+    },
+};
+
+// Splits cmdStr into arguments in place and returns the number of them (argc). Arguments are separated by
+// spaces or tabs. A quoted argument may contain delimiters, and a quote in it may be escaped by a backslash,
+// which is kept. Parsing stops when maxArgc arguments have been found, leaving the rest of the string in the
+// last argument. cmdStr is modified by inserting terminators.
+uint32_t CmdTokenizer::Parse(char *cmdStr, char const **argv, uint32_t maxArgc) {
+    FW_ASSERT(cmdStr && argv);
+    uint32_t argc = 0;
+    uint8_t state = TOKEN_DELIM;
+    for (uint32_t i = 0; (argc < maxArgc) && cmdStr[i]; i++) {
+        char ch = cmdStr[i];
+        uint32_t charClass = CLASS_OTHER;
+        if ((ch == ' ') || (ch == '\t')) {
+            charClass = CLASS_DELIM;
+        } else if (ch == '"') {
+            charClass = CLASS_QUOTE;
+        } else if (ch == '\\') {
+            charClass = CLASS_SLASH;
+        }
+        Transition const &t = m_transition[state][charClass];
+        switch (t.m_action) {
+            case ACTION_START: {
+                argv[argc++] = &cmdStr[i];
+                break;
+            }
+            case ACTION_END_START_QUOTED: {
+                cmdStr[i] = 0;
+                argv[argc++] = &cmdStr[i + 1];
+                break;
+            }
+            case ACTION_START_QUOTED: {
+                argv[argc++] = &cmdStr[i + 1];
+                break;
+            }
+            case ACTION_END: {
+                cmdStr[i] = 0;
+                break;
+            }
+            case ACTION_ESCAPE: {
+                if (cmdStr[i + 1]) {
+                    i++;
+                }
+                break;
+            }
+        }
+        state = t.m_state;
+    }
+    return argc;
+}
+
+} // namespace APP
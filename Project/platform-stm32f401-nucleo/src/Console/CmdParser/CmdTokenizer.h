@@ -0,0 +1,86 @@
+/*******************************************************************************
+ * Copyright (C) Gallium Studio LLC. All rights reserved.
+ *
+ * This program is open source software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Alternatively, this program may be distributed and modified under the
+ * terms of Gallium Studio LLC commercial licenses, which expressly supersede
+ * the GNU General Public License and are specifically designed for licensees
+ * interested in retaining the proprietary status of their code.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * Contact information:
+ * Website - https://www.galliumstudio.com
+ * Source repository - https://github.com/galliumstudio
+ * Email - admin@galliumstudio.com
+ ******************************************************************************/
+
+#ifndef CMD_TOKENIZER_H
+#define CMD_TOKENIZER_H
+
+#include <stdint.h>
+
+namespace APP {
+
+// Splits a command line into arguments in a single pass, as the CmdParser region used to do with one event
+// per character. It has no dependency on the framework so that it can be tested on a host.
+class CmdTokenizer {
+public:
+    static uint32_t Parse(char *cmdStr, char const **argv, uint32_t maxArgc);
+
+protected:
+    // Tokenizer states and character classes. The states correspond to the former substates of
+    // CmdParser::Started shown in CmdParser.uxf.
+    enum TokenState {
+        TOKEN_DELIM,
+        TOKEN_SIMPLE,
+        TOKEN_QUOTED,
+        TOKEN_STATE_COUNT
+    };
+    enum CharClass {
+        CLASS_DELIM,
+        CLASS_QUOTE,
+        CLASS_SLASH,
+        CLASS_OTHER,
+        CLASS_COUNT
+    };
+    enum TokenAction {
+        ACTION_NONE,
+        ACTION_START,           // Starts an argument at the current character.
+        ACTION_START_QUOTED,    // Starts an argument after the current character.
+        ACTION_END,             // Terminates the current argument.
+        ACTION_END_START_QUOTED,// Terminates the current argument and starts one after the current character.
+        ACTION_ESCAPE,          // Skips the next character, if any.
+    };
+    class Transition {
+    public:
+        uint8_t m_state;        // TokenState.
+        uint8_t m_action;       // TokenAction.
+    };
+    static Transition const m_transition[TOKEN_STATE_COUNT][CLASS_COUNT];
+};
+
+} // namespace APP
+
+#endif // CMD_TOKENIZER_H
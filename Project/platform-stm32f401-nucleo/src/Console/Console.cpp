@@ -37,6 +37,7 @@
  ******************************************************************************/
 
 #include <stdarg.h>
+#include <string.h>
 #include "app_hsmn.h"
 #include "fw_log.h"
 #include "fw_assert.h"
@@ -47,6 +48,7 @@
 #include "UartAct.h"
 #include "CmdInputInterface.h"
 #include "CmdParserInterface.h"
+#include "CmdTokenizer.h"
 #include "Console.h"
 
 FW_DEFINE_THIS_FILE("Console.cpp")
@@ -55,6 +57,8 @@ namespace APP {
 
 static char const * const timerEvtName[] = {
     "STATE_TIMER",
+    "CONSOLE_TIMER",
+    "SCRIPT_TIMER",
 };
 
 static char const * const internalEvtName[] = {
@@ -62,6 +66,10 @@ static char const * const internalEvtName[] = {
     "FAILED",
     "CMD_RECV",
     "RAW_DISABLE",
+    "CONSOLE_CMD",
+    "CONSOLE_COMPLETE",
+    "SCRIPT_START",
+    "SCRIPT_NEXT",
 };
 
 static char const * const interfaceEvtName[] = {
@@ -144,6 +152,40 @@ uint32_t Console::PrintBuf(uint8_t const *dataBuf, uint32_t dataLen, uint8_t ali
     return Log::PrintBuf(m_outIfHsmn, dataBuf, dataLen, align, label);
 }
 
+// Returns the index of the first entry in cmd whose key is not less than key, or cmdCount if none.
+// cmd must be sorted by key (see CMD_TABLE_ASSERT).
+static uint32_t LowerBound(CmdHandler const *cmd, uint32_t cmdCount, char const *key) {
+    uint32_t first = 0;
+    while (cmdCount) {
+        uint32_t half = cmdCount / 2;
+        if (strcmp(cmd[first + half].key, key) < 0) {
+            first += half + 1;
+            cmdCount -= half + 1;
+        } else {
+            cmdCount = half;
+        }
+    }
+    return first;
+}
+
+// Returns the index of the entry in cmd matching key exactly, or else the only entry of which key is a prefix.
+// Returns cmdCount if none.
+static uint32_t FindCmd(CmdHandler const *cmd, uint32_t cmdCount, char const *key) {
+    uint32_t i = LowerBound(cmd, cmdCount, key);
+    if ((i == cmdCount) || (key[0] == 0)) {
+        return cmdCount;
+    }
+    if (STRING_EQUAL(cmd[i].key, key)) {
+        return i;
+    }
+    // Entries starting with key follow the lower bound.
+    uint32_t len = strlen(key);
+    if ((strncmp(cmd[i].key, key, len) == 0) && (((i + 1) == cmdCount) || (strncmp(cmd[i + 1].key, key, len) != 0))) {
+        return i;
+    }
+    return cmdCount;
+}
+
 // Handles a command stored in an event e according to the command handler table passed in.
 // @param e - Contains the command to lookup and associated arguments.
 // @param cmd - Command handler table.
@@ -163,10 +205,87 @@ CmdStatus Console::HandleCmd(Evt const *e, CmdHandler const *cmd, uint32_t cmdCo
             }
             break;
         }
+        case CONSOLE_COMPLETE: {
+            // Follows the words before the last one down the command tables, and saves the entries of the
+            // table reached that start with the last word.
+            ConsoleComplete const &ind = static_cast<ConsoleComplete const &>(*e);
+            uint32_t skip = isRoot ? 0 : 1;
+            if (ind.Argc() == (skip + 1)) {
+                char const *key = ind.Argv()[skip];
+                uint32_t len = strlen(key);
+                uint32_t first = LowerBound(cmd, cmdCount, key);
+                uint32_t i = first;
+                while ((i < cmdCount) && (strncmp(cmd[i].key, key, len) == 0)) {
+                    i++;
+                }
+                m_completeCmd = cmd;
+                m_completeFirst = first;
+                m_completeCount = i - first;
+                m_completeLen = len;
+            } else if (ind.Argc() > (skip + 1)) {
+                uint32_t i = FindCmd(cmd, cmdCount, ind.Argv()[skip]);
+                if (i < cmdCount) {
+                    ConsoleComplete evt(GetHsm().GetHsmn(), ind.Argv() + skip, ind.Argc() - skip);
+                    cmd[i].func(*this, &evt);
+                }
+            }
+            break;
+        }
     }
     return status;
 }
 
+// Completes the last word of a command line being edited. The characters to append to line are returned in
+// suffix, followed by a space if the word is complete. If there are multiple completions without a common
+// prefix to append, they are listed and the line is redisplayed. Returns the length of suffix.
+uint32_t Console::CompleteCmd(char const *line, char *suffix, uint32_t suffixSize) {
+    FW_ASSERT(line && suffix && suffixSize);
+    suffix[0] = 0;
+    char buf[CmdInput::MAX_LEN + 1];
+    STRING_COPY(buf, line, sizeof(buf));
+    char const *argv[MAX_ARGC];
+    uint32_t argc = CmdTokenizer::Parse(buf, argv, MAX_ARGC);
+    // The last word is empty when the line is empty or ends with a delimiter.
+    uint32_t len = strlen(line);
+    if ((len == 0) || (line[len - 1] == SP) || (line[len - 1] == TAB)) {
+        if (argc == MAX_ARGC) {
+            return 0;
+        }
+        argv[argc++] = &buf[sizeof(buf) - 1];
+        buf[sizeof(buf) - 1] = 0;
+    }
+    m_completeCmd = NULL;
+    m_completeCount = 0;
+    ConsoleComplete evt(GetHsm().GetHsmn(), argv, argc);
+    FW_ASSERT(m_rootCmdFunc);
+    m_rootCmdFunc(*this, &evt);
+    if (m_completeCount == 0) {
+        return 0;
+    }
+    // Common prefix of all completions after the last word.
+    CmdHandler const *first = &m_completeCmd[m_completeFirst];
+    CmdHandler const *last = &m_completeCmd[m_completeFirst + m_completeCount - 1];
+    uint32_t i = 0;
+    while (((i + 1) < suffixSize) && first->key[m_completeLen + i] &&
+           (first->key[m_completeLen + i] == last->key[m_completeLen + i])) {
+        suffix[i] = first->key[m_completeLen + i];
+        i++;
+    }
+    if ((m_completeCount == 1) && ((i + 1) < suffixSize)) {
+        suffix[i++] = SP;
+    } else if (i == 0) {
+        PutStr("\n\r");
+        for (uint32_t j = 0; j < m_completeCount; j++) {
+            Print("%s ", m_completeCmd[m_completeFirst + j].key);
+        }
+        PutStr("\n\r");
+        Prompt();
+        PutStr(line);
+    }
+    suffix[i] = 0;
+    return i;
+}
+
 // List all entries in command handler table.
 CmdStatus Console::ListCmd(Evt const *e, CmdHandler const *cmd, uint32_t cmdCount) {
     uint32_t &index = Var(0);
@@ -207,17 +326,17 @@ void Console::Prompt() {
     Print("%d %s> ", GetSystemMs(), GetHsm().GetName());
 }
 
+// Runs the command matching argv[0] exactly or as a unique prefix.
 CmdStatus Console::RunCmd(char const **argv, uint32_t argc, CmdHandler const *cmd, uint32_t cmdCount) {
     FW_ASSERT(argv && argc && cmd && cmdCount);
-    for (uint32_t i = 0; i < cmdCount; i++) {
-        if (STRING_EQUAL(argv[0], cmd[i].key)) {
-            // @todo - Superuser check.
-            ClearVar();
-            ConsoleCmd evt(GetHsm().GetHsmn(), argv, argc);
-            m_lastCmdFunc = cmd[i].func;
-            FW_ASSERT(m_lastCmdFunc);
-            return m_lastCmdFunc(*this, &evt);
-        }
+    uint32_t i = FindCmd(cmd, cmdCount, argv[0]);
+    if (i < cmdCount) {
+        // @todo - Superuser check.
+        ClearVar();
+        ConsoleCmd evt(GetHsm().GetHsmn(), argv, argc);
+        m_lastCmdFunc = cmd[i].func;
+        FW_ASSERT(m_lastCmdFunc);
+        return m_lastCmdFunc(*this, &evt);
     }
     return CMD_DONE;
 }
@@ -225,7 +344,41 @@ CmdStatus Console::RunCmd(char const **argv, uint32_t argc, CmdHandler const *cm
 void Console::LastCmdDone() {
     m_lastCmdFunc = NULL;
     m_consoleTimer.Stop();
-    Prompt();
+    if (m_scriptRun) {
+        PostScriptNext();
+    } else {
+        Prompt();
+    }
+}
+
+// Called by a command handler to load a script from the remaining input. The handler must return CMD_CONTINUE,
+// and is done once the script is loaded.
+void Console::StartScript() {
+    Evt *evt = new Evt(SCRIPT_START, GetHsm().GetHsmn(), GetHsm().GetHsmn());
+    PostSync(evt);
+}
+
+// Posted rather than sent synchronously, so that input (e.g. Ctrl-C) and other events are served between lines.
+void Console::PostScriptNext() {
+    Evt *evt = new Evt(SCRIPT_NEXT, GetHsm().GetHsmn(), GetHsm().GetHsmn());
+    Fw::Post(evt);
+}
+
+// Returns true if any active object of lower priority than this one has events queued.
+bool Console::IsLowerPrioBusy() const {
+    for (uint_fast8_t prio = 1; prio < getPrio(); prio++) {
+        QActive const *act = QF::active_[prio];
+        if (act && !act->m_eQueue.isEmpty()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void Console::ScriptSummary() {
+    uint32_t ms = GetSystemMs() - m_scriptStartMs;
+    Print("Script done: %lu commands in %lu ms (%lu cmd/s), %lu expect failed\n\r", m_scriptCmdCount, ms,
+          ms ? (m_scriptCmdCount * 1000 / ms) : m_scriptCmdCount, m_scriptFailCount);
 }
 
 void Console::RootCmdFunc(Evt const *e) {
@@ -251,8 +404,13 @@ Console::Console(Hsmn hsmn, char const *name, char const *cmdInputName, char con
     m_outFifo(m_outFifoStor, OUT_FIFO_ORDER),
     m_inFifo(m_inFifoStor, IN_FIFO_ORDER),
     m_argc(0), m_rootCmdFunc(NULL), m_lastCmdFunc(NULL),
+    m_completeCmd(NULL), m_completeFirst(0), m_completeCount(0), m_completeLen(0),
+    m_scriptLen(0), m_scriptLineLen(0), m_scriptIndex(0), m_loopStart(0), m_loopCount(0),
+    m_scriptCmdCount(0), m_scriptFailCount(0), m_scriptStartMs(0), m_scriptOutWait(false), m_scriptRun(false),
+    m_scriptYield(false),
     m_stateTimer(GetHsm().GetHsmn(), STATE_TIMER),
-    m_consoleTimer(GetHsm().GetHsmn(), CONSOLE_TIMER) {
+    m_consoleTimer(GetHsm().GetHsmn(), CONSOLE_TIMER),
+    m_scriptTimer(GetHsm().GetHsmn(), SCRIPT_TIMER) {
     SET_EVT_NAME(CONSOLE);
     FW_ASSERT((hsmn >= CONSOLE) && (hsmn <= CONSOLE_LAST));
 }
@@ -500,6 +658,12 @@ QState Console::Started(Console * const me, QEvt const * const e) {
             }
             return Q_HANDLED();
         }
+        case UART_OUT_EMPTY_IND: {
+            // Writes log output staged while the output FIFO was full.
+            Log::FlushStaged(me->m_outIfHsmn);
+            me->LastCmdFunc(static_cast<Evt const *>(e));
+            return Q_HANDLED();
+        }
         default: {
             QSignal sig = e->sig;
             if ((sig == CONSOLE_TIMER) ||
@@ -560,6 +724,10 @@ QState Console::Interactive(Console * const me, QEvt const * const e) {
             EVENT(e);
             return Q_TRAN(&Console::Raw);
         }
+        case SCRIPT_START: {
+            EVENT(e);
+            return Q_TRAN(&Console::Script);
+        }
     }
     return Q_SUPER(&Console::Started);
 }
@@ -590,6 +758,240 @@ QState Console::Raw(Console * const me, QEvt const * const e) {
     return Q_SUPER(&Console::Started);
 }
 
+QState Console::Script(Console * const me, QEvt const * const e) {
+    switch (e->sig) {
+        case Q_ENTRY_SIG: {
+            EVENT(e);
+            // The script command is done once it has handed over to this state.
+            me->m_lastCmdFunc = NULL;
+            return Q_HANDLED();
+        }
+        case Q_EXIT_SIG: {
+            EVENT(e);
+            me->Prompt();
+            return Q_HANDLED();
+        }
+        case Q_INIT_SIG: {
+            return Q_TRAN(&Console::ScriptLoad);
+        }
+        case DONE: {
+            EVENT(e);
+            return Q_TRAN(&Console::Interactive);
+        }
+    }
+    return Q_SUPER(&Console::Started);
+}
+
+QState Console::ScriptLoad(Console * const me, QEvt const * const e) {
+    switch (e->sig) {
+        case Q_ENTRY_SIG: {
+            EVENT(e);
+            me->m_scriptLen = 0;
+            me->m_scriptLineLen = 0;
+            me->PutStr("Enter script. Ctrl-D to run. Ctrl-C to cancel.\n\r");
+            return Q_HANDLED();
+        }
+        case Q_EXIT_SIG: {
+            EVENT(e);
+            return Q_HANDLED();
+        }
+        case UART_IN_DATA_IND: {
+            char c;
+            Evt *evt = NULL;
+            while (!evt && me->m_inFifo.Read(reinterpret_cast<uint8_t *>(&c), 1)) {
+                uint32_t &len = me->m_scriptLen;
+                uint32_t &lineLen = me->m_scriptLineLen;
+                if ((c == CR) || (c == LF) || (c == CTRLD)) {
+                    // Each line is terminated by a null character. Empty lines are not stored.
+                    if (lineLen) {
+                        me->m_script[len++] = 0;
+                        lineLen = 0;
+                        me->PutStr("\n\r");
+                    }
+                    if (c == CTRLD) {
+                        evt = new Evt(len ? SCRIPT_NEXT : DONE, GET_HSMN(), GET_HSMN());
+                    }
+                } else if (c == CTRLC) {
+                    me->PutStr("\n\rScript cancelled\n\r");
+                    evt = new Evt(DONE, GET_HSMN(), GET_HSMN());
+                } else if ((c == BS) || (c == DEL)) {
+                    if (lineLen) {
+                        len--;
+                        lineLen--;
+                        me->PutStr("\b \b");
+                    }
+                } else if ((c == TAB) || ((c >= SP) && (c < DEL))) {
+                    // Reserves room for the null character.
+                    if (((len + 2) > sizeof(me->m_script)) || ((lineLen + 1) >= CmdInput::MAX_LEN)) {
+                        me->PutStr("\n\rScript too long\n\r");
+                        evt = new Evt(DONE, GET_HSMN(), GET_HSMN());
+                    } else {
+                        me->m_script[len++] = c;
+                        lineLen++;
+                        me->PutChar(c);
+                    }
+                }
+            }
+            if (evt) {
+                // SCRIPT_NEXT here starts running the script.
+                me->PostSync(evt);
+            }
+            // Remaining input is handled by the state reached, e.g. Ctrl-C aborts a script being run.
+            if (me->m_inFifo.GetUsedCount()) {
+                evt = new UartInDataInd(GET_HSMN(), GET_HSMN(), 0);
+                Fw::Post(evt);
+            }
+            return Q_HANDLED();
+        }
+        case SCRIPT_NEXT: {
+            EVENT(e);
+            return Q_TRAN(&Console::ScriptRun);
+        }
+    }
+    return Q_SUPER(&Console::Script);
+}
+
+QState Console::ScriptRun(Console * const me, QEvt const * const e) {
+    switch (e->sig) {
+        case Q_ENTRY_SIG: {
+            EVENT(e);
+            me->m_scriptIndex = 0;
+            me->m_loopCount = 0;
+            me->m_scriptCmdCount = 0;
+            me->m_scriptFailCount = 0;
+            me->m_scriptOutWait = false;
+            me->m_scriptYield = false;
+            me->m_scriptRun = true;
+            me->m_scriptStartMs = GetSystemMs();
+            me->PostScriptNext();
+            return Q_HANDLED();
+        }
+        case Q_EXIT_SIG: {
+            EVENT(e);
+            me->m_scriptTimer.Stop();
+            me->m_consoleTimer.Stop();
+            me->m_lastCmdFunc = NULL;
+            me->m_scriptRun = false;
+            me->ScriptSummary();
+            return Q_HANDLED();
+        }
+        case SCRIPT_NEXT: {
+            EVENT(e);
+            // Output of commands is buffered in the output FIFO. Waits for it to drain when half full, rather
+            // than writing past its end.
+            if (me->m_outFifo.GetAvailCount() < (me->m_outFifo.GetBufSize() / 2)) {
+                me->m_scriptOutWait = true;
+                return Q_HANDLED();
+            }
+            // Lower priority active objects do not run while lines run back to back. Yields for a tick when
+            // any of them has events queued, e.g. posted by the previous command, so that their queues do not
+            // overflow. Only yields once per line in case they stay busy.
+            if (!me->m_scriptYield && me->IsLowerPrioBusy()) {
+                me->m_scriptYield = true;
+                me->m_scriptTimer.Start(BSP_MSEC_PER_TICK);
+                return Q_HANDLED();
+            }
+            me->m_scriptYield = false;
+            while (me->m_scriptIndex < me->m_scriptLen) {
+                char const *line = &me->m_script[me->m_scriptIndex];
+                me->m_scriptIndex += strlen(line) + 1;
+                STRING_COPY(me->m_cmdStr, line, sizeof(me->m_cmdStr));
+                me->m_argc = CmdTokenizer::Parse(me->m_cmdStr, me->m_argv, ARRAY_COUNT(me->m_argv));
+                char const **argv = me->m_argv;
+                uint32_t argc = me->m_argc;
+                if ((argc == 0) || (argv[0][0] == '#')) {
+                    continue;
+                }
+                if (STRING_EQUAL(argv[0], "wait")) {
+                    uint32_t ms = (argc > 1) ? STRING_TO_NUM(argv[1], 0) : 0;
+                    if (ms) {
+                        me->m_scriptTimer.Start(ms);
+                        return Q_HANDLED();
+                    }
+                } else if (STRING_EQUAL(argv[0], "repeat")) {
+                    if (me->m_loopCount) {
+                        me->Print("Nested repeat ignored\n\r");
+                        me->m_scriptFailCount++;
+                    } else {
+                        uint32_t count = (argc > 1) ? STRING_TO_NUM(argv[1], 0) : 1;
+                        me->m_loopCount = GREATER(count, 1);
+                        me->m_loopStart = me->m_scriptIndex;
+                    }
+                } else if (STRING_EQUAL(argv[0], "end")) {
+                    if (me->m_loopCount > 1) {
+                        me->m_loopCount--;
+                        me->m_scriptIndex = me->m_loopStart;
+                        // Yields to other events before the next iteration.
+                        me->PostScriptNext();
+                        return Q_HANDLED();
+                    }
+                    me->m_loopCount = 0;
+                } else if (STRING_EQUAL(argv[0], "expect")) {
+                    Hsmn hsmn = HSM_UNDEF;
+                    if (argc > 2) {
+                        for (Hsmn i = HSM_UNDEF + 1; i < HSM_COUNT; i++) {
+                            if (STRING_EQUAL(Log::GetHsmName(i), argv[1])) {
+                                hsmn = i;
+                                break;
+                            }
+                        }
+                    }
+                    char const *state = (hsmn != HSM_UNDEF) ? Log::GetState(hsmn) : "";
+                    if ((hsmn == HSM_UNDEF) || !state || !STRING_EQUAL(state, argv[2])) {
+                        me->Print("Expect failed: %s\n\r", line);
+                        me->m_scriptFailCount++;
+                    }
+                } else {
+                    me->m_scriptCmdCount++;
+                    // LastCmdDone() posts SCRIPT_NEXT when the command is done.
+                    ConsoleCmd ind(GET_HSMN(), argv, argc);
+                    me->RootCmdFunc(&ind);
+                    return Q_HANDLED();
+                }
+            }
+            Evt *evt = new Evt(DONE, GET_HSMN(), GET_HSMN());
+            me->PostSync(evt);
+            return Q_HANDLED();
+        }
+        case SCRIPT_TIMER: {
+            EVENT(e);
+            me->PostScriptNext();
+            return Q_HANDLED();
+        }
+        case SCRIPT_START: {
+            EVENT(e);
+            me->Print("Nested script ignored\n\r");
+            me->m_scriptFailCount++;
+            me->LastCmdDone();
+            return Q_HANDLED();
+        }
+        case UART_OUT_EMPTY_IND: {
+            Log::FlushStaged(me->m_outIfHsmn);
+            if (me->m_lastCmdFunc) {
+                me->LastCmdFunc(static_cast<Evt const *>(e));
+            } else if (me->m_scriptOutWait) {
+                me->m_scriptOutWait = false;
+                me->PostScriptNext();
+            }
+            return Q_HANDLED();
+        }
+        case UART_IN_DATA_IND: {
+            // Input other than Ctrl-C is discarded while a script is running.
+            char c;
+            while (me->m_inFifo.Read(reinterpret_cast<uint8_t *>(&c), 1)) {
+                if (c == CTRLC) {
+                    me->PutStr("\n\rScript aborted\n\r");
+                    Evt *evt = new Evt(DONE, GET_HSMN(), GET_HSMN());
+                    me->PostSync(evt);
+                    break;
+                }
+            }
+            return Q_HANDLED();
+        }
+    }
+    return Q_SUPER(&Console::Script);
+}
+
 /*
 QState Console::MyState(Console * const me, QEvt const * const e) {
     switch (e->sig) {
@@ -44,6 +44,7 @@
 #include "fw_timer.h"
 #include "fw_evt.h"
 #include "fw_pipe.h"
+#include "fw_spscpipe.h"
 #include "app_hsmn.h"
 #include "CmdInput.h"
 #include "CmdParser.h"
@@ -58,6 +59,11 @@ namespace APP {
 
 class Console : public Active {
 public:
+    // Log is turned off in main(). Only ERROR, WARNING and CRITICAL are compiled.
+    enum {
+        LOG_CEILING = Log::TYPE_LOG
+    };
+
     static uint16_t GetInst(Hsmn hsmn);
     static Hsmn GetCmdInputHsmn(Hsmn hsmn) { return CMD_INPUT + GetInst(hsmn); }
     static Hsmn GetCmdParserHsmn(Hsmn hsmn) { return CMD_PARSER + GetInst(hsmn); }
@@ -66,7 +72,7 @@ public:
 
     // Helper functions for use by console commands.
     Hsmn GetOutIfHsmn() const { return m_outIfHsmn; }
-    Fifo &GetInFifo() { return m_inFifo; }
+    SpscFifo &GetInFifo() { return m_inFifo; }
     uint32_t PutChar(char c);
     uint32_t PutCharN(char c, uint32_t count);
     uint32_t PutStr(char const *str);
@@ -79,6 +85,8 @@ public:
     uint32_t PrintBuf(uint8_t const *dataBuf, uint32_t dataLen, uint8_t align = 1, uint32_t label = 0);
     CmdStatus HandleCmd(Evt const *e, CmdHandler const *cmd, uint32_t cmdCount, bool isRoot = false);
     CmdStatus ListCmd(Evt const *e, CmdHandler const *cmd, uint32_t cmdCount);
+    uint32_t CompleteCmd(char const *line, char *suffix, uint32_t suffixSize);
+    void StartScript();
     uint32_t &Var(uint32_t index);
     Timer &GetTimer() { return m_consoleTimer; }
 
@@ -92,6 +100,9 @@ protected:
             static QState Login(Console * const me, QEvt const * const e);
             static QState Interactive(Console * const me, QEvt const * const e);
             static QState Raw(Console * const me, QEvt const * const e);
+            static QState Script(Console * const me, QEvt const * const e);
+                static QState ScriptLoad(Console * const me, QEvt const * const e);
+                static QState ScriptRun(Console * const me, QEvt const * const e);
 
     bool IsUart() { return (m_ifHsmn >= UART_ACT) && (m_ifHsmn  <= UART_ACT_LAST); }
     // Add other interface type check here.
@@ -102,6 +113,9 @@ protected:
     void RootCmdFunc(Evt const *e);
     void LastCmdFunc(Evt const *e);
     void ClearVar() { memset(m_var, 0, sizeof(m_var)); }
+    void PostScriptNext();
+    bool IsLowerPrioBusy() const;
+    void ScriptSummary();
 
     Hsmn m_ifHsmn;          // HSMN of the interface active object.
     Hsmn m_outIfHsmn;       // HSMN of the output interface region.
@@ -115,26 +129,54 @@ protected:
         IN_FIFO_ORDER = 10,
         MAX_ARGC = 8,
         MAX_VAR = 8,
+        SCRIPT_LEN = 1024,
     };
     uint8_t m_outFifoStor[1 << OUT_FIFO_ORDER];
     uint8_t m_inFifoStor[1 << IN_FIFO_ORDER];
     Fifo m_outFifo;
-    Fifo m_inFifo;
+    SpscFifo m_inFifo;
     char m_cmdStr[CmdInput::MAX_LEN];
     char const *m_argv[MAX_ARGC];
     uint32_t m_argc;
     CmdFunc m_rootCmdFunc;
     CmdFunc m_lastCmdFunc;
     uint32_t m_var[MAX_VAR];
+    // Result of CONSOLE_COMPLETE. Entries of m_completeCmd from m_completeFirst to m_completeFirst +
+    // m_completeCount - 1 start with the last word of the command line, which has m_completeLen characters.
+    CmdHandler const *m_completeCmd;
+    uint32_t m_completeFirst;
+    uint32_t m_completeCount;
+    uint32_t m_completeLen;
+
+    // Script mode. A script is loaded as lines separated by null characters, and then run line by line.
+    // Besides commands, a line can be one of:
+    //   wait <ms>                  Waits before running the next line.
+    //   repeat <n> ... end         Runs the lines in between n times. Not nested.
+    //   expect <hsm> <state>       Counts a failure if the HSM named <hsm> is not in <state>.
+    //   # <comment>
+    char m_script[SCRIPT_LEN];
+    uint32_t m_scriptLen;
+    uint32_t m_scriptLineLen;   // Length of the line being loaded.
+    uint32_t m_scriptIndex;     // Offset of the next line to run.
+    uint32_t m_loopStart;       // Offset of the first line in the repeat block.
+    uint32_t m_loopCount;       // Remaining runs of the repeat block. 0 if not in a repeat block.
+    uint32_t m_scriptCmdCount;
+    uint32_t m_scriptFailCount;
+    uint32_t m_scriptStartMs;
+    bool m_scriptOutWait;       // Waiting for output to drain before running the next line.
+    bool m_scriptRun;           // In ScriptRun. isIn() cannot be used while an event is being dispatched.
+    bool m_scriptYield;         // Yielded to lower priority active objects before running the next line.
 
     Timer m_stateTimer;
     Timer m_consoleTimer;       // General timer for command handlers.
+    Timer m_scriptTimer;        // Timer for wait in a script.
 
 public:
     // Timer and internal events are public for use by command handlers which are not member functions of Console.
     enum {
         STATE_TIMER = TIMER_EVT_START(CONSOLE),
         CONSOLE_TIMER,          // General timeout event for command handlers.
+        SCRIPT_TIMER,
     };
 
     enum {
@@ -143,6 +185,9 @@ public:
         CMD_RECV,
         RAW_DISABLE,
         CONSOLE_CMD,            // Sent to command handlers to indicate the execution of a new command.
+        CONSOLE_COMPLETE,       // Sent to command handlers to look up completions of the last word of a command.
+        SCRIPT_START,
+        SCRIPT_NEXT,
     };
 
     class Failed : public ErrorEvt {
@@ -163,6 +208,18 @@ public:
         uint32_t m_argc;
     };
 
+    // Same arguments as ConsoleCmd. Only handled by HandleCmd(). Other command handlers ignore it.
+    class ConsoleComplete: public Evt {
+    public:
+        ConsoleComplete(Hsmn hsmn, char const **argv, uint32_t argc) :
+            Evt(CONSOLE_COMPLETE, hsmn, hsmn), m_argv(argv), m_argc(argc) {}
+        char const **Argv() const { return m_argv; }
+        uint32_t Argc() const { return m_argc; }
+    private:
+        char const **m_argv;
+        uint32_t m_argc;
+    };
+
 };
 
 } // namespace APP
@@ -118,19 +118,32 @@ static CmdStatus State(Console &console, Evt const *e) {
     return CMD_CONTINUE;
 }
 
+// Loads a script from input and runs it. See Console::m_script for lines supported besides commands.
+static CmdStatus Script(Console &console, Evt const *e) {
+    switch (e->sig) {
+        case Console::CONSOLE_CMD: {
+            console.StartScript();
+            break;
+        }
+    }
+    return CMD_CONTINUE;
+}
+
 static CmdStatus List(Console &console, Evt const *e);
-static CmdHandler const cmdHandler[] = {
+static constexpr CmdHandler cmdHandler[] = {
+    { "?",          List,         "List commands",       0 },
     { "assert",     Assert,       "Trigger assert",      0 },
+    { "gpio",       GpioOutCmd,   "GPIO output control", 0 },
     { "hsm",        Hsm,          "List all HSMs",       0 },
-    { "state",      State,        "List HSM states",     0 },
     { "log",        LogCmd,       "Log control",         0 },
+    { "magnetron",  MagnetronCmd, "Magnetron",           0 },
+    { "mw",         MicrowaveCmd, "Microwave",           0 },
+    { "script",     Script,       "Run script",          0 },
+    { "state",      State,        "List HSM states",     0 },
     { "sys",        SystemCmd,    "System",              0 },
     { "wifi",       WifiStCmd,    "Wifi(stm32) control", 0 },
-    { "gpio",       GpioOutCmd,   "GPIO output control", 0 },
-    { "mw",         MicrowaveCmd, "Microwave",           0 },
-    { "magnetron",  MagnetronCmd, "Magnetron",           0 },
-    { "?",          List,         "List commands",       0 },
 };
+CMD_TABLE_ASSERT(cmdHandler);
 
 static CmdStatus List(Console &console, Evt const *e) {
     return console.ListCmd(e, cmdHandler, ARRAY_COUNT(cmdHandler));
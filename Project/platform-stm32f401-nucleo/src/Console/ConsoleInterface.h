@@ -40,6 +40,7 @@
 #define CONSOLE_INTERFACE_H
 
 #include "fw_def.h"
+#include "fw_macro.h"
 #include "fw_evt.h"
 #include "app_hsmn.h"
 #include "fw_assert.h"
@@ -73,6 +74,20 @@ struct CmdHandler {
     bool isSuper;               // True if only superuser can run it.
 };
 
+// Command handler tables are sorted by key in ascending strcmp() order, so that the commands starting with a
+// prefix are adjacent for abbreviation and completion. Tables are declared constexpr and followed by
+// CMD_TABLE_ASSERT() to check the order at compile time. The order is not for speed. With tables of about
+// ten entries, binary search is no faster than a linear scan.
+constexpr int CmdKeyCompare(char const *a, char const *b) {
+    return ((*a == 0) || (*a != *b)) ? (static_cast<unsigned char>(*a) - static_cast<unsigned char>(*b)) :
+                                       CmdKeyCompare(a + 1, b + 1);
+}
+constexpr bool IsCmdTableSorted(CmdHandler const *cmd, uint32_t cmdCount) {
+    return (cmdCount < 2) || ((CmdKeyCompare(cmd[0].key, cmd[1].key) < 0) && IsCmdTableSorted(cmd + 1, cmdCount - 1));
+}
+#define CMD_TABLE_ASSERT(t_) \
+    static_assert(IsCmdTableSorted(t_, ARRAY_COUNT(t_)), #t_ " must be sorted by key without duplicates")
+
 class ConsoleStartReq : public Evt {
 public:
     enum {
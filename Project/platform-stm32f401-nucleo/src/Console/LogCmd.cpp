@@ -38,6 +38,7 @@
 
 #include <string.h>
 #include "fw_log.h"
+#include "fw_prof.h"
 #include "fw_assert.h"
 #include "Console.h"
 #include "LogCmd.h"
@@ -159,14 +160,222 @@ static CmdStatus Ver(Console &console, Evt const *e) {
     return CMD_DONE;
 }
 
+static CmdStatus Bin(Console &console, Evt const *e) {
+    switch (e->sig) {
+        case Console::CONSOLE_CMD: {
+            Console::ConsoleCmd const &cmd = static_cast<Console::ConsoleCmd const &>(*e);
+            if (cmd.Argc() > 1) {
+                for (uint32_t mode = 0; mode < Log::NUM_BIN_MODE; mode++) {
+                    if (STRING_EQUAL(cmd.Argv(1), Log::GetBinModeName(static_cast<Log::BinMode>(mode)))) {
+                        Log::SetBinMode(static_cast<Log::BinMode>(mode));
+                        console.Print("Binary log mode set to %s\n\r", Log::GetBinModeName(Log::GetBinMode()));
+                        return CMD_DONE;
+                    }
+                }
+            }
+            // Print current mode and usage.
+            console.Print("Current binary log mode = %s\n\r", Log::GetBinModeName(Log::GetBinMode()));
+            console.Print("Usage:\n\r");
+            console.Print("log bin off|text|raw\n\r");
+            console.Print("off  - Format immediately\n\r");
+            console.Print("text - Record and format in idle time\n\r");
+            console.Print("raw  - Record and write hex in idle time. Decode with LogDecode.py\n\r");
+            break;
+        }
+    }
+    return CMD_DONE;
+}
+
+static CmdStatus Lossless(Console &console, Evt const *e) {
+    switch (e->sig) {
+        case Console::CONSOLE_CMD: {
+            Console::ConsoleCmd const &cmd = static_cast<Console::ConsoleCmd const &>(*e);
+#if FW_LOG_LOSSLESS
+            if (cmd.Argc() > 1) {
+                if (STRING_EQUAL(cmd.Argv(1), "on") || STRING_EQUAL(cmd.Argv(1), "off")) {
+                    Log::SetLossless(STRING_EQUAL(cmd.Argv(1), "on"));
+                    console.Print("Lossless mode %s\n\r", Log::IsLossless() ? "on" : "off");
+                    break;
+                }
+            }
+            // Print current mode and usage.
+            console.Print("Lossless mode %s\n\r", Log::IsLossless() ? "on" : "off");
+            console.Print("Usage:\n\r");
+            console.Print("log lossless on|off\n\r");
+            console.Print("on  - Stage output when FIFO is full\n\r");
+            console.Print("off - Truncate output when FIFO is full\n\r");
+#else
+            (void)cmd;
+            console.Print("Lossless mode not built (FW_LOG_LOSSLESS=0)\n\r");
+#endif
+            break;
+        }
+    }
+    return CMD_DONE;
+}
+
+static CmdStatus Stat(Console &console, Evt const *e) {
+    switch (e->sig) {
+        case Console::CONSOLE_CMD: {
+            Console::ConsoleCmd const &cmd = static_cast<Console::ConsoleCmd const &>(*e);
+            uint32_t dropByteCnt;
+            uint32_t stallCnt;
+            uint32_t stageCnt;
+            Log::GetStat(dropByteCnt, stallCnt, stageCnt);
+            console.Print("Dropped bytes = %lu\n\r", dropByteCnt);
+            console.Print("Stalls = %lu\n\r", stallCnt);
+            console.Print("Staged records = %lu/%d\n\r", stageCnt, Log::STAGE_COUNT);
+            if ((cmd.Argc() > 1) && STRING_EQUAL(cmd.Argv(1), "clear")) {
+                Log::ClearStat();
+                console.Print("Cleared\n\r");
+            }
+            break;
+        }
+    }
+    return CMD_DONE;
+}
+
+// Per-call time and stack usage of Log::Debug() and Log::Event() in each binary mode, for "log bench".
+// Stack usage is found by painting the stack below the caller before each call and looking for the deepest
+// byte changed. Maximum time and stack include any interrupt taken during the call.
+enum {
+    BENCH_API_COUNT = 2,        // Debug() and Event().
+    BENCH_MODE_COUNT = FW_LOG_BIN ? Log::NUM_BIN_MODE : 1,
+    STACK_PAINT = 2048,         // Bytes painted below the caller.
+    STACK_GUARD = 128,          // Bytes right below the caller left unpainted for the painting function.
+    STACK_FILL = 0xA5,
+};
+
+class BenchStat {
+public:
+    uint32_t m_count;
+    uint32_t m_min;
+    uint32_t m_max;
+    uint64_t m_total;
+    uint32_t m_stackMin;        // Bytes used below the caller.
+    uint32_t m_stackMax;
+};
+
+static BenchStat benchStat[BENCH_MODE_COUNT][BENCH_API_COUNT];
+
+// top is the address of a local of the caller.
+static void __attribute__((noinline)) PaintStack(uint8_t *top) {
+    for (uint8_t volatile *p = top - STACK_PAINT; p < (top - STACK_GUARD); p++) {
+        *p = STACK_FILL;
+    }
+}
+
+// Returns the number of bytes below top written since PaintStack(). Returns STACK_GUARD if none.
+static uint32_t GetStackUsed(uint8_t const *top) {
+    uint8_t const volatile *p = top - STACK_PAINT;
+    while ((p < (top - STACK_GUARD)) && (*p == STACK_FILL)) {
+        p++;
+    }
+    return top - p;
+}
+
+static void BenchCall(Console &console, Evt const *e, uint32_t index, BenchStat *stat) {
+    for (uint32_t api = 0; api < BENCH_API_COUNT; api++) {
+        uint8_t top;
+        PaintStack(&top);
+        uint32_t startTime = Prof::GetTime();
+        if (api == 0) {
+            Log::Debug(Log::TYPE_LOG, console.GetHsmn(), "bench %lu %s", index, "Debug");
+        } else {
+            Log::Event(Log::TYPE_LOG, console.GetHsmn(), e, "LogBench");
+        }
+        uint32_t time = Prof::GetTime() - startTime;
+        uint32_t stack = GetStackUsed(&top);
+        BenchStat &s = stat[api];
+        s.m_min = s.m_count ? LESS(s.m_min, time) : time;
+        s.m_max = GREATER(s.m_max, time);
+        s.m_total += time;
+        s.m_stackMin = s.m_count ? LESS(s.m_stackMin, stack) : stack;
+        s.m_stackMax = GREATER(s.m_stackMax, stack);
+        s.m_count++;
+    }
+    // Writes out records of binary modes, outside of the timed calls.
+    while (Log::FlushBin()) {}
+}
+
+// "log bench [count]" runs count iterations (default 32). Each iteration calls Log::Debug() and Log::Event()
+// once in each binary mode, with logging of this console temporarily enabled. Iterations are run upon
+// UART_OUT_EMPTY_IND so that the output FIFO has room and no call is truncated.
+static CmdStatus Bench(Console &console, Evt const *e) {
+    enum {
+        DEFAULT_COUNT = 32,
+        MAX_COUNT = 1000
+    };
+    uint32_t &index = console.Var(0);
+    uint32_t &count = console.Var(1);
+    uint32_t &binMode = console.Var(2);
+    uint32_t &isOn = console.Var(3);
+    uint32_t &verbosity = console.Var(4);
+    switch (e->sig) {
+        case Console::CONSOLE_CMD: {
+            Console::ConsoleCmd const &cmd = static_cast<Console::ConsoleCmd const &>(*e);
+            count = DEFAULT_COUNT;
+            if (cmd.Argc() > 1) {
+                count = LESS(STRING_TO_NUM(cmd.Argv(1), 0), static_cast<uint32_t>(MAX_COUNT));
+            }
+            if (count == 0) {
+                console.Print("log bench [count]\n\r");
+                return CMD_DONE;
+            }
+            index = 0;
+            binMode = Log::GetBinMode();
+            isOn = Log::IsOn(console.GetHsmn());
+            verbosity = Log::GetVerbosity();
+            memset(benchStat, 0, sizeof(benchStat));
+            Log::On(console.GetHsmn());
+            Log::SetVerbosity(GREATER(verbosity, static_cast<uint32_t>(Log::TYPE_LOG + 1)));
+            console.Print("Running %lu iterations\n\r", count);
+            break;
+        }
+        case UART_OUT_EMPTY_IND: {
+            if (index < count) {
+                for (uint32_t mode = 0; mode < BENCH_MODE_COUNT; mode++) {
+                    Log::SetBinMode(static_cast<Log::BinMode>(mode));
+                    BenchCall(console, e, index, benchStat[mode]);
+                }
+                Log::SetBinMode(static_cast<Log::BinMode>(binMode));
+                index++;
+                break;
+            }
+            Log::SetVerbosity(verbosity);
+            if (!isOn) {
+                Log::Off(console.GetHsmn());
+            }
+            static char const * const apiName[BENCH_API_COUNT] = { "Debug", "Event" };
+            console.Print("Time per call in %s, stack in bytes\n\r", Prof::GetUnit());
+            for (uint32_t mode = 0; mode < BENCH_MODE_COUNT; mode++) {
+                for (uint32_t api = 0; api < BENCH_API_COUNT; api++) {
+                    BenchStat const &s = benchStat[mode][api];
+                    console.Print("%-5s %s n=%lu min=%lu avg=%lu max=%lu stack=%lu..%lu\n\r",
+                                  Log::GetBinModeName(static_cast<Log::BinMode>(mode)), apiName[api], s.m_count,
+                                  s.m_min, static_cast<uint32_t>(s.m_total / s.m_count), s.m_max, s.m_stackMin,
+                                  s.m_stackMax);
+                }
+            }
+            return CMD_DONE;
+        }
+    }
+    return CMD_CONTINUE;
+}
+
 static CmdStatus List(Console &console, Evt const *e);
-static CmdHandler const cmdHandler[] = {
-    { "show",       Show,       "Show config", 0 },
-    { "on",         On,         "Enable log", 0 },
+static constexpr CmdHandler cmdHandler[] = {
+    { "?",          List,       "List commands", 0 },
+    { "bench",      Bench,      "Log call time and stack", 0 },
+    { "bin",        Bin,        "Set binary mode", 0 },
+    { "lossless",   Lossless,   "Set lossless mode", 0 },
     { "off",        Off,        "Disable log", 0 },
+    { "on",         On,         "Enable log", 0 },
+    { "show",       Show,       "Show config", 0 },
+    { "stat",       Stat,       "Show output stats", 0 },
     { "ver",        Ver,        "Set verbosity", 0 },
-    { "?",          List,       "List commands", 0 },
 };
+CMD_TABLE_ASSERT(cmdHandler);
 
 static CmdStatus List(Console &console, Evt const *e) {
     return console.ListCmd(e, cmdHandler, ARRAY_COUNT(cmdHandler));
@@ -90,8 +90,8 @@ static CmdStatus PostEvt(Console &console, Evt const *e) {
 }
 
 static CmdStatus List(Console &console, Evt const *e);
-static CmdHandler const cmdHandler[] = {
-    { "test",    Test,       "Test function", 0 },
+static constexpr CmdHandler cmdHandler[] = {
+    { "?",       List,       "List commands", 0 },
     { "a",       PostEvt,    "A evt", 0 },
     { "b",       PostEvt,    "B evt", 0 },
     { "c",       PostEvt,    "C evt", 0 },
@@ -101,8 +101,9 @@ static CmdHandler const cmdHandler[] = {
     { "g",       PostEvt,    "G evt", 0 },
     { "h",       PostEvt,    "H evt", 0 },
     { "i",       PostEvt,    "I evt", 0 },
-    { "?",       List,       "List commands", 0 },
+    { "test",    Test,       "Test function", 0 },
 };
+CMD_TABLE_ASSERT(cmdHandler);
 
 static CmdStatus List(Console &console, Evt const *e) {
     return console.ListCmd(e, cmdHandler, ARRAY_COUNT(cmdHandler));
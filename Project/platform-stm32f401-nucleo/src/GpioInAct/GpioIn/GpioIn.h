@@ -52,6 +52,11 @@ namespace APP {
 
 class GpioIn : public Region {
 public:
+    // Log is turned off in main(). Only ERROR, WARNING and CRITICAL are compiled.
+    enum {
+        LOG_CEILING = Log::TYPE_LOG
+    };
+
     GpioIn();
 
     typedef KeyValue<Hsmn, uint16_t> HsmnPin;
@@ -53,6 +53,11 @@ namespace APP {
 
 class GpioOut : public Region {
 public:
+    // Log is turned off in main(). Only ERROR, WARNING and CRITICAL are compiled.
+    enum {
+        LOG_CEILING = Log::TYPE_LOG
+    };
+
     GpioOut();
 
 protected:
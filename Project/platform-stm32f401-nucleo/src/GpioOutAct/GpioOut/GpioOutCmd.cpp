@@ -102,12 +102,13 @@ static CmdStatus Off(Console &console, Evt const *e) {
 
 
 static CmdStatus List(Console &console, Evt const *e);
-static CmdHandler const cmdHandler[] = {
-    { "test",       Test,       "Test function", 0 },
-    { "on",         On,         "Start a pattern", 0 },
-    { "off",        Off,        "Stop a pattern", 0 },
+static constexpr CmdHandler cmdHandler[] = {
     { "?",          List,       "List commands", 0 },
+    { "off",        Off,        "Stop a pattern", 0 },
+    { "on",         On,         "Start a pattern", 0 },
+    { "test",       Test,       "Test function", 0 },
 };
+CMD_TABLE_ASSERT(cmdHandler);
 
 static CmdStatus List(Console &console, Evt const *e) {
     return console.ListCmd(e, cmdHandler, ARRAY_COUNT(cmdHandler));
@@ -39,6 +39,7 @@
 #include "app_hsmn.h"
 #include "fw_log.h"
 #include "fw_assert.h"
+#include "MicrowaveInterface.h"
 #include "FanInterface.h"
 #include "Fan.h"
 
@@ -65,75 +66,173 @@ static char const * const interfaceEvtName[] = {
 };
 
 Fan::Fan(Hsmn hsmn, char const * name) :
-    Region((QStateHandler)&Fan::InitialPseudoState, hsmn, name) {
+    MRegion((QStateHandler)&Fan::InitialPseudoState, hsmn, name) {
     SET_EVT_NAME(FAN);
 }
 
+QMState const Fan::Root_s = {
+    static_cast<QMState const *>(0),
+    Q_STATE_CAST(&Fan::Root),
+    Q_ACTION_CAST(&Fan::Root_e),
+    Q_ACTION_CAST(&Fan::Root_x),
+    Q_ACTION_CAST(&Fan::Root_i)
+};
+
+QMState const Fan::On_s = {
+    &Fan::Root_s,
+    Q_STATE_CAST(&Fan::On),
+    Q_ACTION_CAST(&Fan::On_e),
+    Q_ACTION_CAST(&Fan::On_x),
+    Q_ACTION_CAST(0)
+};
+
+QMState const Fan::Off_s = {
+    &Fan::Root_s,
+    Q_STATE_CAST(&Fan::Off),
+    Q_ACTION_CAST(&Fan::Off_e),
+    Q_ACTION_CAST(&Fan::Off_x),
+    Q_ACTION_CAST(0)
+};
+
 QState Fan::InitialPseudoState(Fan * const me, QEvt const * const e) {
     (void)e;
-    return Q_TRAN(&Fan::Root);
+    static struct {
+        QMState const *target;
+        QActionHandler act[3];
+    } const tatbl = {
+        &Fan::Root_s,
+        {
+            Q_ACTION_CAST(&Fan::Root_e),
+            Q_ACTION_CAST(&Fan::Root_i),
+            Q_ACTION_CAST(0)
+        }
+    };
+    return QM_TRAN_INIT(&tatbl);
 }
 
 QState Fan::Root(Fan * const me, QEvt const * const e) {
     switch (e->sig) {
-        case Q_ENTRY_SIG: {
-            EVENT(e);
-            return Q_HANDLED();
-        }
-        case Q_EXIT_SIG: {
-            EVENT(e);
-            return Q_HANDLED();
-        }
-        case Q_INIT_SIG: {
-            EVENT(e);
-            return Q_TRAN(&Fan::Off);
-        }
         case FAN_ON_REQ: {
             EVENT(e);
-            return Q_TRAN(&Fan::On);
+            static struct {
+                QMState const *target;
+                QActionHandler act[2];
+            } const tatbl = {
+                &Fan::On_s,
+                {
+                    Q_ACTION_CAST(&Fan::On_e),
+                    Q_ACTION_CAST(0)
+                }
+            };
+            return QM_TRAN(&tatbl);
         }
-        case FAN_OFF_REQ: {
+        case FAN_OFF_REQ:
+        case MICROWAVE_OFF_IND: {
             EVENT(e);
-            return Q_TRAN(&Fan::Off);
+            static struct {
+                QMState const *target;
+                QActionHandler act[2];
+            } const tatbl = {
+                &Fan::Off_s,
+                {
+                    Q_ACTION_CAST(&Fan::Off_e),
+                    Q_ACTION_CAST(0)
+                }
+            };
+            return QM_TRAN(&tatbl);
         }
     }
-    return Q_SUPER(&QHsm::top);
+    return QM_SUPER();
+}
+
+QState Fan::Root_e(Fan * const me) {
+    EVENT_ENTRY(Root);
+    Fw::Subscribe(MICROWAVE_OFF_IND, GET_HSMN());
+    return QM_ENTRY(&Fan::Root_s);
+}
+
+QState Fan::Root_x(Fan * const me) {
+    EVENT_EXIT(Root);
+    Fw::Unsubscribe(MICROWAVE_OFF_IND, GET_HSMN());
+    return QM_EXIT(&Fan::Root_s);
+}
+
+QState Fan::Root_i(Fan * const me) {
+    EVENT_INIT(Root);
+    static struct {
+        QMState const *target;
+        QActionHandler act[2];
+    } const tatbl = {
+        &Fan::Off_s,
+        {
+            Q_ACTION_CAST(&Fan::Off_e),
+            Q_ACTION_CAST(0)
+        }
+    };
+    return QM_TRAN_INIT(&tatbl);
 }
 
 QState Fan::On(Fan * const me, QEvt const * const e) {
     switch (e->sig) {
-        case Q_ENTRY_SIG: {
-            EVENT(e);
-            return Q_HANDLED();
-        }
-        case Q_EXIT_SIG: {
-            EVENT(e);
-            return Q_HANDLED();
-        }
-        case FAN_OFF_REQ: {
+        case FAN_OFF_REQ:
+        case MICROWAVE_OFF_IND: {
             EVENT(e);
-            return Q_TRAN(&Fan::Off);
+            static struct {
+                QMState const *target;
+                QActionHandler act[3];
+            } const tatbl = {
+                &Fan::Off_s,
+                {
+                    Q_ACTION_CAST(&Fan::On_x),
+                    Q_ACTION_CAST(&Fan::Off_e),
+                    Q_ACTION_CAST(0)
+                }
+            };
+            return QM_TRAN(&tatbl);
         }
     }
-    return Q_SUPER(&Fan::Root);
+    return QM_SUPER();
+}
+
+QState Fan::On_e(Fan * const me) {
+    EVENT_ENTRY(On);
+    return QM_ENTRY(&Fan::On_s);
+}
+
+QState Fan::On_x(Fan * const me) {
+    EVENT_EXIT(On);
+    return QM_EXIT(&Fan::On_s);
 }
 
 QState Fan::Off(Fan * const me, QEvt const * const e) {
     switch (e->sig) {
-        case Q_ENTRY_SIG: {
-            EVENT(e);
-            return Q_HANDLED();
-        }
-        case Q_EXIT_SIG: {
-            EVENT(e);
-            return Q_HANDLED();
-        }
         case FAN_ON_REQ: {
             EVENT(e);
-            return Q_TRAN(&Fan::On);
+            static struct {
+                QMState const *target;
+                QActionHandler act[3];
+            } const tatbl = {
+                &Fan::On_s,
+                {
+                    Q_ACTION_CAST(&Fan::Off_x),
+                    Q_ACTION_CAST(&Fan::On_e),
+                    Q_ACTION_CAST(0)
+                }
+            };
+            return QM_TRAN(&tatbl);
         }
     }
-    return Q_SUPER(&Fan::Root);
+    return QM_SUPER();
+}
+
+QState Fan::Off_e(Fan * const me) {
+    EVENT_ENTRY(Off);
+    return QM_ENTRY(&Fan::Off_s);
+}
+
+QState Fan::Off_x(Fan * const me) {
+    EVENT_EXIT(Off);
+    return QM_EXIT(&Fan::Off_s);
 }
 
 /*
@@ -40,7 +40,7 @@
 #define FAN_H
 
 #include "qpcpp.h"
-#include "fw_region.h"
+#include "fw_mregion.h"
 #include "fw_timer.h"
 #include "fw_evt.h"
 #include "app_hsmn.h"
@@ -50,15 +50,28 @@ using namespace FW;
 
 namespace APP {
 
-class Fan : public Region {
+class Fan : public MRegion {
 public:
     Fan(Hsmn hsmn, const char *name);
 
 protected:
+    // Coded in the QMsm style as a reference for MRegion. Each state has a state object (_s) and
+    // optional entry (_e), exit (_x) and initial (_i) actions. Transitions use the transition-action
+    // tables defined in Fan.cpp.
     static QState InitialPseudoState(Fan * const me, QEvt const * const e);
     static QState Root(Fan * const me, QEvt const * const e);
+    static QState Root_e(Fan * const me);
+    static QState Root_x(Fan * const me);
+    static QState Root_i(Fan * const me);
+    static QMState const Root_s;
         static QState On(Fan * const me, QEvt const * const e);
+        static QState On_e(Fan * const me);
+        static QState On_x(Fan * const me);
+        static QMState const On_s;
         static QState Off(Fan * const me, QEvt const * const e);
+        static QState Off_e(Fan * const me);
+        static QState Off_x(Fan * const me);
+        static QMState const Off_s;
 
 // Placeholders
 #define FAN_TIMER_EVT \
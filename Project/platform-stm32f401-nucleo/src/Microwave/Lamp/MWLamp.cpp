@@ -39,6 +39,7 @@
 #include "app_hsmn.h"
 #include "fw_log.h"
 #include "fw_assert.h"
+#include "MicrowaveInterface.h"
 #include "MWLampInterface.h"
 #include "MWLamp.h"
 
@@ -78,10 +79,12 @@ QState MWLamp::Root(MWLamp * const me, QEvt const * const e) {
     switch (e->sig) {
         case Q_ENTRY_SIG: {
             EVENT(e);
+            Fw::Subscribe(MICROWAVE_OFF_IND, GET_HSMN());
             return Q_HANDLED();
         }
         case Q_EXIT_SIG: {
             EVENT(e);
+            Fw::Unsubscribe(MICROWAVE_OFF_IND, GET_HSMN());
             return Q_HANDLED();
         }
         case Q_INIT_SIG: {
@@ -91,7 +94,8 @@ QState MWLamp::Root(MWLamp * const me, QEvt const * const e) {
             EVENT(e);
             return Q_TRAN(&MWLamp::On);
         }
-        case MW_LAMP_OFF_REQ: {
+        case MW_LAMP_OFF_REQ:
+        case MICROWAVE_OFF_IND: {
             EVENT(e);
             return Q_TRAN(&MWLamp::Off);
         }
@@ -109,7 +113,8 @@ QState MWLamp::On(MWLamp * const me, QEvt const * const e) {
             EVENT(e);
             return Q_HANDLED();
         }
-        case MW_LAMP_OFF_REQ: {
+        case MW_LAMP_OFF_REQ:
+        case MICROWAVE_OFF_IND: {
             EVENT(e);
             return Q_TRAN(&MWLamp::Off);
         }
@@ -108,13 +108,14 @@ static CmdStatus Pause(Console & console, Evt const *e) {
 }
 
 static CmdStatus List(Console &console, Evt const *e);
-static CmdHandler const cmdHandler[] = {
+static constexpr CmdHandler cmdHandler[] = {
     { "?",          List,       "List commands", 0 },
-    { "power",      PowerLevel, "Set Power Level", 0 },
-    { "on",         On,         "Turn on", 0 },
     { "off",        Off,        "Turn off", 0 },
-	{ "pause",      Pause,      "Pause", 0 }
+    { "on",         On,         "Turn on", 0 },
+    { "pause",      Pause,      "Pause", 0 },
+    { "power",      PowerLevel, "Set Power Level", 0 },
 };
+CMD_TABLE_ASSERT(cmdHandler);
 
 static CmdStatus List(Console &console, Evt const *e) {
     return console.ListCmd(e, cmdHandler, ARRAY_COUNT(cmdHandler));
@@ -41,7 +41,7 @@
 
 #include "fw_def.h"
 #include "fw_evt.h"
-#include "fw_pipe.h"
+#include "fw_spscpipe.h"
 #include "app_hsmn.h"
 
 using namespace QP;
@@ -70,7 +70,7 @@ enum {
     MAGNETRON_REASON_UNSPEC = 0,
 };
 
-typedef Pipe<uint32_t> MagnetronPipe;
+typedef SpscPipe<uint32_t> MagnetronPipe;
 
 class MagnetronStartReq : public Evt {
 public:
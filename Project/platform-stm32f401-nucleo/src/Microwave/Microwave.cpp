@@ -72,7 +72,7 @@ static char const * const interfaceEvtName[] = {
 };
 
 Microwave::Microwave() :
-    Active((QStateHandler)&Microwave::InitialPseudoState, MICROWAVE, "MICROWAVE"),
+    MActive((QStateHandler)&Microwave::InitialPseudoState, MICROWAVE, "MICROWAVE"),
     m_blink{false},
     m_blinkToggle{false},
     m_clockInitialized{false},
@@ -101,91 +101,306 @@ Microwave::Microwave() :
         m_message.dst = MicrowaveMsgFormat::Destination::APP;
     }
 
+QMState const Microwave::Root_s = {
+    static_cast<QMState const *>(0),
+    Q_STATE_CAST(&Microwave::Root),
+    Q_ACTION_CAST(&Microwave::Root_e),
+    Q_ACTION_CAST(&Microwave::Root_x),
+    Q_ACTION_CAST(&Microwave::Root_i)
+};
+
+QMState const Microwave::Stopped_s = {
+    &Microwave::Root_s,
+    Q_STATE_CAST(&Microwave::Stopped),
+    Q_ACTION_CAST(&Microwave::Stopped_e),
+    Q_ACTION_CAST(&Microwave::Stopped_x),
+    Q_ACTION_CAST(0)
+};
+
+QMState const Microwave::Starting_s = {
+    &Microwave::Root_s,
+    Q_STATE_CAST(&Microwave::Starting),
+    Q_ACTION_CAST(&Microwave::Starting_e),
+    Q_ACTION_CAST(&Microwave::Starting_x),
+    Q_ACTION_CAST(0)
+};
+
+QMState const Microwave::Stopping_s = {
+    &Microwave::Root_s,
+    Q_STATE_CAST(&Microwave::Stopping),
+    Q_ACTION_CAST(&Microwave::Stopping_e),
+    Q_ACTION_CAST(&Microwave::Stopping_x),
+    Q_ACTION_CAST(0)
+};
+
+QMState const Microwave::Started_s = {
+    &Microwave::Root_s,
+    Q_STATE_CAST(&Microwave::Started),
+    Q_ACTION_CAST(&Microwave::Started_e),
+    Q_ACTION_CAST(&Microwave::Started_x),
+    Q_ACTION_CAST(&Microwave::Started_i)
+};
+
+QMState const Microwave::DisplayClock_s = {
+    &Microwave::Started_s,
+    Q_STATE_CAST(&Microwave::DisplayClock),
+    Q_ACTION_CAST(&Microwave::DisplayClock_e),
+    Q_ACTION_CAST(&Microwave::DisplayClock_x),
+    Q_ACTION_CAST(0)
+};
+
+QMState const Microwave::SetClock_s = {
+    &Microwave::DisplayClock_s,
+    Q_STATE_CAST(&Microwave::SetClock),
+    Q_ACTION_CAST(&Microwave::SetClock_e),
+    Q_ACTION_CAST(&Microwave::SetClock_x),
+    Q_ACTION_CAST(&Microwave::SetClock_i)
+};
+
+QMState const Microwave::ClockSelectHourTens_s = {
+    &Microwave::SetClock_s,
+    Q_STATE_CAST(&Microwave::ClockSelectHourTens),
+    Q_ACTION_CAST(&Microwave::ClockSelectHourTens_e),
+    Q_ACTION_CAST(&Microwave::ClockSelectHourTens_x),
+    Q_ACTION_CAST(0)
+};
+
+QMState const Microwave::ClockSelectHourOnes_s = {
+    &Microwave::SetClock_s,
+    Q_STATE_CAST(&Microwave::ClockSelectHourOnes),
+    Q_ACTION_CAST(&Microwave::ClockSelectHourOnes_e),
+    Q_ACTION_CAST(&Microwave::ClockSelectHourOnes_x),
+    Q_ACTION_CAST(0)
+};
+
+QMState const Microwave::ClockSelectMinuteTens_s = {
+    &Microwave::SetClock_s,
+    Q_STATE_CAST(&Microwave::ClockSelectMinuteTens),
+    Q_ACTION_CAST(&Microwave::ClockSelectMinuteTens_e),
+    Q_ACTION_CAST(&Microwave::ClockSelectMinuteTens_x),
+    Q_ACTION_CAST(0)
+};
+
+QMState const Microwave::ClockSelectMinuteOnes_s = {
+    &Microwave::SetClock_s,
+    Q_STATE_CAST(&Microwave::ClockSelectMinuteOnes),
+    Q_ACTION_CAST(&Microwave::ClockSelectMinuteOnes_e),
+    Q_ACTION_CAST(&Microwave::ClockSelectMinuteOnes_x),
+    Q_ACTION_CAST(0)
+};
+
+QMState const Microwave::SetCookTimer_s = {
+    &Microwave::Started_s,
+    Q_STATE_CAST(&Microwave::SetCookTimer),
+    Q_ACTION_CAST(&Microwave::SetCookTimer_e),
+    Q_ACTION_CAST(&Microwave::SetCookTimer_x),
+    Q_ACTION_CAST(&Microwave::SetCookTimer_i)
+};
+
+QMState const Microwave::SetCookTimerInitial_s = {
+    &Microwave::SetCookTimer_s,
+    Q_STATE_CAST(&Microwave::SetCookTimerInitial),
+    Q_ACTION_CAST(&Microwave::SetCookTimerInitial_e),
+    Q_ACTION_CAST(&Microwave::SetCookTimerInitial_x),
+    Q_ACTION_CAST(0)
+};
+
+QMState const Microwave::SetCookTimerFinal_s = {
+    &Microwave::SetCookTimer_s,
+    Q_STATE_CAST(&Microwave::SetCookTimerFinal),
+    Q_ACTION_CAST(&Microwave::SetCookTimerFinal_e),
+    Q_ACTION_CAST(&Microwave::SetCookTimerFinal_x),
+    Q_ACTION_CAST(0)
+};
+
+QMState const Microwave::SetPowerLevel_s = {
+    &Microwave::Started_s,
+    Q_STATE_CAST(&Microwave::SetPowerLevel),
+    Q_ACTION_CAST(&Microwave::SetPowerLevel_e),
+    Q_ACTION_CAST(&Microwave::SetPowerLevel_x),
+    Q_ACTION_CAST(0)
+};
+
+QMState const Microwave::SetKitchenTimer_s = {
+    &Microwave::Started_s,
+    Q_STATE_CAST(&Microwave::SetKitchenTimer),
+    Q_ACTION_CAST(&Microwave::SetKitchenTimer_e),
+    Q_ACTION_CAST(&Microwave::SetKitchenTimer_x),
+    Q_ACTION_CAST(&Microwave::SetKitchenTimer_i)
+};
+
+QMState const Microwave::KitchenSelectHourTens_s = {
+    &Microwave::SetKitchenTimer_s,
+    Q_STATE_CAST(&Microwave::KitchenSelectHourTens),
+    Q_ACTION_CAST(&Microwave::KitchenSelectHourTens_e),
+    Q_ACTION_CAST(&Microwave::KitchenSelectHourTens_x),
+    Q_ACTION_CAST(0)
+};
+
+QMState const Microwave::KitchenSelectHourOnes_s = {
+    &Microwave::SetKitchenTimer_s,
+    Q_STATE_CAST(&Microwave::KitchenSelectHourOnes),
+    Q_ACTION_CAST(&Microwave::KitchenSelectHourOnes_e),
+    Q_ACTION_CAST(&Microwave::KitchenSelectHourOnes_x),
+    Q_ACTION_CAST(0)
+};
+
+QMState const Microwave::KitchenSelectMinuteTens_s = {
+    &Microwave::SetKitchenTimer_s,
+    Q_STATE_CAST(&Microwave::KitchenSelectMinuteTens),
+    Q_ACTION_CAST(&Microwave::KitchenSelectMinuteTens_e),
+    Q_ACTION_CAST(&Microwave::KitchenSelectMinuteTens_x),
+    Q_ACTION_CAST(0)
+};
+
+QMState const Microwave::KitchenSelectMinuteOnes_s = {
+    &Microwave::SetKitchenTimer_s,
+    Q_STATE_CAST(&Microwave::KitchenSelectMinuteOnes),
+    Q_ACTION_CAST(&Microwave::KitchenSelectMinuteOnes_e),
+    Q_ACTION_CAST(&Microwave::KitchenSelectMinuteOnes_x),
+    Q_ACTION_CAST(0)
+};
+
+QMState const Microwave::DisplayTimer_s = {
+    &Microwave::Started_s,
+    Q_STATE_CAST(&Microwave::DisplayTimer),
+    Q_ACTION_CAST(&Microwave::DisplayTimer_e),
+    Q_ACTION_CAST(&Microwave::DisplayTimer_x),
+    Q_ACTION_CAST(&Microwave::DisplayTimer_i)
+};
+
+QMState const Microwave::DisplayTimerRunning_s = {
+    &Microwave::DisplayTimer_s,
+    Q_STATE_CAST(&Microwave::DisplayTimerRunning),
+    Q_ACTION_CAST(&Microwave::DisplayTimerRunning_e),
+    Q_ACTION_CAST(&Microwave::DisplayTimerRunning_x),
+    Q_ACTION_CAST(0)
+};
+
+QMState const Microwave::DisplayTimerPaused_s = {
+    &Microwave::DisplayTimer_s,
+    Q_STATE_CAST(&Microwave::DisplayTimerPaused),
+    Q_ACTION_CAST(&Microwave::DisplayTimerPaused_e),
+    Q_ACTION_CAST(&Microwave::DisplayTimerPaused_x),
+    Q_ACTION_CAST(0)
+};
+
 QState Microwave::InitialPseudoState(Microwave * const me, QEvt const * const e) {
     (void)e;
-    return Q_TRAN(&Microwave::Root);
+    static struct {
+        QMState const *target;
+        QActionHandler act[3];
+    } const tatbl = {
+        &Microwave::Root_s,
+        {
+            Q_ACTION_CAST(&Microwave::Root_e),
+            Q_ACTION_CAST(&Microwave::Root_i),
+            Q_ACTION_CAST(0)
+        }
+    };
+    return QM_TRAN_INIT(&tatbl);
 }
 
 QState Microwave::Root(Microwave * const me, QEvt const * const e) {
     switch (e->sig) {
-        case Q_ENTRY_SIG: {
-            EVENT(e);
-            // Initialize regions.
-            me->m_fan.Init(me);
-            me->m_lamp.Init(me);
-            me->m_turntable.Init(me);
-            return Q_HANDLED();
-        }
-        case Q_EXIT_SIG: {
-            EVENT(e);
-            return Q_HANDLED();
-        }
-        case Q_INIT_SIG: {
-            return Q_TRAN(&Microwave::Stopped);
-        }
         case MICROWAVE_START_REQ: {
             EVENT(e);
             Evt const &req = EVT_CAST(*e);
             Evt *evt = new MicrowaveStartCfm(req.GetFrom(), GET_HSMN(), req.GetSeq(), ERROR_STATE);
             Fw::Post(evt);
-            return Q_HANDLED();
+            return QM_HANDLED();
         }
         case MICROWAVE_STOP_REQ: {
             EVENT(e);
             Evt const &req = EVT_CAST(*e);
             me->GetHsm().SaveInSeq(req);
-            return Q_TRAN(&Microwave::Stopping);
+            static struct {
+                QMState const *target;
+                QActionHandler act[2];
+            } const tatbl = {
+                &Microwave::Stopping_s,
+                {
+                    Q_ACTION_CAST(&Microwave::Stopping_e),
+                    Q_ACTION_CAST(0)
+                }
+            };
+            return QM_TRAN(&tatbl);
         }
     }
-    return Q_SUPER(&QHsm::top);
+    return QM_SUPER();
+}
+
+QState Microwave::Root_e(Microwave * const me) {
+    EVENT_ENTRY(Root);
+    // Initialize regions.
+    me->m_fan.Init(me);
+    me->m_lamp.Init(me);
+    me->m_turntable.Init(me);
+    return QM_ENTRY(&Microwave::Root_s);
+}
+
+QState Microwave::Root_x(Microwave * const me) {
+    EVENT_EXIT(Root);
+    return QM_EXIT(&Microwave::Root_s);
+}
+
+QState Microwave::Root_i(Microwave * const me) {
+    EVENT_INIT(Root);
+    static struct {
+        QMState const *target;
+        QActionHandler act[2];
+    } const tatbl = {
+        &Microwave::Stopped_s,
+        {
+            Q_ACTION_CAST(&Microwave::Stopped_e),
+            Q_ACTION_CAST(0)
+        }
+    };
+    return QM_TRAN_INIT(&tatbl);
 }
 
 QState Microwave::Stopped(Microwave * const me, QEvt const * const e) {
     switch (e->sig) {
-        case Q_ENTRY_SIG: {
-            EVENT(e);
-            return Q_HANDLED();
-        }
-        case Q_EXIT_SIG: {
-            EVENT(e);
-            return Q_HANDLED();
-        }
         case MICROWAVE_STOP_REQ: {
             EVENT(e);
             Evt const &req = EVT_CAST(*e);
             Evt *evt = new MicrowaveStopCfm(req.GetFrom(), GET_HSMN(), req.GetSeq(), ERROR_SUCCESS);
             Fw::Post(evt);
-            return Q_HANDLED();
+            return QM_HANDLED();
         }
         case MICROWAVE_START_REQ: {
             EVENT(e);
             MicrowaveStartReq const &req = static_cast<MicrowaveStartReq const &>(*e);
             me->GetHsm().SaveInSeq(req);
-            return Q_TRAN(&Microwave::Starting);
+            static struct {
+                QMState const *target;
+                QActionHandler act[3];
+            } const tatbl = {
+                &Microwave::Starting_s,
+                {
+                    Q_ACTION_CAST(&Microwave::Stopped_x),
+                    Q_ACTION_CAST(&Microwave::Starting_e),
+                    Q_ACTION_CAST(0)
+                }
+            };
+            return QM_TRAN(&tatbl);
         }
     }
-    return Q_SUPER(&Microwave::Root);
+    return QM_SUPER();
+}
+
+QState Microwave::Stopped_e(Microwave * const me) {
+    EVENT_ENTRY(Stopped);
+    return QM_ENTRY(&Microwave::Stopped_s);
+}
+
+QState Microwave::Stopped_x(Microwave * const me) {
+    EVENT_EXIT(Stopped);
+    return QM_EXIT(&Microwave::Stopped_s);
 }
 
 QState Microwave::Starting(Microwave * const me, QEvt const * const e) {
     switch (e->sig) {
-        case Q_ENTRY_SIG: {
-            EVENT(e);
-            uint32_t timeout = MicrowaveStartReq::TIMEOUT_MS;
-            FW_ASSERT(timeout > MagnetronStartReq::TIMEOUT_MS);
-            me->m_stateTimer.Start(timeout);
-            me->GetHsm().ResetOutSeq();
-            Evt *evt = new MagnetronStartReq(MAGNETRON, GET_HSMN(), GEN_SEQ());
-            me->GetHsm().SaveOutSeq(*evt);
-            Fw::Post(evt);
-            return Q_HANDLED();
-        }
-        case Q_EXIT_SIG: {
-            EVENT(e);
-            me->m_stateTimer.Stop();
-            me->GetHsm().ClearInSeq();
-            return Q_HANDLED();
-        }
         case MAGNETRON_START_CFM: {
             EVENT(e);
             ErrorEvt const &cfm = ERROR_EVT_CAST(*e);
@@ -197,7 +412,7 @@ QState Microwave::Starting(Microwave * const me, QEvt const * const e) {
                 Evt *evt = new Evt(DONE, GET_HSMN());
                 me->PostSync(evt);
             }
-            return Q_HANDLED();
+            return QM_HANDLED();
         }
         case FAILED:
         case STATE_TIMER: {
@@ -211,51 +426,66 @@ QState Microwave::Starting(Microwave * const me, QEvt const * const e) {
                 evt = new MicrowaveStartCfm(me->GetHsm().GetInHsmn(), GET_HSMN(), me->GetHsm().GetInSeq(), ERROR_TIMEOUT, GET_HSMN());
             }
             Fw::Post(evt);
-            return Q_TRAN(&Microwave::Stopping);
+            static struct {
+                QMState const *target;
+                QActionHandler act[3];
+            } const tatbl = {
+                &Microwave::Stopping_s,
+                {
+                    Q_ACTION_CAST(&Microwave::Starting_x),
+                    Q_ACTION_CAST(&Microwave::Stopping_e),
+                    Q_ACTION_CAST(0)
+                }
+            };
+            return QM_TRAN(&tatbl);
         }
         case DONE: {
             EVENT(e);
             Evt *evt = new MicrowaveStartCfm(me->GetHsm().GetInHsmn(), GET_HSMN(), me->GetHsm().GetInSeq(), ERROR_SUCCESS);
             Fw::Post(evt);
-            return Q_TRAN(&Microwave::Started);
+            static struct {
+                QMState const *target;
+                QActionHandler act[4];
+            } const tatbl = {
+                &Microwave::Started_s,
+                {
+                    Q_ACTION_CAST(&Microwave::Starting_x),
+                    Q_ACTION_CAST(&Microwave::Started_e),
+                    Q_ACTION_CAST(&Microwave::Started_i),
+                    Q_ACTION_CAST(0)
+                }
+            };
+            return QM_TRAN(&tatbl);
         }
     }
-    return Q_SUPER(&Microwave::Root);
+    return QM_SUPER();
 }
 
-QState Microwave::Stopping(Microwave * const me, QEvt const * const e) {
-    switch (e->sig) {
-        case Q_ENTRY_SIG: {
-            EVENT(e);
-            uint32_t timeout = MicrowaveStopReq::TIMEOUT_MS;
-            FW_ASSERT(timeout > MagnetronStopReq::TIMEOUT_MS);
-            me->m_stateTimer.Start(timeout);
-            me->GetHsm().ResetOutSeq();
+QState Microwave::Starting_e(Microwave * const me) {
+    EVENT_ENTRY(Starting);
+    uint32_t timeout = MicrowaveStartReq::TIMEOUT_MS;
+    FW_ASSERT(timeout > MagnetronStartReq::TIMEOUT_MS);
+    me->m_stateTimer.Start(timeout);
+    me->GetHsm().ResetOutSeq();
+    Evt *evt = new MagnetronStartReq(MAGNETRON, GET_HSMN(), GEN_SEQ());
+    me->GetHsm().SaveOutSeq(*evt);
+    Fw::Post(evt);
+    return QM_ENTRY(&Microwave::Starting_s);
+}
 
-            Evt *evt = new FanOffReq(FAN, GET_HSMN());
-            me->PostSync(evt);
-            evt = new MwLampOffReq(MW_LAMP, GET_HSMN());
-            me->PostSync(evt);
-            evt = new TurntableOffReq(TURNTABLE, GET_HSMN());
-            me->PostSync(evt);
+QState Microwave::Starting_x(Microwave * const me) {
+    EVENT_EXIT(Starting);
+    me->m_stateTimer.Stop();
+    me->GetHsm().ClearInSeq();
+    return QM_EXIT(&Microwave::Starting_s);
+}
 
-            evt = new MagnetronStopReq(MAGNETRON, GET_HSMN(), GEN_SEQ());
-            me->GetHsm().SaveOutSeq(*evt);
-            Fw::Post(evt);
-            return Q_HANDLED();
-            return Q_HANDLED();
-        }
-        case Q_EXIT_SIG: {
-            EVENT(e);
-            me->m_stateTimer.Stop();
-            me->GetHsm().ClearInSeq();
-            me->GetHsm().Recall();
-            return Q_HANDLED();
-        }
+QState Microwave::Stopping(Microwave * const me, QEvt const * const e) {
+    switch (e->sig) {
         case MICROWAVE_STOP_REQ: {
             EVENT(e);
             me->GetHsm().Defer(e);
-            return Q_HANDLED();
+            return QM_HANDLED();
         }
         case MAGNETRON_STOP_CFM: {
             EVENT(e);
@@ -268,39 +498,63 @@ QState Microwave::Stopping(Microwave * const me, QEvt const * const e) {
                 Evt *evt = new Evt(DONE, GET_HSMN());
                 me->PostSync(evt);
             }
-            return Q_HANDLED();
+            return QM_HANDLED();
         }
         case FAILED:
         case STATE_TIMER: {
             EVENT(e);
             FW_ASSERT(0);
             // Will not reach here.
-            return Q_HANDLED();
+            return QM_HANDLED();
         }
         case DONE: {
             EVENT(e);
             Evt *evt = new MicrowaveStopCfm(me->GetHsm().GetInHsmn(), GET_HSMN(), me->GetHsm().GetInSeq(), ERROR_SUCCESS);
             Fw::Post(evt);
-            return Q_TRAN(&Microwave::Stopped);
+            static struct {
+                QMState const *target;
+                QActionHandler act[3];
+            } const tatbl = {
+                &Microwave::Stopped_s,
+                {
+                    Q_ACTION_CAST(&Microwave::Stopping_x),
+                    Q_ACTION_CAST(&Microwave::Stopped_e),
+                    Q_ACTION_CAST(0)
+                }
+            };
+            return QM_TRAN(&tatbl);
         }
     }
-    return Q_SUPER(&Microwave::Root);
+    return QM_SUPER();
+}
+
+QState Microwave::Stopping_e(Microwave * const me) {
+    EVENT_ENTRY(Stopping);
+    uint32_t timeout = MicrowaveStopReq::TIMEOUT_MS;
+    FW_ASSERT(timeout > MagnetronStopReq::TIMEOUT_MS);
+    me->m_stateTimer.Start(timeout);
+    me->GetHsm().ResetOutSeq();
+
+    // A single event reaches the fan, lamp and turntable regions, synchronously as with PostSync().
+    Evt *evt = new MicrowaveOffInd(GET_HSMN());
+    me->PublishSync(evt);
+
+    evt = new MagnetronStopReq(MAGNETRON, GET_HSMN(), GEN_SEQ());
+    me->GetHsm().SaveOutSeq(*evt);
+    Fw::Post(evt);
+    return QM_ENTRY(&Microwave::Stopping_s);
+}
+
+QState Microwave::Stopping_x(Microwave * const me) {
+    EVENT_EXIT(Stopping);
+    me->m_stateTimer.Stop();
+    me->GetHsm().ClearInSeq();
+    me->GetHsm().Recall();
+    return QM_EXIT(&Microwave::Stopping_s);
 }
 
 QState Microwave::Started(Microwave * const me, QEvt const * const e) {
     switch (e->sig) {
-        case Q_ENTRY_SIG: {
-            EVENT(e);
-            return Q_HANDLED();
-        }
-        case Q_EXIT_SIG: {
-            EVENT(e);
-            return Q_HANDLED();
-        }
-        case Q_INIT_SIG: {
-            me->m_halfSecondTimer.Start(HALF_SECOND_TIMEOUT_MS, Timer::PERIODIC);
-            return Q_TRAN(&Microwave::DisplayClock);
-        }
         case HALF_SECOND_TIMER: {
             //EVENT(e);
             if(me->m_clockInitialized && (++me->m_halfSecondCounts == HALF_SECOND_COUNTS_PER_MINUTE)) {
@@ -318,7 +572,7 @@ QState Microwave::Started(Microwave * const me, QEvt const * const e) {
                     me->m_blinkToggle = true;
                 }
             }
-            return Q_HANDLED();
+            return QM_HANDLED();
         }
         case MICROWAVE_EXT_START_SIG: {
             EVENT(e);
@@ -332,7 +586,18 @@ QState Microwave::Started(Microwave * const me, QEvt const * const e) {
                 me->m_cook = true;
             }
             me->SendSignal(MicrowaveMsgFormat::Signal::START);
-            return Q_TRAN(&Microwave::DisplayTimer);
+            static struct {
+                QMState const *target;
+                QActionHandler act[3];
+            } const tatbl = {
+                &Microwave::DisplayTimer_s,
+                {
+                    Q_ACTION_CAST(&Microwave::DisplayTimer_e),
+                    Q_ACTION_CAST(&Microwave::DisplayTimer_i),
+                    Q_ACTION_CAST(0)
+                }
+            };
+            return QM_TRAN(&tatbl);
         }
         case MICROWAVE_EXT_STOP_SIG: {
             EVENT(e);
@@ -346,21 +611,31 @@ QState Microwave::Started(Microwave * const me, QEvt const * const e) {
                 me->m_displayTime[i].powerLevel = MAX_POWER;
             }
             me->SendSignal(MicrowaveMsgFormat::Signal::STOP);
-            return Q_TRAN(&Microwave::DisplayClock);
+            static struct {
+                QMState const *target;
+                QActionHandler act[2];
+            } const tatbl = {
+                &Microwave::DisplayClock_s,
+                {
+                    Q_ACTION_CAST(&Microwave::DisplayClock_e),
+                    Q_ACTION_CAST(0)
+                }
+            };
+            return QM_TRAN(&tatbl);
         }
         case MICROWAVE_EXT_DOOR_OPEN_SIG: {
             EVENT(e);
             me->m_closed = false;
             Evt* evt = new MwLampOnReq(MW_LAMP, GET_HSMN(), GEN_SEQ());
             me->PostSync(evt);
-            return Q_HANDLED();
+            return QM_HANDLED();
         }
         case MICROWAVE_EXT_DOOR_CLOSED_SIG: {
             EVENT(e);
             me->m_closed = true;
             Evt* evt = new MwLampOffReq(MW_LAMP, GET_HSMN(), GEN_SEQ());
             me->PostSync(evt);
-            return Q_HANDLED();
+            return QM_HANDLED();
         }
         case MICROWAVE_WIFI_CONN_REQ: {
             EVENT(e);
@@ -369,42 +644,89 @@ QState Microwave::Started(Microwave * const me, QEvt const * const e) {
             uint16_t port = STRING_TO_NUM(portStr, 0);
             Evt *evt = new WifiConnectReq(WIFI_ST, GET_HSMN(), GEN_SEQ(), host, port);
             Fw::Post(evt);
-            return Q_HANDLED();
+            return QM_HANDLED();
         }
     }
-    return Q_SUPER(&Microwave::Root);
+    return QM_SUPER();
+}
+
+QState Microwave::Started_e(Microwave * const me) {
+    EVENT_ENTRY(Started);
+    return QM_ENTRY(&Microwave::Started_s);
+}
+
+QState Microwave::Started_x(Microwave * const me) {
+    EVENT_EXIT(Started);
+    return QM_EXIT(&Microwave::Started_s);
+}
+
+QState Microwave::Started_i(Microwave * const me) {
+    EVENT_INIT(Started);
+    me->m_halfSecondTimer.Start(HALF_SECOND_TIMEOUT_MS, Timer::PERIODIC);
+    static struct {
+        QMState const *target;
+        QActionHandler act[2];
+    } const tatbl = {
+        &Microwave::DisplayClock_s,
+        {
+            Q_ACTION_CAST(&Microwave::DisplayClock_e),
+            Q_ACTION_CAST(0)
+        }
+    };
+    return QM_TRAN_INIT(&tatbl);
 }
 
 QState Microwave::DisplayClock(Microwave * const me, QEvt const * const e) {
     switch (e->sig) {
-        case Q_ENTRY_SIG: {
-            EVENT(e);
-            me->m_state = MicrowaveMsgFormat::State::DISPLAY_CLOCK;
-            me->UpdateClock(me->m_clockTime);
-            if(me->m_clockInitialized) {
-                me->m_blink = true;
-            }
-            return Q_HANDLED();
-        }
-        case Q_EXIT_SIG: {
-            EVENT(e);
-            me->m_blink = false;
-            return Q_HANDLED();
-        }
         case MICROWAVE_EXT_CLOCK_SIG: {
             EVENT(e);
             me->SendSignal(MicrowaveMsgFormat::Signal::CLOCK);
-            return Q_TRAN(&Microwave::SetClock);
+            static struct {
+                QMState const *target;
+                QActionHandler act[3];
+            } const tatbl = {
+                &Microwave::SetClock_s,
+                {
+                    Q_ACTION_CAST(&Microwave::SetClock_e),
+                    Q_ACTION_CAST(&Microwave::SetClock_i),
+                    Q_ACTION_CAST(0)
+                }
+            };
+            return QM_TRAN(&tatbl);
         }
         case MICROWAVE_EXT_COOK_TIME_SIG: {
             EVENT(e);
             me->SendSignal(MicrowaveMsgFormat::Signal::COOK_TIME);
-            return Q_TRAN(&Microwave::SetCookTimer);
+            static struct {
+                QMState const *target;
+                QActionHandler act[4];
+            } const tatbl = {
+                &Microwave::SetCookTimer_s,
+                {
+                    Q_ACTION_CAST(&Microwave::DisplayClock_x),
+                    Q_ACTION_CAST(&Microwave::SetCookTimer_e),
+                    Q_ACTION_CAST(&Microwave::SetCookTimer_i),
+                    Q_ACTION_CAST(0)
+                }
+            };
+            return QM_TRAN(&tatbl);
         }
         case MICROWAVE_EXT_KITCHEN_TIMER_SIG: {
             EVENT(e);
             me->SendSignal(MicrowaveMsgFormat::Signal::KITCHEN_TIMER);
-            return Q_TRAN(&Microwave::SetKitchenTimer);
+            static struct {
+                QMState const *target;
+                QActionHandler act[4];
+            } const tatbl = {
+                &Microwave::SetKitchenTimer_s,
+                {
+                    Q_ACTION_CAST(&Microwave::DisplayClock_x),
+                    Q_ACTION_CAST(&Microwave::SetKitchenTimer_e),
+                    Q_ACTION_CAST(&Microwave::SetKitchenTimer_i),
+                    Q_ACTION_CAST(0)
+                }
+            };
+            return QM_TRAN(&tatbl);
         }
         case MICROWAVE_EXT_DIGIT_SIG: {
             EVENT(e);
@@ -418,44 +740,57 @@ QState Microwave::DisplayClock(Microwave * const me, QEvt const * const e) {
                 case 3:
                 case 4:
                 case 5:
-                case 6:
+                case 6: {
                     time.left_ones = digit;
                     me->m_cook = true;
                     me->SendSignal(MicrowaveMsgFormat::Signal::START);
-                    return Q_TRAN(&Microwave::DisplayTimer);
+                    static struct {
+                        QMState const *target;
+                        QActionHandler act[4];
+                    } const tatbl = {
+                        &Microwave::DisplayTimer_s,
+                        {
+                            Q_ACTION_CAST(&Microwave::DisplayClock_x),
+                            Q_ACTION_CAST(&Microwave::DisplayTimer_e),
+                            Q_ACTION_CAST(&Microwave::DisplayTimer_i),
+                            Q_ACTION_CAST(0)
+                        }
+                    };
+                    return QM_TRAN(&tatbl);
+                }
                 default:
                     break;
             }
-            return Q_HANDLED();
+            return QM_HANDLED();
         }
         case MICROWAVE_EXT_STATE_REQ_SIG: {
             EVENT(e);
             me->SendState(me->m_state);
             me->UpdateClock(me->m_clockTime);
-            return Q_HANDLED();
+            return QM_HANDLED();
         }
     }
-    return Q_SUPER(&Microwave::Started);
+    return QM_SUPER();
+}
+
+QState Microwave::DisplayClock_e(Microwave * const me) {
+    EVENT_ENTRY(DisplayClock);
+    me->m_state = MicrowaveMsgFormat::State::DISPLAY_CLOCK;
+    me->UpdateClock(me->m_clockTime);
+    if(me->m_clockInitialized) {
+        me->m_blink = true;
+    }
+    return QM_ENTRY(&Microwave::DisplayClock_s);
+}
+
+QState Microwave::DisplayClock_x(Microwave * const me) {
+    EVENT_EXIT(DisplayClock);
+    me->m_blink = false;
+    return QM_EXIT(&Microwave::DisplayClock_s);
 }
 
 QState Microwave::SetClock(Microwave * const me, QEvt const * const e) {
     switch (e->sig) {
-        case Q_ENTRY_SIG: {
-            EVENT(e);
-            me->m_proposedClockTime = me->m_clockTime;
-            me->m_blink = false;
-            me->SendSignal(MicrowaveMsgFormat::Signal::BLINK_ON);
-            me->SendSignal(MicrowaveMsgFormat::Signal::MOD_LEFT_TENS);
-            me->m_blink = true;
-            return Q_HANDLED();
-        }
-        case Q_EXIT_SIG: {
-            EVENT(e);
-            return Q_HANDLED();
-        }
-        case Q_INIT_SIG: {
-            return Q_TRAN(&Microwave::ClockSelectHourTens);
-        }
         case MICROWAVE_EXT_CLOCK_SIG: {
             EVENT(e);
             if(me->m_clockTime != me->m_proposedClockTime) {
@@ -470,7 +805,17 @@ QState Microwave::SetClock(Microwave * const me, QEvt const * const e) {
             me->SendSignal(MicrowaveMsgFormat::Signal::CLOCK);
             me->m_clockInitialized = true;
             me->m_blink = true;
-            return Q_TRAN(&Microwave::DisplayClock);
+            static struct {
+                QMState const *target;
+                QActionHandler act[2];
+            } const tatbl = {
+                &Microwave::DisplayClock_s,
+                {
+                    Q_ACTION_CAST(&Microwave::SetClock_x),
+                    Q_ACTION_CAST(0)
+                }
+            };
+            return QM_TRAN(&tatbl);
         }
         case MICROWAVE_EXT_STOP_SIG: {
             EVENT(e);
@@ -481,37 +826,66 @@ QState Microwave::SetClock(Microwave * const me, QEvt const * const e) {
             if(me->m_clockInitialized) {
                 me->m_blink = true;
             }
-            return Q_TRAN(&Microwave::DisplayClock);
+            static struct {
+                QMState const *target;
+                QActionHandler act[2];
+            } const tatbl = {
+                &Microwave::DisplayClock_s,
+                {
+                    Q_ACTION_CAST(&Microwave::SetClock_x),
+                    Q_ACTION_CAST(0)
+                }
+            };
+            return QM_TRAN(&tatbl);
         }
         case MICROWAVE_EXT_START_SIG: {
             EVENT(e);
             // don't do anything for this event
-            return Q_HANDLED();
+            return QM_HANDLED();
         }
         case MICROWAVE_EXT_STATE_REQ_SIG: {
             EVENT(e);
             me->SendState(me->m_state);
             me->UpdateClock(me->m_proposedClockTime);
-            return Q_HANDLED();
+            return QM_HANDLED();
         }
     }
-    return Q_SUPER(&Microwave::DisplayClock);
+    return QM_SUPER();
+}
+
+QState Microwave::SetClock_e(Microwave * const me) {
+    EVENT_ENTRY(SetClock);
+    me->m_proposedClockTime = me->m_clockTime;
+    me->m_blink = false;
+    me->SendSignal(MicrowaveMsgFormat::Signal::BLINK_ON);
+    me->SendSignal(MicrowaveMsgFormat::Signal::MOD_LEFT_TENS);
+    me->m_blink = true;
+    return QM_ENTRY(&Microwave::SetClock_s);
+}
+
+QState Microwave::SetClock_x(Microwave * const me) {
+    EVENT_EXIT(SetClock);
+    return QM_EXIT(&Microwave::SetClock_s);
+}
+
+QState Microwave::SetClock_i(Microwave * const me) {
+    EVENT_INIT(SetClock);
+    static struct {
+        QMState const *target;
+        QActionHandler act[2];
+    } const tatbl = {
+        &Microwave::ClockSelectHourTens_s,
+        {
+            Q_ACTION_CAST(&Microwave::ClockSelectHourTens_e),
+            Q_ACTION_CAST(0)
+        }
+    };
+    return QM_TRAN_INIT(&tatbl);
 }
 
 QState Microwave::ClockSelectHourTens(Microwave * const me, QEvt const * const e) {
     MicrowaveMsgFormat::Time &time = me->m_proposedClockTime;
     switch (e->sig) {
-        case Q_ENTRY_SIG: {
-            EVENT(e);
-            me->m_state = MicrowaveMsgFormat::State::CLOCK_SELECT_HOUR_TENS;
-            return Q_HANDLED();
-        }
-        case Q_EXIT_SIG: {
-            EVENT(e);
-            me->UpdateClock(me->m_proposedClockTime);
-            me->SendSignal(MicrowaveMsgFormat::Signal::MOD_LEFT_ONES);
-            return Q_HANDLED();
-        }
         case MICROWAVE_EXT_DIGIT_SIG: {
             EVENT(e);
             MicrowaveExtDigitSig const &req = static_cast<MicrowaveExtDigitSig const &>(*e);
@@ -519,32 +893,46 @@ QState Microwave::ClockSelectHourTens(Microwave * const me, QEvt const * const e
 
             switch(digit) {
                 case 0:
-                case 1:
+                case 1: {
                     time.left_tens = digit;
-                    return Q_TRAN(&Microwave::ClockSelectHourOnes);
+                    static struct {
+                        QMState const *target;
+                        QActionHandler act[3];
+                    } const tatbl = {
+                        &Microwave::ClockSelectHourOnes_s,
+                        {
+                            Q_ACTION_CAST(&Microwave::ClockSelectHourTens_x),
+                            Q_ACTION_CAST(&Microwave::ClockSelectHourOnes_e),
+                            Q_ACTION_CAST(0)
+                        }
+                    };
+                    return QM_TRAN(&tatbl);
+                }
                 default:
                     break;
             }
-            return Q_HANDLED();
+            return QM_HANDLED();
         }
     }
-    return Q_SUPER(&Microwave::SetClock);
+    return QM_SUPER();
+}
+
+QState Microwave::ClockSelectHourTens_e(Microwave * const me) {
+    EVENT_ENTRY(ClockSelectHourTens);
+    me->m_state = MicrowaveMsgFormat::State::CLOCK_SELECT_HOUR_TENS;
+    return QM_ENTRY(&Microwave::ClockSelectHourTens_s);
+}
+
+QState Microwave::ClockSelectHourTens_x(Microwave * const me) {
+    EVENT_EXIT(ClockSelectHourTens);
+    me->UpdateClock(me->m_proposedClockTime);
+    me->SendSignal(MicrowaveMsgFormat::Signal::MOD_LEFT_ONES);
+    return QM_EXIT(&Microwave::ClockSelectHourTens_s);
 }
 
 QState Microwave::ClockSelectHourOnes(Microwave * const me, QEvt const * const e) {
     MicrowaveMsgFormat::Time &time = me->m_proposedClockTime;
     switch (e->sig) {
-        case Q_ENTRY_SIG: {
-            EVENT(e);
-            me->m_state = MicrowaveMsgFormat::State::CLOCK_SELECT_HOUR_TENS;
-            return Q_HANDLED();
-        }
-        case Q_EXIT_SIG: {
-            EVENT(e);
-            me->UpdateClock(me->m_proposedClockTime);
-            me->SendSignal(MicrowaveMsgFormat::Signal::MOD_RIGHT_TENS);
-            return Q_HANDLED();
-        }
         case MICROWAVE_EXT_DIGIT_SIG: {
             EVENT(e);
             MicrowaveExtDigitSig const &req = static_cast<MicrowaveExtDigitSig const &>(*e);
@@ -553,9 +941,21 @@ QState Microwave::ClockSelectHourOnes(Microwave * const me, QEvt const * const e
             switch(digit) {
                 case 0:
                 case 1:
-                case 2:
+                case 2: {
                     time.left_ones = digit;
-                    return Q_TRAN(&Microwave::ClockSelectMinuteTens);
+                    static struct {
+                        QMState const *target;
+                        QActionHandler act[3];
+                    } const tatbl = {
+                        &Microwave::ClockSelectMinuteTens_s,
+                        {
+                            Q_ACTION_CAST(&Microwave::ClockSelectHourOnes_x),
+                            Q_ACTION_CAST(&Microwave::ClockSelectMinuteTens_e),
+                            Q_ACTION_CAST(0)
+                        }
+                    };
+                    return QM_TRAN(&tatbl);
+                }
                 case 3:
                 case 4:
                 case 5:
@@ -565,31 +965,44 @@ QState Microwave::ClockSelectHourOnes(Microwave * const me, QEvt const * const e
                 case 9:
                     if(0 == time.left_tens) {
                         time.left_ones = digit;
-                        return Q_TRAN(&Microwave::ClockSelectMinuteTens);
+                        static struct {
+                            QMState const *target;
+                            QActionHandler act[3];
+                        } const tatbl = {
+                            &Microwave::ClockSelectMinuteTens_s,
+                            {
+                                Q_ACTION_CAST(&Microwave::ClockSelectHourOnes_x),
+                                Q_ACTION_CAST(&Microwave::ClockSelectMinuteTens_e),
+                                Q_ACTION_CAST(0)
+                            }
+                        };
+                        return QM_TRAN(&tatbl);
                     }
                 default:
                     break;
             }
-            return Q_HANDLED();
+            return QM_HANDLED();
         }
     }
-    return Q_SUPER(&Microwave::SetClock);
+    return QM_SUPER();
+}
+
+QState Microwave::ClockSelectHourOnes_e(Microwave * const me) {
+    EVENT_ENTRY(ClockSelectHourOnes);
+    me->m_state = MicrowaveMsgFormat::State::CLOCK_SELECT_HOUR_TENS;
+    return QM_ENTRY(&Microwave::ClockSelectHourOnes_s);
+}
+
+QState Microwave::ClockSelectHourOnes_x(Microwave * const me) {
+    EVENT_EXIT(ClockSelectHourOnes);
+    me->UpdateClock(me->m_proposedClockTime);
+    me->SendSignal(MicrowaveMsgFormat::Signal::MOD_RIGHT_TENS);
+    return QM_EXIT(&Microwave::ClockSelectHourOnes_s);
 }
 
 QState Microwave::ClockSelectMinuteTens(Microwave * const me, QEvt const * const e) {
     MicrowaveMsgFormat::Time &time = me->m_proposedClockTime;
     switch (e->sig) {
-        case Q_ENTRY_SIG: {
-            EVENT(e);
-            me->m_state = MicrowaveMsgFormat::State::CLOCK_SELECT_MINUTE_TENS;
-            return Q_HANDLED();
-        }
-        case Q_EXIT_SIG: {
-            EVENT(e);
-            me->UpdateClock(me->m_proposedClockTime);
-            me->SendSignal(MicrowaveMsgFormat::Signal::MOD_RIGHT_ONES);
-            return Q_HANDLED();
-        }
         case MICROWAVE_EXT_DIGIT_SIG: {
             EVENT(e);
             MicrowaveExtDigitSig const &req = static_cast<MicrowaveExtDigitSig const &>(*e);
@@ -601,32 +1014,46 @@ QState Microwave::ClockSelectMinuteTens(Microwave * const me, QEvt const * const
                 case 2:
                 case 3:
                 case 4:
-                case 5:
+                case 5: {
                     time.right_tens = digit;
-                    return Q_TRAN(&Microwave::ClockSelectMinuteOnes);
+                    static struct {
+                        QMState const *target;
+                        QActionHandler act[3];
+                    } const tatbl = {
+                        &Microwave::ClockSelectMinuteOnes_s,
+                        {
+                            Q_ACTION_CAST(&Microwave::ClockSelectMinuteTens_x),
+                            Q_ACTION_CAST(&Microwave::ClockSelectMinuteOnes_e),
+                            Q_ACTION_CAST(0)
+                        }
+                    };
+                    return QM_TRAN(&tatbl);
+                }
                 default:
                     break;
             }
-            return Q_HANDLED();
+            return QM_HANDLED();
         }
     }
-    return Q_SUPER(&Microwave::SetClock);
+    return QM_SUPER();
+}
+
+QState Microwave::ClockSelectMinuteTens_e(Microwave * const me) {
+    EVENT_ENTRY(ClockSelectMinuteTens);
+    me->m_state = MicrowaveMsgFormat::State::CLOCK_SELECT_MINUTE_TENS;
+    return QM_ENTRY(&Microwave::ClockSelectMinuteTens_s);
+}
+
+QState Microwave::ClockSelectMinuteTens_x(Microwave * const me) {
+    EVENT_EXIT(ClockSelectMinuteTens);
+    me->UpdateClock(me->m_proposedClockTime);
+    me->SendSignal(MicrowaveMsgFormat::Signal::MOD_RIGHT_ONES);
+    return QM_EXIT(&Microwave::ClockSelectMinuteTens_s);
 }
 
 QState Microwave::ClockSelectMinuteOnes(Microwave * const me, QEvt const * const e) {
     MicrowaveMsgFormat::Time &time = me->m_proposedClockTime;
     switch (e->sig) {
-        case Q_ENTRY_SIG: {
-            EVENT(e);
-            me->m_state = MicrowaveMsgFormat::State::CLOCK_SELECT_MINUTE_ONES;
-            return Q_HANDLED();
-        }
-        case Q_EXIT_SIG: {
-            EVENT(e);
-            me->UpdateClock(me->m_proposedClockTime);
-            me->SendSignal(MicrowaveMsgFormat::Signal::MOD_LEFT_TENS);
-            return Q_HANDLED();
-        }
         case MICROWAVE_EXT_DIGIT_SIG: {
             EVENT(e);
             MicrowaveExtDigitSig const &req = static_cast<MicrowaveExtDigitSig const &>(*e);
@@ -642,63 +1069,104 @@ QState Microwave::ClockSelectMinuteOnes(Microwave * const me, QEvt const * const
                 case 6:
                 case 7:
                 case 8:
-                case 9:
+                case 9: {
                     time.right_ones = digit;
-                    return Q_TRAN(&Microwave::ClockSelectHourTens);
+                    static struct {
+                        QMState const *target;
+                        QActionHandler act[3];
+                    } const tatbl = {
+                        &Microwave::ClockSelectHourTens_s,
+                        {
+                            Q_ACTION_CAST(&Microwave::ClockSelectMinuteOnes_x),
+                            Q_ACTION_CAST(&Microwave::ClockSelectHourTens_e),
+                            Q_ACTION_CAST(0)
+                        }
+                    };
+                    return QM_TRAN(&tatbl);
+                }
                 default:
                     break;
             }
-            return Q_HANDLED();
+            return QM_HANDLED();
         }
     }
-    return Q_SUPER(&Microwave::SetClock);
+    return QM_SUPER();
+}
+
+QState Microwave::ClockSelectMinuteOnes_e(Microwave * const me) {
+    EVENT_ENTRY(ClockSelectMinuteOnes);
+    me->m_state = MicrowaveMsgFormat::State::CLOCK_SELECT_MINUTE_ONES;
+    return QM_ENTRY(&Microwave::ClockSelectMinuteOnes_s);
+}
+
+QState Microwave::ClockSelectMinuteOnes_x(Microwave * const me) {
+    EVENT_EXIT(ClockSelectMinuteOnes);
+    me->UpdateClock(me->m_proposedClockTime);
+    me->SendSignal(MicrowaveMsgFormat::Signal::MOD_LEFT_TENS);
+    return QM_EXIT(&Microwave::ClockSelectMinuteOnes_s);
 }
 
 QState Microwave::SetCookTimer(Microwave * const me, QEvt const * const e) {
     switch (e->sig) {
-        case Q_ENTRY_SIG: {
-            EVENT(e);
-            me->m_state = MicrowaveMsgFormat::State::SET_COOK_TIMER;
-            me->m_displayTime[me->m_timerIndex].time.clear();
-            me->UpdateDisplayTime();
-            me->UpdatePowerLevel();
-            ++me->m_timersUsed;
-            return Q_HANDLED();
-        }
-        case Q_EXIT_SIG: {
-            EVENT(e);
-            return Q_HANDLED();
-        }
-        case Q_INIT_SIG: {
-            return Q_TRAN(&Microwave::SetCookTimerInitial);
-        }
         case MICROWAVE_EXT_POWER_LEVEL_SIG: {
             EVENT(e);
             me->SendSignal(MicrowaveMsgFormat::Signal::POWER_LEVEL);
-            return Q_TRAN(&Microwave::SetPowerLevel);
+            static struct {
+                QMState const *target;
+                QActionHandler act[3];
+            } const tatbl = {
+                &Microwave::SetPowerLevel_s,
+                {
+                    Q_ACTION_CAST(&Microwave::SetCookTimer_x),
+                    Q_ACTION_CAST(&Microwave::SetPowerLevel_e),
+                    Q_ACTION_CAST(0)
+                }
+            };
+            return QM_TRAN(&tatbl);
         }
         case MICROWAVE_EXT_STATE_REQ_SIG: {
             EVENT(e);
             me->SendState(me->m_state);
             me->UpdateDisplayTime();
-            return Q_HANDLED();
+            return QM_HANDLED();
         }
     }
-    return Q_SUPER(&Microwave::Started);
+    return QM_SUPER();
+}
+
+QState Microwave::SetCookTimer_e(Microwave * const me) {
+    EVENT_ENTRY(SetCookTimer);
+    me->m_state = MicrowaveMsgFormat::State::SET_COOK_TIMER;
+    me->m_displayTime[me->m_timerIndex].time.clear();
+    me->UpdateDisplayTime();
+    me->UpdatePowerLevel();
+    ++me->m_timersUsed;
+    return QM_ENTRY(&Microwave::SetCookTimer_s);
+}
+
+QState Microwave::SetCookTimer_x(Microwave * const me) {
+    EVENT_EXIT(SetCookTimer);
+    return QM_EXIT(&Microwave::SetCookTimer_s);
+}
+
+QState Microwave::SetCookTimer_i(Microwave * const me) {
+    EVENT_INIT(SetCookTimer);
+    static struct {
+        QMState const *target;
+        QActionHandler act[2];
+    } const tatbl = {
+        &Microwave::SetCookTimerInitial_s,
+        {
+            Q_ACTION_CAST(&Microwave::SetCookTimerInitial_e),
+            Q_ACTION_CAST(0)
+        }
+    };
+    return QM_TRAN_INIT(&tatbl);
 }
 
 QState Microwave::SetCookTimerInitial(Microwave * const me, QEvt const * const e) {
     MicrowaveMsgFormat::Time &time = me->m_displayTime[me->m_timerIndex].time;
     switch (e->sig) {
-        case Q_ENTRY_SIG: {
-            EVENT(e);
-            return Q_HANDLED();
-        }
-        case Q_EXIT_SIG: {
-            EVENT(e);
-            me->UpdateDisplayTime();
-            return Q_HANDLED();
-        }
         case MICROWAVE_EXT_DIGIT_SIG: {
             EVENT(e);
             MicrowaveExtDigitSig const &req = static_cast<MicrowaveExtDigitSig const &>(*e);
@@ -713,33 +1181,48 @@ QState Microwave::SetCookTimerInitial(Microwave * const me, QEvt const * const e
                 case 6:
                 case 7:
                 case 8:
-                case 9:
+                case 9: {
                     time.right_ones = digit;
-                    return Q_TRAN(&Microwave::SetCookTimerFinal);
+                    static struct {
+                        QMState const *target;
+                        QActionHandler act[3];
+                    } const tatbl = {
+                        &Microwave::SetCookTimerFinal_s,
+                        {
+                            Q_ACTION_CAST(&Microwave::SetCookTimerInitial_x),
+                            Q_ACTION_CAST(&Microwave::SetCookTimerFinal_e),
+                            Q_ACTION_CAST(0)
+                        }
+                    };
+                    return QM_TRAN(&tatbl);
+                }
                 default:
                     break;
             }
-            return Q_HANDLED();
+            return QM_HANDLED();
         }
         case MICROWAVE_EXT_START_SIG: {
             //ignore this event
-            return Q_HANDLED();
+            return QM_HANDLED();
         }
     }
-    return Q_SUPER(&Microwave::SetCookTimer);
+    return QM_SUPER();
+}
+
+QState Microwave::SetCookTimerInitial_e(Microwave * const me) {
+    EVENT_ENTRY(SetCookTimerInitial);
+    return QM_ENTRY(&Microwave::SetCookTimerInitial_s);
+}
+
+QState Microwave::SetCookTimerInitial_x(Microwave * const me) {
+    EVENT_EXIT(SetCookTimerInitial);
+    me->UpdateDisplayTime();
+    return QM_EXIT(&Microwave::SetCookTimerInitial_s);
 }
 
 QState Microwave::SetCookTimerFinal(Microwave * const me, QEvt const * const e) {
     MicrowaveMsgFormat::Time &time = me->m_displayTime[me->m_timerIndex].time;
     switch (e->sig) {
-        case Q_ENTRY_SIG: {
-            EVENT(e);
-            return Q_HANDLED();
-        }
-        case Q_EXIT_SIG: {
-            EVENT(e);
-            return Q_HANDLED();
-        }
         case MICROWAVE_EXT_DIGIT_SIG: {
             EVENT(e);
             MicrowaveExtDigitSig const &req = static_cast<MicrowaveExtDigitSig const &>(*e);
@@ -761,33 +1244,45 @@ QState Microwave::SetCookTimerFinal(Microwave * const me, QEvt const * const e)
                 default:
                     break;
             }
-            return Q_HANDLED();
+            return QM_HANDLED();
         }
     }
-    return Q_SUPER(&Microwave::SetCookTimer);
+    return QM_SUPER();
+}
+
+QState Microwave::SetCookTimerFinal_e(Microwave * const me) {
+    EVENT_ENTRY(SetCookTimerFinal);
+    return QM_ENTRY(&Microwave::SetCookTimerFinal_s);
+}
+
+QState Microwave::SetCookTimerFinal_x(Microwave * const me) {
+    EVENT_EXIT(SetCookTimerFinal);
+    return QM_EXIT(&Microwave::SetCookTimerFinal_s);
 }
 
 QState Microwave::SetPowerLevel(Microwave * const me, QEvt const * const e) {
     uint32_t &powerLevel = me->m_displayTime[me->m_timerIndex].powerLevel;
     switch (e->sig) {
-        case Q_ENTRY_SIG: {
-            EVENT(e);
-            me->m_blink = true;
-            return Q_HANDLED();
-        }
-        case Q_EXIT_SIG: {
-            EVENT(e);
-            me->m_blink = false;
-            return Q_HANDLED();
-        }
         case MICROWAVE_EXT_COOK_TIME_SIG: {
             EVENT(e);
             if(me->m_timersUsed < MAX_COOK_TIMERS) {
                 me->m_timerIndex = (me->m_timerIndex + 1) % MAX_COOK_TIMERS;
                 me->SendSignal(MicrowaveMsgFormat::Signal::COOK_TIME);
-                return Q_TRAN(&Microwave::SetCookTimer);
+                static struct {
+                    QMState const *target;
+                    QActionHandler act[4];
+                } const tatbl = {
+                    &Microwave::SetCookTimer_s,
+                    {
+                        Q_ACTION_CAST(&Microwave::SetPowerLevel_x),
+                        Q_ACTION_CAST(&Microwave::SetCookTimer_e),
+                        Q_ACTION_CAST(&Microwave::SetCookTimer_i),
+                        Q_ACTION_CAST(0)
+                    }
+                };
+                return QM_TRAN(&tatbl);
             }
-            return Q_HANDLED();
+            return QM_HANDLED();
         }
         case MICROWAVE_EXT_DIGIT_SIG: {
             EVENT(e);
@@ -818,62 +1313,77 @@ QState Microwave::SetPowerLevel(Microwave * const me, QEvt const * const e) {
                 default:
                     break;
             }
-            return Q_HANDLED();
+            return QM_HANDLED();
         }
         case MICROWAVE_EXT_STATE_REQ_SIG: {
             EVENT(e);
             me->SendState(me->m_state);
             me->UpdatePowerLevel();
-            return Q_HANDLED();
+            return QM_HANDLED();
         }
     }
-    return Q_SUPER(&Microwave::Started);
+    return QM_SUPER();
+}
+
+QState Microwave::SetPowerLevel_e(Microwave * const me) {
+    EVENT_ENTRY(SetPowerLevel);
+    me->m_blink = true;
+    return QM_ENTRY(&Microwave::SetPowerLevel_s);
+}
+
+QState Microwave::SetPowerLevel_x(Microwave * const me) {
+    EVENT_EXIT(SetPowerLevel);
+    me->m_blink = false;
+    return QM_EXIT(&Microwave::SetPowerLevel_s);
 }
 
 QState Microwave::SetKitchenTimer(Microwave * const me, QEvt const * const e) {
     switch (e->sig) {
-        case Q_ENTRY_SIG: {
-            EVENT(e);
-            me->m_displayTime[me->m_timerIndex].time.clear();
-            ++me->m_timersUsed;
-            
-            me->UpdateDisplayTime();
-            me->SendSignal(MicrowaveMsgFormat::Signal::MOD_LEFT_TENS);
-            me->m_blink = true;
-            return Q_HANDLED();
-        }
-        case Q_EXIT_SIG: {
-            EVENT(e);
-            me->m_blink = false;
-            return Q_HANDLED();
-        }
-        case Q_INIT_SIG: {
-            return Q_TRAN(&Microwave::KitchenSelectHourTens);
-        }
         case MICROWAVE_EXT_STATE_REQ_SIG: {
             EVENT(e);
             me->SendState(me->m_state);
             me->UpdateDisplayTime();
-            return Q_HANDLED();
+            return QM_HANDLED();
         }
     }
-    return Q_SUPER(&Microwave::Started);
+    return QM_SUPER();
+}
+
+QState Microwave::SetKitchenTimer_e(Microwave * const me) {
+    EVENT_ENTRY(SetKitchenTimer);
+    me->m_displayTime[me->m_timerIndex].time.clear();
+    ++me->m_timersUsed;
+    
+    me->UpdateDisplayTime();
+    me->SendSignal(MicrowaveMsgFormat::Signal::MOD_LEFT_TENS);
+    me->m_blink = true;
+    return QM_ENTRY(&Microwave::SetKitchenTimer_s);
+}
+
+QState Microwave::SetKitchenTimer_x(Microwave * const me) {
+    EVENT_EXIT(SetKitchenTimer);
+    me->m_blink = false;
+    return QM_EXIT(&Microwave::SetKitchenTimer_s);
+}
+
+QState Microwave::SetKitchenTimer_i(Microwave * const me) {
+    EVENT_INIT(SetKitchenTimer);
+    static struct {
+        QMState const *target;
+        QActionHandler act[2];
+    } const tatbl = {
+        &Microwave::KitchenSelectHourTens_s,
+        {
+            Q_ACTION_CAST(&Microwave::KitchenSelectHourTens_e),
+            Q_ACTION_CAST(0)
+        }
+    };
+    return QM_TRAN_INIT(&tatbl);
 }
 
 QState Microwave::KitchenSelectHourTens(Microwave * const me, QEvt const * const e) {
     MicrowaveMsgFormat::Time &time = me->m_displayTime[me->m_timerIndex].time;
     switch (e->sig) {
-        case Q_ENTRY_SIG: {
-            EVENT(e);
-            me->m_state = MicrowaveMsgFormat::State::KITCHEN_SELECT_HOUR_TENS;
-            return Q_HANDLED();
-        }
-        case Q_EXIT_SIG: {
-            EVENT(e);
-            me->UpdateDisplayTime();
-            me->SendSignal(MicrowaveMsgFormat::Signal::MOD_LEFT_ONES);
-            return Q_HANDLED();
-        }
         case MICROWAVE_EXT_DIGIT_SIG: {
             EVENT(e);
             MicrowaveExtDigitSig const &req = static_cast<MicrowaveExtDigitSig const &>(*e);
@@ -889,32 +1399,46 @@ QState Microwave::KitchenSelectHourTens(Microwave * const me, QEvt const * const
                 case 6:
                 case 7:
                 case 8:
-                case 9:
+                case 9: {
                     time.left_tens = digit;
-                    return Q_TRAN(&Microwave::KitchenSelectHourOnes);
+                    static struct {
+                        QMState const *target;
+                        QActionHandler act[3];
+                    } const tatbl = {
+                        &Microwave::KitchenSelectHourOnes_s,
+                        {
+                            Q_ACTION_CAST(&Microwave::KitchenSelectHourTens_x),
+                            Q_ACTION_CAST(&Microwave::KitchenSelectHourOnes_e),
+                            Q_ACTION_CAST(0)
+                        }
+                    };
+                    return QM_TRAN(&tatbl);
+                }
                 default:
                     break;
             }
-            return Q_HANDLED();
+            return QM_HANDLED();
         }
     }
-    return Q_SUPER(&Microwave::SetKitchenTimer);
+    return QM_SUPER();
+}
+
+QState Microwave::KitchenSelectHourTens_e(Microwave * const me) {
+    EVENT_ENTRY(KitchenSelectHourTens);
+    me->m_state = MicrowaveMsgFormat::State::KITCHEN_SELECT_HOUR_TENS;
+    return QM_ENTRY(&Microwave::KitchenSelectHourTens_s);
+}
+
+QState Microwave::KitchenSelectHourTens_x(Microwave * const me) {
+    EVENT_EXIT(KitchenSelectHourTens);
+    me->UpdateDisplayTime();
+    me->SendSignal(MicrowaveMsgFormat::Signal::MOD_LEFT_ONES);
+    return QM_EXIT(&Microwave::KitchenSelectHourTens_s);
 }
 
 QState Microwave::KitchenSelectHourOnes(Microwave * const me, QEvt const * const e) {
     MicrowaveMsgFormat::Time &time = me->m_displayTime[me->m_timerIndex].time;
     switch (e->sig) {
-        case Q_ENTRY_SIG: {
-            EVENT(e);
-            me->m_state = MicrowaveMsgFormat::State::KITCHEN_SELECT_HOUR_ONES;
-            return Q_HANDLED();
-        }
-        case Q_EXIT_SIG: {
-            EVENT(e);
-            me->UpdateDisplayTime();
-            me->SendSignal(MicrowaveMsgFormat::Signal::MOD_RIGHT_TENS);
-            return Q_HANDLED();
-        }
         case MICROWAVE_EXT_DIGIT_SIG: {
             EVENT(e);
             MicrowaveExtDigitSig const &req = static_cast<MicrowaveExtDigitSig const &>(*e);
@@ -930,32 +1454,46 @@ QState Microwave::KitchenSelectHourOnes(Microwave * const me, QEvt const * const
                 case 6:
                 case 7:
                 case 8:
-                case 9:
+                case 9: {
                     time.left_ones = digit;
-                    return Q_TRAN(&Microwave::KitchenSelectMinuteTens);
+                    static struct {
+                        QMState const *target;
+                        QActionHandler act[3];
+                    } const tatbl = {
+                        &Microwave::KitchenSelectMinuteTens_s,
+                        {
+                            Q_ACTION_CAST(&Microwave::KitchenSelectHourOnes_x),
+                            Q_ACTION_CAST(&Microwave::KitchenSelectMinuteTens_e),
+                            Q_ACTION_CAST(0)
+                        }
+                    };
+                    return QM_TRAN(&tatbl);
+                }
                 default:
                     break;
             }
-            return Q_HANDLED();
+            return QM_HANDLED();
         }
     }
-    return Q_SUPER(&Microwave::SetKitchenTimer);
+    return QM_SUPER();
+}
+
+QState Microwave::KitchenSelectHourOnes_e(Microwave * const me) {
+    EVENT_ENTRY(KitchenSelectHourOnes);
+    me->m_state = MicrowaveMsgFormat::State::KITCHEN_SELECT_HOUR_ONES;
+    return QM_ENTRY(&Microwave::KitchenSelectHourOnes_s);
+}
+
+QState Microwave::KitchenSelectHourOnes_x(Microwave * const me) {
+    EVENT_EXIT(KitchenSelectHourOnes);
+    me->UpdateDisplayTime();
+    me->SendSignal(MicrowaveMsgFormat::Signal::MOD_RIGHT_TENS);
+    return QM_EXIT(&Microwave::KitchenSelectHourOnes_s);
 }
 
 QState Microwave::KitchenSelectMinuteTens(Microwave * const me, QEvt const * const e) {
     MicrowaveMsgFormat::Time &time = me->m_displayTime[me->m_timerIndex].time;
     switch (e->sig) {
-        case Q_ENTRY_SIG: {
-            EVENT(e);
-            me->m_state = MicrowaveMsgFormat::State::KITCHEN_SELECT_MINUTE_TENS;
-            return Q_HANDLED();
-        }
-        case Q_EXIT_SIG: {
-            EVENT(e);
-            me->UpdateDisplayTime();
-            me->SendSignal(MicrowaveMsgFormat::Signal::MOD_RIGHT_ONES);
-            return Q_HANDLED();
-        }
         case MICROWAVE_EXT_DIGIT_SIG: {
             EVENT(e);
             MicrowaveExtDigitSig const &req = static_cast<MicrowaveExtDigitSig const &>(*e);
@@ -971,32 +1509,46 @@ QState Microwave::KitchenSelectMinuteTens(Microwave * const me, QEvt const * con
                 case 6:
                 case 7:
                 case 8:
-                case 9:
+                case 9: {
                     time.right_tens = digit;
-                    return Q_TRAN(&Microwave::KitchenSelectMinuteOnes);
+                    static struct {
+                        QMState const *target;
+                        QActionHandler act[3];
+                    } const tatbl = {
+                        &Microwave::KitchenSelectMinuteOnes_s,
+                        {
+                            Q_ACTION_CAST(&Microwave::KitchenSelectMinuteTens_x),
+                            Q_ACTION_CAST(&Microwave::KitchenSelectMinuteOnes_e),
+                            Q_ACTION_CAST(0)
+                        }
+                    };
+                    return QM_TRAN(&tatbl);
+                }
                 default:
                     break;
             }
-            return Q_HANDLED();
+            return QM_HANDLED();
         }
     }
-    return Q_SUPER(&Microwave::SetKitchenTimer);
+    return QM_SUPER();
+}
+
+QState Microwave::KitchenSelectMinuteTens_e(Microwave * const me) {
+    EVENT_ENTRY(KitchenSelectMinuteTens);
+    me->m_state = MicrowaveMsgFormat::State::KITCHEN_SELECT_MINUTE_TENS;
+    return QM_ENTRY(&Microwave::KitchenSelectMinuteTens_s);
+}
+
+QState Microwave::KitchenSelectMinuteTens_x(Microwave * const me) {
+    EVENT_EXIT(KitchenSelectMinuteTens);
+    me->UpdateDisplayTime();
+    me->SendSignal(MicrowaveMsgFormat::Signal::MOD_RIGHT_ONES);
+    return QM_EXIT(&Microwave::KitchenSelectMinuteTens_s);
 }
 
 QState Microwave::KitchenSelectMinuteOnes(Microwave * const me, QEvt const * const e) {
     MicrowaveMsgFormat::Time& time = me->m_displayTime[me->m_timerIndex].time;
     switch (e->sig) {
-        case Q_ENTRY_SIG: {
-            EVENT(e);
-            me->m_state = MicrowaveMsgFormat::State::KITCHEN_SELECT_MINUTE_ONES;
-            return Q_HANDLED();
-        }
-        case Q_EXIT_SIG: {
-            EVENT(e);
-            me->UpdateDisplayTime();
-            me->SendSignal(MicrowaveMsgFormat::Signal::MOD_LEFT_TENS);
-            return Q_HANDLED();
-        }
         case MICROWAVE_EXT_DIGIT_SIG: {
             EVENT(e);
             MicrowaveExtDigitSig const &req = static_cast<MicrowaveExtDigitSig const &>(*e);
@@ -1012,127 +1564,135 @@ QState Microwave::KitchenSelectMinuteOnes(Microwave * const me, QEvt const * con
                 case 6:
                 case 7:
                 case 8:
-                case 9:
+                case 9: {
                     time.right_ones = digit;
-                    return Q_TRAN(&Microwave::KitchenSelectHourTens);
+                    static struct {
+                        QMState const *target;
+                        QActionHandler act[3];
+                    } const tatbl = {
+                        &Microwave::KitchenSelectHourTens_s,
+                        {
+                            Q_ACTION_CAST(&Microwave::KitchenSelectMinuteOnes_x),
+                            Q_ACTION_CAST(&Microwave::KitchenSelectHourTens_e),
+                            Q_ACTION_CAST(0)
+                        }
+                    };
+                    return QM_TRAN(&tatbl);
+                }
                 default:
                     break;
             }
-            return Q_HANDLED();
+            return QM_HANDLED();
         }
     }
-    return Q_SUPER(&Microwave::SetKitchenTimer);
+    return QM_SUPER();
+}
+
+QState Microwave::KitchenSelectMinuteOnes_e(Microwave * const me) {
+    EVENT_ENTRY(KitchenSelectMinuteOnes);
+    me->m_state = MicrowaveMsgFormat::State::KITCHEN_SELECT_MINUTE_ONES;
+    return QM_ENTRY(&Microwave::KitchenSelectMinuteOnes_s);
+}
+
+QState Microwave::KitchenSelectMinuteOnes_x(Microwave * const me) {
+    EVENT_EXIT(KitchenSelectMinuteOnes);
+    me->UpdateDisplayTime();
+    me->SendSignal(MicrowaveMsgFormat::Signal::MOD_LEFT_TENS);
+    return QM_EXIT(&Microwave::KitchenSelectMinuteOnes_s);
 }
 
 QState Microwave::DisplayTimer(Microwave * const me, QEvt const * const e) {
     switch (e->sig) {
-        case Q_ENTRY_SIG: {
-            EVENT(e);
-            me->m_state = MicrowaveMsgFormat::State::DISPLAY_TIMER;
-            me->m_timerIndex = 0;
-            me->m_secondsRemaining = me->Time2Seconds(me->m_displayTime[me->m_timerIndex].time);
-            return Q_HANDLED();
-        }
-        case Q_EXIT_SIG: {
-            EVENT(e);
-            //NOTE: The Magnetron gets requested to turn off when m_secondsRemaining
-            //      goes to zero within Microwave::DecrementTimer(); if the user presses STOP when
-            //      the microwave is in the DisplayTimerPaused state then the magnetron needs to be
-            //      explicitly turned off.
-            if(me->m_secondsRemaining > 0 && me->m_cook) {
-                Evt* evt = new MagnetronOffReq(MAGNETRON, GET_HSMN(), GEN_SEQ());
-                Fw::Post(evt);
-            }
-
-            //reset the cook flag
-            me->m_cook = false;
-            //incase the stop button was pressed to cancel the timer, reset seconds remaining
-            me->m_secondsRemaining = 0;
-            me->m_timerIndex = 0;
-            //reset power levels
-            for(int i = 0; i < MAX_COOK_TIMERS; ++i) {
-                me->m_displayTime[i].powerLevel = MAX_POWER;
-            }
-            return Q_HANDLED();
-        }
-        case Q_INIT_SIG: {
-            return Q_TRAN(&Microwave::DisplayTimerRunning);
-        }
         case MICROWAVE_EXT_START_SIG: {
             EVENT(e);
             if(me->m_cooking) {
                 me->Add30SecondsToCookTime();    
                 me->UpdateDisplayTime();
             }
-            return Q_HANDLED();
+            return QM_HANDLED();
         }
         case MICROWAVE_EXT_STATE_REQ_SIG: {
             EVENT(e);
             me->SendState(me->m_state);
             me->UpdateDisplayTime();
             me->UpdatePowerLevel();
-            return Q_HANDLED();
+            return QM_HANDLED();
         }
         case MICROWAVE_EXT_POWER_LEVEL_SIG: {
             EVENT(e);
             if(me->m_cook) {
                 me->SendSignal(MicrowaveMsgFormat::Signal::POWER_LEVEL);
             }
-            return Q_HANDLED();
+            return QM_HANDLED();
         }
         case DONE: {
             EVENT(e);
             me->SendSignal(MicrowaveMsgFormat::Signal::CLOCK);
-            return Q_TRAN(&Microwave::DisplayClock);
+            static struct {
+                QMState const *target;
+                QActionHandler act[3];
+            } const tatbl = {
+                &Microwave::DisplayClock_s,
+                {
+                    Q_ACTION_CAST(&Microwave::DisplayTimer_x),
+                    Q_ACTION_CAST(&Microwave::DisplayClock_e),
+                    Q_ACTION_CAST(0)
+                }
+            };
+            return QM_TRAN(&tatbl);
         }
     }
-    return Q_SUPER(&Microwave::Started);
+    return QM_SUPER();
 }
 
-QState Microwave::DisplayTimerRunning(Microwave * const me, QEvt const * const e) {
-    switch (e->sig) {
-        case Q_ENTRY_SIG: {
-            EVENT(e);
-            me->m_secondTimer.Start(SECOND_TIMEOUT_MS, Timer::PERIODIC);
-            me->UpdateDisplayTime();
-            me->UpdatePowerLevel();
+QState Microwave::DisplayTimer_e(Microwave * const me) {
+    EVENT_ENTRY(DisplayTimer);
+    me->m_state = MicrowaveMsgFormat::State::DISPLAY_TIMER;
+    me->m_timerIndex = 0;
+    me->m_secondsRemaining = me->Time2Seconds(me->m_displayTime[me->m_timerIndex].time);
+    return QM_ENTRY(&Microwave::DisplayTimer_s);
+}
 
-            if(me->m_cook) {
-                me->m_cooking = true;
-                //write the current power level to the magnetron pipe
-                const uint32_t count {me->m_magnetronPipe.Write(&me->m_displayTime[me->m_timerIndex].powerLevel, 1)};
-                if(0 == count) {
-                    LOG("Write to MagnetronPipe failed\n\r");
-                }
+QState Microwave::DisplayTimer_x(Microwave * const me) {
+    EVENT_EXIT(DisplayTimer);
+    //NOTE: The Magnetron gets requested to turn off when m_secondsRemaining
+    //      goes to zero within Microwave::DecrementTimer(); if the user presses STOP when
+    //      the microwave is in the DisplayTimerPaused state then the magnetron needs to be
+    //      explicitly turned off.
+    if(me->m_secondsRemaining > 0 && me->m_cook) {
+        Evt* evt = new MagnetronOffReq(MAGNETRON, GET_HSMN(), GEN_SEQ());
+        Fw::Post(evt);
+    }
 
-                Evt* evt = new MwLampOnReq(MW_LAMP, GET_HSMN(), GEN_SEQ());
-                me->PostSync(evt);
-                evt = new FanOnReq(FAN, GET_HSMN(), GEN_SEQ());
-                me->PostSync(evt);
-                evt = new TurntableOnReq(TURNTABLE, GET_HSMN(), GEN_SEQ());
-                me->PostSync(evt);
-                evt = new MagnetronOnReq(MAGNETRON, GET_HSMN(), GEN_SEQ(), &me->m_magnetronPipe);
-                Fw::Post(evt);
-            }
-            return Q_HANDLED();
-        }
-        case Q_EXIT_SIG: {
-            EVENT(e);
-            me->m_secondTimer.Stop();
-            if(me->m_cook) {
-                me->m_cooking = false;
+    //reset the cook flag
+    me->m_cook = false;
+    //incase the stop button was pressed to cancel the timer, reset seconds remaining
+    me->m_secondsRemaining = 0;
+    me->m_timerIndex = 0;
+    //reset power levels
+    for(int i = 0; i < MAX_COOK_TIMERS; ++i) {
+        me->m_displayTime[i].powerLevel = MAX_POWER;
+    }
+    return QM_EXIT(&Microwave::DisplayTimer_s);
+}
 
-                Evt* evt = new FanOffReq(FAN, GET_HSMN(), GEN_SEQ());
-                me->PostSync(evt);
-                evt = new TurntableOffReq(TURNTABLE, GET_HSMN(), GEN_SEQ());
-                me->PostSync(evt);
-                if(me->m_closed) {
-                    evt = new MwLampOffReq(MW_LAMP, GET_HSMN(), GEN_SEQ());
-                    me->PostSync(evt);
-                }
-            }
-            return Q_HANDLED();
-        }
+QState Microwave::DisplayTimer_i(Microwave * const me) {
+    EVENT_INIT(DisplayTimer);
+    static struct {
+        QMState const *target;
+        QActionHandler act[2];
+    } const tatbl = {
+        &Microwave::DisplayTimerRunning_s,
+        {
+            Q_ACTION_CAST(&Microwave::DisplayTimerRunning_e),
+            Q_ACTION_CAST(0)
+        }
+    };
+    return QM_TRAN_INIT(&tatbl);
+}
+
+QState Microwave::DisplayTimerRunning(Microwave * const me, QEvt const * const e) {
+    switch (e->sig) {
         case SECOND_TIMER: {
             me->DecrementTimer();
 
@@ -1146,45 +1706,124 @@ QState Microwave::DisplayTimerRunning(Microwave * const me, QEvt const * const e
                 Evt *evt = new Evt(DONE, GET_HSMN());
                 Fw::Post(evt);
             }
-            return Q_HANDLED();
+            return QM_HANDLED();
         }
         case MICROWAVE_EXT_STOP_SIG: {
             EVENT(e);
-            return Q_TRAN(&Microwave::DisplayTimerPaused);
+            static struct {
+                QMState const *target;
+                QActionHandler act[3];
+            } const tatbl = {
+                &Microwave::DisplayTimerPaused_s,
+                {
+                    Q_ACTION_CAST(&Microwave::DisplayTimerRunning_x),
+                    Q_ACTION_CAST(&Microwave::DisplayTimerPaused_e),
+                    Q_ACTION_CAST(0)
+                }
+            };
+            return QM_TRAN(&tatbl);
         }
         case MICROWAVE_EXT_DOOR_OPEN_SIG: {
             EVENT(e);
             me->m_closed = false;
             Evt *evt = new MwLampOnReq(MW_LAMP, GET_HSMN());
             me->PostSync(evt);
-            return Q_TRAN(&Microwave::DisplayTimerPaused);
+            static struct {
+                QMState const *target;
+                QActionHandler act[3];
+            } const tatbl = {
+                &Microwave::DisplayTimerPaused_s,
+                {
+                    Q_ACTION_CAST(&Microwave::DisplayTimerRunning_x),
+                    Q_ACTION_CAST(&Microwave::DisplayTimerPaused_e),
+                    Q_ACTION_CAST(0)
+                }
+            };
+            return QM_TRAN(&tatbl);
         }
     }
-    return Q_SUPER(&Microwave::DisplayTimer);
+    return QM_SUPER();
 }
 
-QState Microwave::DisplayTimerPaused(Microwave * const me, QEvt const * const e) {
-    switch (e->sig) {
-        case Q_ENTRY_SIG: {
-            EVENT(e);
+QState Microwave::DisplayTimerRunning_e(Microwave * const me) {
+    EVENT_ENTRY(DisplayTimerRunning);
+    me->m_secondTimer.Start(SECOND_TIMEOUT_MS, Timer::PERIODIC);
+    me->UpdateDisplayTime();
+    me->UpdatePowerLevel();
+
+    if(me->m_cook) {
+        me->m_cooking = true;
+        //write the current power level to the magnetron pipe
+        const uint32_t count {me->m_magnetronPipe.Write(&me->m_displayTime[me->m_timerIndex].powerLevel, 1)};
+        if(0 == count) {
+            LOG("Write to MagnetronPipe failed\n\r");
+        }
+
+        Evt* evt = new MwLampOnReq(MW_LAMP, GET_HSMN(), GEN_SEQ());
+        me->PostSync(evt);
+        evt = new FanOnReq(FAN, GET_HSMN(), GEN_SEQ());
+        me->PostSync(evt);
+        evt = new TurntableOnReq(TURNTABLE, GET_HSMN(), GEN_SEQ());
+        me->PostSync(evt);
+        evt = new MagnetronOnReq(MAGNETRON, GET_HSMN(), GEN_SEQ(), &me->m_magnetronPipe);
+        Fw::Post(evt);
+    }
+    return QM_ENTRY(&Microwave::DisplayTimerRunning_s);
+}
 
-            Evt *evt = new MagnetronPauseReq(MAGNETRON, GET_HSMN(), GEN_SEQ());
-            Fw::Post(evt);
-            return Q_HANDLED();
-        }
-        case Q_EXIT_SIG: {
-            EVENT(e);
-            return Q_HANDLED();
+QState Microwave::DisplayTimerRunning_x(Microwave * const me) {
+    EVENT_EXIT(DisplayTimerRunning);
+    me->m_secondTimer.Stop();
+    if(me->m_cook) {
+        me->m_cooking = false;
+
+        Evt* evt = new FanOffReq(FAN, GET_HSMN(), GEN_SEQ());
+        me->PostSync(evt);
+        evt = new TurntableOffReq(TURNTABLE, GET_HSMN(), GEN_SEQ());
+        me->PostSync(evt);
+        if(me->m_closed) {
+            evt = new MwLampOffReq(MW_LAMP, GET_HSMN(), GEN_SEQ());
+            me->PostSync(evt);
         }
+    }
+    return QM_EXIT(&Microwave::DisplayTimerRunning_s);
+}
+
+QState Microwave::DisplayTimerPaused(Microwave * const me, QEvt const * const e) {
+    switch (e->sig) {
         case MICROWAVE_EXT_START_SIG: {
             EVENT(e);
             if(me->m_closed) {
-                return Q_TRAN(&Microwave::DisplayTimerRunning);
+                static struct {
+                    QMState const *target;
+                    QActionHandler act[3];
+                } const tatbl = {
+                    &Microwave::DisplayTimerRunning_s,
+                    {
+                        Q_ACTION_CAST(&Microwave::DisplayTimerPaused_x),
+                        Q_ACTION_CAST(&Microwave::DisplayTimerRunning_e),
+                        Q_ACTION_CAST(0)
+                    }
+                };
+                return QM_TRAN(&tatbl);
             }
-            return Q_HANDLED();
+            return QM_HANDLED();
         }
     }
-    return Q_SUPER(&Microwave::DisplayTimer);
+    return QM_SUPER();
+}
+
+QState Microwave::DisplayTimerPaused_e(Microwave * const me) {
+    EVENT_ENTRY(DisplayTimerPaused);
+
+    Evt *evt = new MagnetronPauseReq(MAGNETRON, GET_HSMN(), GEN_SEQ());
+    Fw::Post(evt);
+    return QM_ENTRY(&Microwave::DisplayTimerPaused_s);
+}
+
+QState Microwave::DisplayTimerPaused_x(Microwave * const me) {
+    EVENT_EXIT(DisplayTimerPaused);
+    return QM_EXIT(&Microwave::DisplayTimerPaused_s);
 }
 
 void Microwave::SendState(const MicrowaveMsgFormat::State state) {
@@ -1216,12 +1855,9 @@ void Microwave::SendUpdateTime(const MicrowaveMsgFormat::Update update, const Mi
 void Microwave::SendMessage(const MicrowaveMsgFormat::Message& message) {
     using namespace MicrowaveMsgFormat;
 
-    char buf[sizeof(Message) + 1];
-    buf[sizeof(Message)] = '\0';
-
+    static_assert(sizeof(Message) <= WifiSendMsgReq::MAX_LEN, "WifiSendMsgReq::MAX_LEN too small");
     Message msg {ByteSwapMessage(message)};
-    memcpy(buf, &msg, sizeof(Message));
-    Evt* evt = new WifiSendReq(WIFI_ST, this->GetHsmn(), this->GenSeq(), buf);
+    Evt* evt = new WifiSendMsgReq(WIFI_ST, this->GetHsmn(), this->GenSeq(), &msg, sizeof(Message));
     Fw::Post(evt);
 }
 
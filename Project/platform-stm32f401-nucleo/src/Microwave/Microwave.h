@@ -40,7 +40,7 @@
 #define MICROWAVE_H
 
 #include "qpcpp.h"
-#include "fw_active.h"
+#include "fw_mactive.h"
 #include "fw_timer.h"
 #include "fw_evt.h"
 #include "app_hsmn.h"
@@ -55,35 +55,113 @@ using namespace FW;
 
 namespace APP {
 
-class Microwave : public Active {
+class Microwave : public MActive {
 public:
     Microwave();
 
 protected:
+    // Coded in the QMsm style like Fan. Transitions use static transition-action tables, so the
+    // exit/entry paths across this deep hierarchy are resolved at compile time rather than by
+    // QHsm's run-time LCA search.
     static QState InitialPseudoState(Microwave * const me, QEvt const * const e);
     static QState Root(Microwave * const me, QEvt const * const e);
+    static QState Root_e(Microwave * const me);
+    static QState Root_x(Microwave * const me);
+    static QState Root_i(Microwave * const me);
+    static QMState const Root_s;
         static QState Stopped(Microwave * const me, QEvt const * const e);
+        static QState Stopped_e(Microwave * const me);
+        static QState Stopped_x(Microwave * const me);
+        static QMState const Stopped_s;
         static QState Starting(Microwave * const me, QEvt const * const e);
+        static QState Starting_e(Microwave * const me);
+        static QState Starting_x(Microwave * const me);
+        static QMState const Starting_s;
         static QState Stopping(Microwave * const me, QEvt const * const e);
+        static QState Stopping_e(Microwave * const me);
+        static QState Stopping_x(Microwave * const me);
+        static QMState const Stopping_s;
         static QState Started(Microwave * const me, QEvt const * const e);
+        static QState Started_e(Microwave * const me);
+        static QState Started_x(Microwave * const me);
+        static QState Started_i(Microwave * const me);
+        static QMState const Started_s;
             static QState DisplayClock(Microwave * const me, QEvt const * const e);
+            static QState DisplayClock_e(Microwave * const me);
+            static QState DisplayClock_x(Microwave * const me);
+            static QMState const DisplayClock_s;
                 static QState SetClock(Microwave * const me, QEvt const * const e);
+                static QState SetClock_e(Microwave * const me);
+                static QState SetClock_x(Microwave * const me);
+                static QState SetClock_i(Microwave * const me);
+                static QMState const SetClock_s;
                     static QState ClockSelectHourTens(Microwave * const me, QEvt const * const e);
+                    static QState ClockSelectHourTens_e(Microwave * const me);
+                    static QState ClockSelectHourTens_x(Microwave * const me);
+                    static QMState const ClockSelectHourTens_s;
                     static QState ClockSelectHourOnes(Microwave * const me, QEvt const * const e);
+                    static QState ClockSelectHourOnes_e(Microwave * const me);
+                    static QState ClockSelectHourOnes_x(Microwave * const me);
+                    static QMState const ClockSelectHourOnes_s;
                     static QState ClockSelectMinuteTens(Microwave * const me, QEvt const * const e);
+                    static QState ClockSelectMinuteTens_e(Microwave * const me);
+                    static QState ClockSelectMinuteTens_x(Microwave * const me);
+                    static QMState const ClockSelectMinuteTens_s;
                     static QState ClockSelectMinuteOnes(Microwave * const me, QEvt const * const e);
+                    static QState ClockSelectMinuteOnes_e(Microwave * const me);
+                    static QState ClockSelectMinuteOnes_x(Microwave * const me);
+                    static QMState const ClockSelectMinuteOnes_s;
             static QState SetCookTimer(Microwave * const me, QEvt const * const e);
+            static QState SetCookTimer_e(Microwave * const me);
+            static QState SetCookTimer_x(Microwave * const me);
+            static QState SetCookTimer_i(Microwave * const me);
+            static QMState const SetCookTimer_s;
                 static QState SetCookTimerInitial(Microwave * const me, QEvt const * const e);
+                static QState SetCookTimerInitial_e(Microwave * const me);
+                static QState SetCookTimerInitial_x(Microwave * const me);
+                static QMState const SetCookTimerInitial_s;
                 static QState SetCookTimerFinal(Microwave * const me, QEvt const * const e);
+                static QState SetCookTimerFinal_e(Microwave * const me);
+                static QState SetCookTimerFinal_x(Microwave * const me);
+                static QMState const SetCookTimerFinal_s;
             static QState SetPowerLevel(Microwave * const me, QEvt const * const e);
+            static QState SetPowerLevel_e(Microwave * const me);
+            static QState SetPowerLevel_x(Microwave * const me);
+            static QMState const SetPowerLevel_s;
             static QState SetKitchenTimer(Microwave * const me, QEvt const * const e);
+            static QState SetKitchenTimer_e(Microwave * const me);
+            static QState SetKitchenTimer_x(Microwave * const me);
+            static QState SetKitchenTimer_i(Microwave * const me);
+            static QMState const SetKitchenTimer_s;
                 static QState KitchenSelectHourTens(Microwave * const me, QEvt const * const e);
+                static QState KitchenSelectHourTens_e(Microwave * const me);
+                static QState KitchenSelectHourTens_x(Microwave * const me);
+                static QMState const KitchenSelectHourTens_s;
                 static QState KitchenSelectHourOnes(Microwave * const me, QEvt const * const e);
+                static QState KitchenSelectHourOnes_e(Microwave * const me);
+                static QState KitchenSelectHourOnes_x(Microwave * const me);
+                static QMState const KitchenSelectHourOnes_s;
                 static QState KitchenSelectMinuteTens(Microwave * const me, QEvt const * const e);
+                static QState KitchenSelectMinuteTens_e(Microwave * const me);
+                static QState KitchenSelectMinuteTens_x(Microwave * const me);
+                static QMState const KitchenSelectMinuteTens_s;
                 static QState KitchenSelectMinuteOnes(Microwave * const me, QEvt const * const e);
+                static QState KitchenSelectMinuteOnes_e(Microwave * const me);
+                static QState KitchenSelectMinuteOnes_x(Microwave * const me);
+                static QMState const KitchenSelectMinuteOnes_s;
             static QState DisplayTimer(Microwave * const me, QEvt const * const e);
+            static QState DisplayTimer_e(Microwave * const me);
+            static QState DisplayTimer_x(Microwave * const me);
+            static QState DisplayTimer_i(Microwave * const me);
+            static QMState const DisplayTimer_s;
                 static QState DisplayTimerRunning(Microwave * const me, QEvt const * const e);
+                static QState DisplayTimerRunning_e(Microwave * const me);
+                static QState DisplayTimerRunning_x(Microwave * const me);
+                static QMState const DisplayTimerRunning_s;
                 static QState DisplayTimerPaused(Microwave * const me, QEvt const * const e);
+                static QState DisplayTimerPaused_e(Microwave * const me);
+                static QState DisplayTimerPaused_x(Microwave * const me);
+                static QMState const DisplayTimerPaused_s;
 
     struct DisplayTime {
         MicrowaveMsgFormat::Time time;
@@ -153,17 +153,18 @@ static CmdStatus Digit(Console &console, Evt const *e) {
 }
 
 static CmdStatus List(Console &console, Evt const *e);
-static CmdHandler const cmdHandler[] = {
+static constexpr CmdHandler cmdHandler[] = {
+    { "?",             List,         "List commands",        0 },
     { "clock",         Clock,        "Clock Signal",         0 },
     { "cook_time",     CookTime,     "Cook Time Signal",     0 },
-    { "power_level",   PowerLevel,   "Power Level Signal",   0 },
+    { "digit",         Digit,        "Digit Signal",         0 },
     { "kitchen_timer", KitchenTimer, "Kitchen Timer Signal", 0 },
+    { "power_level",   PowerLevel,   "Power Level Signal",   0 },
+    { "start",         Start,        "Start Signal",         0 },
     { "state_req",     StateRequest, "State Request",        0 },
     { "stop",          Stop,         "Stop Signal",          0 },
-    { "start",         Start,        "Start Signal",         0 },
-    { "digit",         Digit,        "Digit Signal",         0 },
-    { "?",             List,         "List commands",        0 }
 };
+CMD_TABLE_ASSERT(cmdHandler);
 
 static CmdStatus List(Console &console, Evt const *e) {
     return console.ListCmd(e, cmdHandler, ARRAY_COUNT(cmdHandler));
@@ -64,7 +64,8 @@ namespace APP {
     ADD_EVT(MICROWAVE_EXT_DOOR_CLOSED_SIG) \
     ADD_EVT(MICROWAVE_EXT_DIGIT_SIG) \
     ADD_EVT(MICROWAVE_EXT_STATE_REQ_SIG) \
-    ADD_EVT(MICROWAVE_WIFI_CONN_REQ)
+    ADD_EVT(MICROWAVE_WIFI_CONN_REQ) \
+    ADD_EVT(MICROWAVE_OFF_IND)
 
 #undef ADD_EVT
 #define ADD_EVT(e_) e_,
@@ -179,6 +180,13 @@ public:
         Evt(MICROWAVE_WIFI_CONN_REQ, to, from, seq) {}
 };
 
+// Published to turn off all cooking peripherals (fan, lamp and turntable) which subscribe to it.
+class MicrowaveOffInd : public Evt {
+public:
+    MicrowaveOffInd(Hsmn from) :
+        Evt(MICROWAVE_OFF_IND, HSM_UNDEF, from) {}
+};
+
 } // namespace APP
 
 #endif // MICROWAVE_INTERFACE_H
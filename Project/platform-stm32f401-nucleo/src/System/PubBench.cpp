@@ -0,0 +1,105 @@
+/*******************************************************************************
+ * Copyright (C) Gallium Studio LLC. All rights reserved.
+ *
+ * This program is open source software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Alternatively, this program may be distributed and modified under the
+ * terms of Gallium Studio LLC commercial licenses, which expressly supersede
+ * the GNU General Public License and are specifically designed for licensees
+ * interested in retaining the proprietary status of their code.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Contact information:
+ * Website - https://www.galliumstudio.com
+ * Source repository - https://github.com/galliumstudio
+ * Email - admin@galliumstudio.com
+ ******************************************************************************/
+
+#include "fw.h"
+#include "fw_evt.h"
+#include "fw_macro.h"
+#include "fw_prof.h"
+#include "fw_assert.h"
+#include "SystemInterface.h"
+#include "PubBench.h"
+
+FW_DEFINE_THIS_FILE("PubBench.cpp")
+
+using namespace FW;
+
+namespace APP {
+
+enum {
+    POOL_INDEX = 0      // Smallest pool, which an Evt is allocated from.
+};
+
+// Time is wall time and includes any preemption, so min is the most reliable figure.
+// The pool usage is the change in blocks in use, which includes events allocated or recycled by
+// higher priority containers in the meantime.
+static void Measure(PubBench::Test test, Hsmn from, Hsmn const hsmn[], uint32_t hsmnCount, uint32_t count,
+                    PubBench::Result &result) {
+    result.m_count = 0;
+    result.m_min = 0xFFFFFFFF;
+    result.m_max = 0;
+    result.m_total = 0;
+    Fw::PoolStat stat;
+    Fw::GetPoolStat(POOL_INDEX, stat);
+    uint32_t inUse = stat.m_inUse;
+    for (uint32_t i = 0; i < count; i++) {
+        uint32_t startTime = Prof::GetTime();
+        if (test == PubBench::MULTI_POST) {
+            for (uint32_t j = 0; j < hsmnCount; j++) {
+                Fw::Post(new Evt(SYSTEM_PUB_BENCH_IND, hsmn[j], from));
+            }
+        } else {
+            Fw::Publish(new Evt(SYSTEM_PUB_BENCH_IND, HSM_UNDEF, from));
+        }
+        uint32_t time = Prof::GetTime() - startTime;
+        result.m_count++;
+        result.m_min = LESS(result.m_min, time);
+        result.m_max = GREATER(result.m_max, time);
+        result.m_total += time;
+    }
+    Fw::GetPoolStat(POOL_INDEX, stat);
+    result.m_blocks = stat.m_inUse - inUse;
+}
+
+// The HSMs are unsubscribed before the published events are dispatched, so the container drops them.
+// None of the HSMs handles SYSTEM_PUB_BENCH_IND anyway.
+void PubBench::Run(Hsmn from, Hsmn const hsmn[], uint32_t hsmnCount, uint32_t count, Result result[TEST_COUNT]) {
+    FW_ASSERT(hsmn && hsmnCount && count && ((count * (hsmnCount + 1)) <= MAX_QUEUED));
+    FW_ASSERT(sizeof(Evt) <= Fw::GetPoolEvtSize(POOL_INDEX));
+    QActive *container = Fw::GetContainer(from);
+    for (uint32_t j = 0; j < hsmnCount; j++) {
+        FW_ASSERT(Fw::GetContainer(hsmn[j]) == container);
+        Fw::Subscribe(SYSTEM_PUB_BENCH_IND, hsmn[j]);
+    }
+    Measure(MULTI_POST, from, hsmn, hsmnCount, count, result[MULTI_POST]);
+    Measure(PUBLISH, from, hsmn, hsmnCount, count, result[PUBLISH]);
+    for (uint32_t j = 0; j < hsmnCount; j++) {
+        Fw::Unsubscribe(SYSTEM_PUB_BENCH_IND, hsmn[j]);
+    }
+}
+
+} // namespace APP
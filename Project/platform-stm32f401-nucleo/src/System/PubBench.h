@@ -0,0 +1,81 @@
+/*******************************************************************************
+ * Copyright (C) Gallium Studio LLC. All rights reserved.
+ *
+ * This program is open source software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Alternatively, this program may be distributed and modified under the
+ * terms of Gallium Studio LLC commercial licenses, which expressly supersede
+ * the GNU General Public License and are specifically designed for licensees
+ * interested in retaining the proprietary status of their code.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Contact information:
+ * Website - https://www.galliumstudio.com
+ * Source repository - https://github.com/galliumstudio
+ * Email - admin@galliumstudio.com
+ ******************************************************************************/
+
+#ifndef PUB_BENCH_H
+#define PUB_BENCH_H
+
+#include "fw_def.h"
+
+using namespace FW;
+
+namespace APP {
+
+// Compares the cost of sending one event to several HSMs (a fan-out) in two ways:
+// MULTI_POST allocates and posts a separate event to each HSM with Fw::Post().
+// PUBLISH allocates one event and posts it with Fw::Publish() to the HSMs subscribed to its signal.
+// A container is posted to once and dispatches it to each of its subscribers.
+// The HSMs must be in the container of the caller, so that none of the events is dispatched before
+// Run() returns. Only the sender side is measured, i.e. allocation and posting.
+class PubBench {
+public:
+    class Result {
+    public:
+        uint32_t m_count;       // Number of fan-outs measured.
+        uint32_t m_min;
+        uint32_t m_max;
+        uint64_t m_total;
+        uint32_t m_blocks;      // Number of pool blocks allocated by all fan-outs.
+    };
+    enum Test {
+        MULTI_POST,
+        PUBLISH,
+        TEST_COUNT
+    };
+    enum {
+        // Maximum number of events queued by Run(), which leaves room in the event queue of Active
+        // (EVT_QUEUE_COUNT) for other events.
+        MAX_QUEUED = 48
+    };
+    // Runs count fan-outs to hsmnCount HSMs in each way. count * (hsmnCount + 1) must not exceed MAX_QUEUED.
+    // Results are indexed by Test.
+    static void Run(Hsmn from, Hsmn const hsmn[], uint32_t hsmnCount, uint32_t count, Result result[TEST_COUNT]);
+};
+
+} // namespace APP
+
+#endif // PUB_BENCH_H
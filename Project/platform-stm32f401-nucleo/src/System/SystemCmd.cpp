@@ -37,12 +37,17 @@
  ******************************************************************************/
 
 #include <string.h>
+#include "fw.h"
+#include "fw_prof.h"
 #include "fw_log.h"
 #include "fw_assert.h"
 #include "app_hsmn.h"
 #include "Console.h"
 #include "SystemCmd.h"
 #include "SystemInterface.h"
+#include "UartOutInterface.h"
+#include "TranBench.h"
+#include "PubBench.h"
 
 FW_DEFINE_THIS_FILE("SystemCmd.cpp")
 
@@ -110,14 +115,355 @@ static CmdStatus Cpu(Console &console, Evt const *e) {
     return CMD_DONE;
 }
 
+// Event pool statistics for sizing the event pools in Fw. "sys pool reset" clears the counters.
+// Minimum-free watermark is derived from the peak number of blocks in use.
+// Fail counts allocations which found the pool that fits exhausted.
+static CmdStatus Pool(Console &console, Evt const *e) {
+#if FW_EVT_COUNT
+    enum {
+        SHOW_SIGNAL,
+        SHOW_SENDER
+    };
+    uint32_t &phase = console.Var(0);
+    uint32_t &index = console.Var(1);
+    uint32_t &count = console.Var(2);
+#endif
+    switch (e->sig) {
+        case Console::CONSOLE_CMD: {
+            Console::ConsoleCmd const &cmd = static_cast<Console::ConsoleCmd const &>(*e);
+            if ((cmd.Argc() > 1) && STRING_EQUAL(cmd.Argv(1), "reset")) {
+                Fw::ResetEvtStat();
+                console.Print("Event pool statistics reset\n\r");
+                return CMD_DONE;
+            }
+            console.Print("Size Count InUse Peak MinFree Alloc    Fail     AvgReq MaxReq\n\r");
+            for (uint32_t i = 0; i < Fw::GetPoolCount(); i++) {
+                Fw::PoolStat stat;
+                Fw::GetPoolStat(i, stat);
+                uint32_t evtCount = Fw::GetPoolEvtCount(i);
+                console.Print("%-4lu %-5lu %-5u %-4u %-7lu %-8lu %-8lu %-6lu %u\n\r",
+                              Fw::GetPoolEvtSize(i), evtCount, stat.m_inUse, stat.m_peak, evtCount - stat.m_peak,
+                              stat.m_allocCnt, stat.m_failCnt,
+                              stat.m_allocCnt ? (stat.m_reqBytes / stat.m_allocCnt) : 0, stat.m_maxReqSize);
+            }
+#if FW_EVT_COUNT
+            console.Print("Signals not counted (table full) = %lu\n\r", Fw::GetSigOverflowCnt());
+            console.Print("\n\rEvents by signal (curr/peak/total):\n\r");
+            phase = SHOW_SIGNAL;
+            index = 0;
+            count = 0;
+            break;
+#else
+            console.Print("Events by signal and sender not counted (FW_EVT_COUNT is 0)\n\r");
+            return CMD_DONE;
+#endif
+        }
+#if FW_EVT_COUNT
+        case UART_OUT_EMPTY_IND: {
+            if (phase == SHOW_SIGNAL) {
+                for (; index < Fw::GetSigCountSize(); index++) {
+                    QSignal sig;
+                    Fw::EvtCount evtCount;
+                    if (Fw::GetSigCount(index, sig, evtCount)) {
+                        bool result = console.PrintItem(count, 40, 2, "%s %u/%u/%lu", Log::GetEvtName(sig),
+                                                        evtCount.m_curr, evtCount.m_peak, evtCount.m_total);
+                        if (!result) {
+                            return CMD_CONTINUE;
+                        }
+                        count++;
+                    }
+                }
+                console.Print("\n\r\n\rEvents by sender (curr/peak/total):\n\r");
+                phase = SHOW_SENDER;
+                index = 0;
+                count = 0;
+                return CMD_CONTINUE;
+            }
+            for (; index < HSM_COUNT; index++) {
+                Fw::EvtCount evtCount;
+                Fw::GetSenderCount(index, evtCount);
+                if (evtCount.m_peak) {
+                    bool result = console.PrintItem(count, 40, 2, "%s %u/%u/%lu", Log::GetHsmName(index),
+                                                    evtCount.m_curr, evtCount.m_peak, evtCount.m_total);
+                    if (!result) {
+                        return CMD_CONTINUE;
+                    }
+                    count++;
+                }
+            }
+            console.PutStr("\n\r\n\r");
+            return CMD_DONE;
+        }
+#endif
+    }
+    return CMD_CONTINUE;
+}
+
+// Prints a dispatch profile entry in two lines. Returns false if the output fifo is full, in which
+// case it is to be called again with the same entry. part is used to resume from the second line.
+static bool PrintProfEntry(Console &console, Prof::Entry const &entry, uint32_t &part) {
+    if (part == 0) {
+        uint32_t avg = entry.m_count ? static_cast<uint32_t>(entry.m_total / entry.m_count) : 0;
+        if (!console.Print("%-16s %-28s n=%lu min=%lu avg=%lu max=%lu\n\r", Log::GetHsmName(entry.m_hsmn),
+                           Log::GetEvtName(entry.m_sig), entry.m_count, entry.m_min, avg, entry.m_max)) {
+            return false;
+        }
+        part = 1;
+    }
+    uint16_t const *h = entry.m_hist;
+    if (!console.Print("    %u %u %u %u %u %u %u %u %u %u %u %u %u %u %u %u\n\r",
+                       h[0], h[1], h[2], h[3], h[4], h[5], h[6], h[7],
+                       h[8], h[9], h[10], h[11], h[12], h[13], h[14], h[15])) {
+        return false;
+    }
+    part = 0;
+    return true;
+}
+
+// Dispatch profiler. "dump" (or no argument) lists all (HSM, signal) entries. "top N" lists the N entries
+// with the longest maximum run-to-completion time.
+static CmdStatus Profile(Console &console, Evt const *e) {
+    enum {
+        DUMP,
+        TOP
+    };
+    uint32_t &mode = console.Var(0);
+    uint32_t &index = console.Var(1);       // Next entry index for DUMP. Last listed entry index for TOP.
+    uint32_t &remaining = console.Var(2);   // Number of entries to list for TOP.
+    uint32_t &lastMax = console.Var(3);     // Max time of last listed entry for TOP.
+    uint32_t &part = console.Var(4);        // Line of entry being printed.
+    switch (e->sig) {
+        case Console::CONSOLE_CMD: {
+            Console::ConsoleCmd const &cmd = static_cast<Console::ConsoleCmd const &>(*e);
+            if ((cmd.Argc() > 1) && STRING_EQUAL(cmd.Argv(1), "reset")) {
+                Prof::Reset();
+                console.Print("Profile reset\n\r");
+                return CMD_DONE;
+            }
+            if ((cmd.Argc() == 1) || STRING_EQUAL(cmd.Argv(1), "dump")) {
+                mode = DUMP;
+                index = 0;
+            } else if ((cmd.Argc() > 2) && STRING_EQUAL(cmd.Argv(1), "top")) {
+                mode = TOP;
+                remaining = STRING_TO_NUM(cmd.Argv(2), 0);
+                index = 0;
+                lastMax = 0xFFFFFFFF;
+            } else {
+                console.Print("sys prof [reset|dump|top <N>]\n\r");
+                return CMD_DONE;
+            }
+            part = 0;
+            console.Print("Time in %s. Dispatches not recorded = %lu\n\r", Prof::GetUnit(), Prof::GetOverflowCnt());
+            console.Print("Histogram buckets: <2^%d, 2^%d..., >=2^%d\n\r", Prof::HIST_MIN_ORDER + 1,
+                          Prof::HIST_MIN_ORDER + 1, Prof::HIST_MIN_ORDER + Prof::HIST_COUNT - 1);
+            break;
+        }
+        case UART_OUT_EMPTY_IND: {
+            Prof::Entry entry;
+            if (mode == DUMP) {
+                for (; index < Prof::ENTRY_COUNT; index++) {
+                    if (Prof::GetEntry(index, entry) && !PrintProfEntry(console, entry, part)) {
+                        return CMD_CONTINUE;
+                    }
+                }
+                return CMD_DONE;
+            }
+            for (; remaining; remaining--) {
+                // When part != 0, the last listed entry is being printed.
+                if (part == 0) {
+                    // Find the entry ranked next to the last listed one, ordered by max (descending)
+                    // and then index (ascending).
+                    uint32_t next = Prof::ENTRY_COUNT;
+                    uint32_t nextMax = 0;
+                    for (uint32_t i = 0; i < Prof::ENTRY_COUNT; i++) {
+                        if (Prof::GetEntry(i, entry) &&
+                            ((entry.m_max < lastMax) || ((entry.m_max == lastMax) && (i > index))) &&
+                            ((next == Prof::ENTRY_COUNT) || (entry.m_max > nextMax))) {
+                            next = i;
+                            nextMax = entry.m_max;
+                        }
+                    }
+                    if (next == Prof::ENTRY_COUNT) {
+                        break;
+                    }
+                    index = next;
+                    lastMax = nextMax;
+                }
+                Prof::GetEntry(index, entry);
+                if (!PrintProfEntry(console, entry, part)) {
+                    return CMD_CONTINUE;
+                }
+            }
+            return CMD_DONE;
+        }
+    }
+    return CMD_CONTINUE;
+}
+
+// Event queue high-water marks and queueing latency of each active object or thread, followed by
+// defer and reminder queue high-water marks of each HSM. "warn <percent>" sets the threshold of
+// event queue usage above which a warning is printed (0 to disable).
+static CmdStatus QueueUsage(Console &console, Evt const *e) {
+    enum {
+        SHOW_EVT_QUEUE,
+        SHOW_HSM_QUEUE
+    };
+    uint32_t &phase = console.Var(0);
+    uint32_t &index = console.Var(1);
+    uint32_t &part = console.Var(2);        // Line of event queue being printed.
+    switch (e->sig) {
+        case Console::CONSOLE_CMD: {
+            Console::ConsoleCmd const &cmd = static_cast<Console::ConsoleCmd const &>(*e);
+            if ((cmd.Argc() > 1) && STRING_EQUAL(cmd.Argv(1), "reset")) {
+                Prof::ResetQueue();
+                console.Print("Latency reset\n\r");
+                return CMD_DONE;
+            }
+            if ((cmd.Argc() > 1) && STRING_EQUAL(cmd.Argv(1), "warn")) {
+                if (cmd.Argc() > 2) {
+                    Prof::SetWarnPercent(STRING_TO_NUM(cmd.Argv(2), 0));
+                }
+                console.Print("Warning threshold = %lu%% (0 = disabled)\n\r", Prof::GetWarnPercent());
+                console.Print("sys queue [reset|warn <percent>]\n\r");
+                return CMD_DONE;
+            }
+            console.Print("Latency in %s. Histogram buckets: <2^%d, 2^%d..., >=2^%d\n\r", Prof::GetUnit(),
+                          Prof::HIST_MIN_ORDER + 1, Prof::HIST_MIN_ORDER + 1, Prof::HIST_MIN_ORDER + Prof::HIST_COUNT - 1);
+            phase = SHOW_EVT_QUEUE;
+            index = 0;
+            part = 0;
+            break;
+        }
+        case UART_OUT_EMPTY_IND: {
+            if (phase == SHOW_EVT_QUEUE) {
+                for (; index <= QF_MAX_ACTIVE; index++) {
+                    Prof::Queue queue;
+                    if (!Prof::GetQueue(index, queue)) {
+                        continue;
+                    }
+                    if (part == 0) {
+                        uint32_t high = queue.m_capacity - QF::getQueueMin(index);
+                        uint32_t avg = queue.m_count ? static_cast<uint32_t>(queue.m_total / queue.m_count) : 0;
+                        if (!console.Print("%-16s prio=%-2lu high=%lu/%u n=%lu avg=%lu max=%lu\n\r",
+                                           Log::GetHsmName(queue.m_hsmn), index, high, queue.m_capacity,
+                                           queue.m_count, avg, queue.m_max)) {
+                            return CMD_CONTINUE;
+                        }
+                        part = 1;
+                    }
+                    uint16_t const *h = queue.m_hist;
+                    if (!console.Print("    %u %u %u %u %u %u %u %u %u %u %u %u %u %u %u %u\n\r",
+                                       h[0], h[1], h[2], h[3], h[4], h[5], h[6], h[7],
+                                       h[8], h[9], h[10], h[11], h[12], h[13], h[14], h[15])) {
+                        return CMD_CONTINUE;
+                    }
+                    part = 0;
+                }
+                console.Print("\n\rDefer and reminder queue high-water marks:\n\r");
+                phase = SHOW_HSM_QUEUE;
+                index = 0;
+                return CMD_CONTINUE;
+            }
+            for (; index < HSM_COUNT; index++) {
+                Hsm *hsm = Fw::GetHsm(index);
+                if (hsm && (hsm->GetDeferHighWater() || hsm->GetReminderHighWater())) {
+                    if (!console.Print("%-16s defer=%lu/%lu reminder=%lu/%lu\n\r", hsm->GetName(),
+                                       hsm->GetDeferHighWater(), hsm->GetDeferCapacity(),
+                                       hsm->GetReminderHighWater(), hsm->GetReminderCapacity())) {
+                        return CMD_CONTINUE;
+                    }
+                }
+            }
+            return CMD_DONE;
+        }
+    }
+    return CMD_CONTINUE;
+}
+
+// Transition benchmark comparing the same state machine coded as a QHsm and as a QMsm (see TranBench.h).
+// "sys tran [count]" dispatches each event count times (default 1000) to each machine within this command.
+static CmdStatus Tran(Console &console, Evt const *e) {
+    enum {
+        DEFAULT_COUNT = 1000,
+        MAX_COUNT = 10000
+    };
+    switch (e->sig) {
+        case Console::CONSOLE_CMD: {
+            Console::ConsoleCmd const &cmd = static_cast<Console::ConsoleCmd const &>(*e);
+            uint32_t count = DEFAULT_COUNT;
+            if (cmd.Argc() > 1) {
+                count = LESS(STRING_TO_NUM(cmd.Argv(1), 0), static_cast<uint32_t>(MAX_COUNT));
+            }
+            if (count == 0) {
+                console.Print("sys tran [count]\n\r");
+                break;
+            }
+            TranBench::Result hsmResult[TranBench::TEST_COUNT];
+            TranBench::Result msmResult[TranBench::TEST_COUNT];
+            TranBench::Run(count, hsmResult, msmResult);
+            static char const * const testName[TranBench::TEST_COUNT] = { "deep", "sibling" };
+            console.Print("Dispatch time in %s\n\r", Prof::GetUnit());
+            for (uint32_t test = 0; test < TranBench::TEST_COUNT; test++) {
+                TranBench::Result const *result[] = { &hsmResult[test], &msmResult[test] };
+                static char const * const style[] = { "QHsm", "QMsm" };
+                for (uint32_t i = 0; i < ARRAY_COUNT(result); i++) {
+                    console.Print("%-8s %s n=%lu min=%lu avg=%lu max=%lu\n\r", testName[test], style[i],
+                                  result[i]->m_count, result[i]->m_min,
+                                  static_cast<uint32_t>(result[i]->m_total / result[i]->m_count), result[i]->m_max);
+                }
+            }
+            break;
+        }
+    }
+    return CMD_DONE;
+}
+
+// Fan-out benchmark comparing multi-post with publish (see PubBench.h). "sys pub [count]" sends count fan-outs
+// of each kind (default is the maximum) to this console and its two regions, which are in the same container.
+static CmdStatus Pub(Console &console, Evt const *e) {
+    switch (e->sig) {
+        case Console::CONSOLE_CMD: {
+            Console::ConsoleCmd const &cmd = static_cast<Console::ConsoleCmd const &>(*e);
+            Hsmn const hsmn[] = { console.GetHsmn(), Console::GetCmdInputHsmn(console.GetHsmn()),
+                                  Console::GetCmdParserHsmn(console.GetHsmn()) };
+            uint32_t maxCount = PubBench::MAX_QUEUED / (ARRAY_COUNT(hsmn) + 1);
+            uint32_t count = maxCount;
+            if (cmd.Argc() > 1) {
+                count = LESS(STRING_TO_NUM(cmd.Argv(1), 0), static_cast<uint32_t>(maxCount));
+            }
+            if (count == 0) {
+                console.Print("sys pub [count]\n\r");
+                break;
+            }
+            PubBench::Result result[PubBench::TEST_COUNT];
+            PubBench::Run(console.GetHsmn(), hsmn, ARRAY_COUNT(hsmn), count, result);
+            static char const * const testName[PubBench::TEST_COUNT] = { "multi-post", "publish" };
+            console.Print("Fan-out to %u HSMs, time in %s\n\r", ARRAY_COUNT(hsmn), Prof::GetUnit());
+            for (uint32_t test = 0; test < PubBench::TEST_COUNT; test++) {
+                PubBench::Result const &r = result[test];
+                console.Print("%-10s n=%lu min=%lu avg=%lu max=%lu blocks=%lu\n\r", testName[test], r.m_count,
+                              r.m_min, static_cast<uint32_t>(r.m_total / r.m_count), r.m_max, r.m_blocks);
+            }
+            break;
+        }
+    }
+    return CMD_DONE;
+}
+
 static CmdStatus List(Console &console, Evt const *e);
-static CmdHandler const cmdHandler[] = {
-    { "test",       Test,       "Test function", 0 },
+static constexpr CmdHandler cmdHandler[] = {
     { "?",          List,       "List commands", 0 },
-    { "stop",       Stop,       "Stop HSM", 0 },
-    { "start",      Start,      "Start HSM", 0 },
     { "cpu",        Cpu,        "Report CPU util", 0 },
+    { "pool",       Pool,       "Event pool stats", 0 },
+    { "prof",       Profile,    "Dispatch profiler", 0 },
+    { "pub",        Pub,        "Publish vs multi-post cost", 0 },
+    { "queue",      QueueUsage, "Queue usage and latency", 0 },
+    { "start",      Start,      "Start HSM", 0 },
+    { "stop",       Stop,       "Stop HSM", 0 },
+    { "test",       Test,       "Test function", 0 },
+    { "tran",       Tran,       "QHsm vs QMsm transition time", 0 },
 };
+CMD_TABLE_ASSERT(cmdHandler);
 
 static CmdStatus List(Console &console, Evt const *e) {
     return console.ListCmd(e, cmdHandler, ARRAY_COUNT(cmdHandler));
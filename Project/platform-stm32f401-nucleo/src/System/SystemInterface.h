@@ -52,7 +52,8 @@ namespace APP {
     ADD_EVT(SYSTEM_START_CFM) \
     ADD_EVT(SYSTEM_STOP_REQ) \
     ADD_EVT(SYSTEM_STOP_CFM) \
-    ADD_EVT(SYSTEM_CPU_UTIL_REQ)
+    ADD_EVT(SYSTEM_CPU_UTIL_REQ) \
+    ADD_EVT(SYSTEM_PUB_BENCH_IND)
 
 #undef ADD_EVT
 #define ADD_EVT(e_) e_,
@@ -0,0 +1,539 @@
+/*******************************************************************************
+ * Copyright (C) Gallium Studio LLC. All rights reserved.
+ *
+ * This program is open source software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Alternatively, this program may be distributed and modified under the
+ * terms of Gallium Studio LLC commercial licenses, which expressly supersede
+ * the GNU General Public License and are specifically designed for licensees
+ * interested in retaining the proprietary status of their code.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Contact information:
+ * Website - https://www.galliumstudio.com
+ * Source repository - https://github.com/galliumstudio
+ * Email - admin@galliumstudio.com
+ ******************************************************************************/
+
+#include "fw_macro.h"
+#include "fw_prof.h"
+#include "fw_assert.h"
+#include "TranBench.h"
+
+FW_DEFINE_THIS_FILE("TranBench.cpp")
+
+using namespace FW;
+
+namespace APP {
+
+enum {
+    DEEP_SIG = Q_USER_SIG,
+    SIBLING_SIG
+};
+
+class BenchHsm : public QHsm {
+public:
+    BenchHsm() : QHsm(Q_STATE_CAST(&BenchHsm::InitialPseudoState)), m_actionCnt(0) {}
+    uint32_t m_actionCnt;
+
+protected:
+    static QState InitialPseudoState(BenchHsm * const me, QEvt const * const e);
+    static QState Root(BenchHsm * const me, QEvt const * const e);
+        static QState A(BenchHsm * const me, QEvt const * const e);
+            static QState A1(BenchHsm * const me, QEvt const * const e);
+                static QState A11(BenchHsm * const me, QEvt const * const e);
+                static QState A12(BenchHsm * const me, QEvt const * const e);
+        static QState B(BenchHsm * const me, QEvt const * const e);
+            static QState B1(BenchHsm * const me, QEvt const * const e);
+                static QState B11(BenchHsm * const me, QEvt const * const e);
+};
+
+class BenchMsm : public QMsm {
+public:
+    BenchMsm() : QMsm(Q_STATE_CAST(&BenchMsm::InitialPseudoState)), m_actionCnt(0) {}
+    uint32_t m_actionCnt;
+
+protected:
+    static QState InitialPseudoState(BenchMsm * const me, QEvt const * const e);
+    static QState Root(BenchMsm * const me, QEvt const * const e);
+    static QState Root_i(BenchMsm * const me);
+    static QMState const Root_s;
+        static QState A(BenchMsm * const me, QEvt const * const e);
+        static QState A_e(BenchMsm * const me);
+        static QState A_x(BenchMsm * const me);
+        static QMState const A_s;
+            static QState A1(BenchMsm * const me, QEvt const * const e);
+            static QState A1_e(BenchMsm * const me);
+            static QState A1_x(BenchMsm * const me);
+            static QMState const A1_s;
+                static QState A11(BenchMsm * const me, QEvt const * const e);
+                static QState A11_e(BenchMsm * const me);
+                static QState A11_x(BenchMsm * const me);
+                static QMState const A11_s;
+                static QState A12(BenchMsm * const me, QEvt const * const e);
+                static QState A12_e(BenchMsm * const me);
+                static QState A12_x(BenchMsm * const me);
+                static QMState const A12_s;
+        static QState B(BenchMsm * const me, QEvt const * const e);
+        static QState B_e(BenchMsm * const me);
+        static QState B_x(BenchMsm * const me);
+        static QMState const B_s;
+            static QState B1(BenchMsm * const me, QEvt const * const e);
+            static QState B1_e(BenchMsm * const me);
+            static QState B1_x(BenchMsm * const me);
+            static QMState const B1_s;
+                static QState B11(BenchMsm * const me, QEvt const * const e);
+                static QState B11_e(BenchMsm * const me);
+                static QState B11_x(BenchMsm * const me);
+                static QMState const B11_s;
+};
+
+// BenchHsm
+
+QState BenchHsm::InitialPseudoState(BenchHsm * const me, QEvt const * const e) {
+    (void)e;
+    return Q_TRAN(&BenchHsm::Root);
+}
+
+QState BenchHsm::Root(BenchHsm * const me, QEvt const * const e) {
+    switch (e->sig) {
+        case Q_INIT_SIG: {
+            return Q_TRAN(&BenchHsm::A11);
+        }
+    }
+    return Q_SUPER(&QHsm::top);
+}
+
+QState BenchHsm::A(BenchHsm * const me, QEvt const * const e) {
+    switch (e->sig) {
+        case Q_ENTRY_SIG:
+        case Q_EXIT_SIG: {
+            me->m_actionCnt++;
+            return Q_HANDLED();
+        }
+    }
+    return Q_SUPER(&BenchHsm::Root);
+}
+
+QState BenchHsm::A1(BenchHsm * const me, QEvt const * const e) {
+    switch (e->sig) {
+        case Q_ENTRY_SIG:
+        case Q_EXIT_SIG: {
+            me->m_actionCnt++;
+            return Q_HANDLED();
+        }
+    }
+    return Q_SUPER(&BenchHsm::A);
+}
+
+QState BenchHsm::A11(BenchHsm * const me, QEvt const * const e) {
+    switch (e->sig) {
+        case Q_ENTRY_SIG:
+        case Q_EXIT_SIG: {
+            me->m_actionCnt++;
+            return Q_HANDLED();
+        }
+        case DEEP_SIG: {
+            return Q_TRAN(&BenchHsm::B11);
+        }
+        case SIBLING_SIG: {
+            return Q_TRAN(&BenchHsm::A12);
+        }
+    }
+    return Q_SUPER(&BenchHsm::A1);
+}
+
+QState BenchHsm::A12(BenchHsm * const me, QEvt const * const e) {
+    switch (e->sig) {
+        case Q_ENTRY_SIG:
+        case Q_EXIT_SIG: {
+            me->m_actionCnt++;
+            return Q_HANDLED();
+        }
+        case SIBLING_SIG: {
+            return Q_TRAN(&BenchHsm::A11);
+        }
+    }
+    return Q_SUPER(&BenchHsm::A1);
+}
+
+QState BenchHsm::B(BenchHsm * const me, QEvt const * const e) {
+    switch (e->sig) {
+        case Q_ENTRY_SIG:
+        case Q_EXIT_SIG: {
+            me->m_actionCnt++;
+            return Q_HANDLED();
+        }
+    }
+    return Q_SUPER(&BenchHsm::Root);
+}
+
+QState BenchHsm::B1(BenchHsm * const me, QEvt const * const e) {
+    switch (e->sig) {
+        case Q_ENTRY_SIG:
+        case Q_EXIT_SIG: {
+            me->m_actionCnt++;
+            return Q_HANDLED();
+        }
+    }
+    return Q_SUPER(&BenchHsm::B);
+}
+
+QState BenchHsm::B11(BenchHsm * const me, QEvt const * const e) {
+    switch (e->sig) {
+        case Q_ENTRY_SIG:
+        case Q_EXIT_SIG: {
+            me->m_actionCnt++;
+            return Q_HANDLED();
+        }
+        case DEEP_SIG: {
+            return Q_TRAN(&BenchHsm::A11);
+        }
+    }
+    return Q_SUPER(&BenchHsm::B1);
+}
+
+// BenchMsm
+
+QMState const BenchMsm::Root_s = {
+    static_cast<QMState const *>(0),
+    Q_STATE_CAST(&BenchMsm::Root),
+    Q_ACTION_CAST(0),
+    Q_ACTION_CAST(0),
+    Q_ACTION_CAST(&BenchMsm::Root_i)
+};
+
+QMState const BenchMsm::A_s = {
+    &BenchMsm::Root_s,
+    Q_STATE_CAST(&BenchMsm::A),
+    Q_ACTION_CAST(&BenchMsm::A_e),
+    Q_ACTION_CAST(&BenchMsm::A_x),
+    Q_ACTION_CAST(0)
+};
+
+QMState const BenchMsm::A1_s = {
+    &BenchMsm::A_s,
+    Q_STATE_CAST(&BenchMsm::A1),
+    Q_ACTION_CAST(&BenchMsm::A1_e),
+    Q_ACTION_CAST(&BenchMsm::A1_x),
+    Q_ACTION_CAST(0)
+};
+
+QMState const BenchMsm::A11_s = {
+    &BenchMsm::A1_s,
+    Q_STATE_CAST(&BenchMsm::A11),
+    Q_ACTION_CAST(&BenchMsm::A11_e),
+    Q_ACTION_CAST(&BenchMsm::A11_x),
+    Q_ACTION_CAST(0)
+};
+
+QMState const BenchMsm::A12_s = {
+    &BenchMsm::A1_s,
+    Q_STATE_CAST(&BenchMsm::A12),
+    Q_ACTION_CAST(&BenchMsm::A12_e),
+    Q_ACTION_CAST(&BenchMsm::A12_x),
+    Q_ACTION_CAST(0)
+};
+
+QMState const BenchMsm::B_s = {
+    &BenchMsm::Root_s,
+    Q_STATE_CAST(&BenchMsm::B),
+    Q_ACTION_CAST(&BenchMsm::B_e),
+    Q_ACTION_CAST(&BenchMsm::B_x),
+    Q_ACTION_CAST(0)
+};
+
+QMState const BenchMsm::B1_s = {
+    &BenchMsm::B_s,
+    Q_STATE_CAST(&BenchMsm::B1),
+    Q_ACTION_CAST(&BenchMsm::B1_e),
+    Q_ACTION_CAST(&BenchMsm::B1_x),
+    Q_ACTION_CAST(0)
+};
+
+QMState const BenchMsm::B11_s = {
+    &BenchMsm::B1_s,
+    Q_STATE_CAST(&BenchMsm::B11),
+    Q_ACTION_CAST(&BenchMsm::B11_e),
+    Q_ACTION_CAST(&BenchMsm::B11_x),
+    Q_ACTION_CAST(0)
+};
+
+QState BenchMsm::InitialPseudoState(BenchMsm * const me, QEvt const * const e) {
+    (void)e;
+    static struct {
+        QMState const *target;
+        QActionHandler act[2];
+    } const tatbl = {
+        &BenchMsm::Root_s,
+        {
+            Q_ACTION_CAST(&BenchMsm::Root_i),
+            Q_ACTION_CAST(0)
+        }
+    };
+    return QM_TRAN_INIT(&tatbl);
+}
+
+QState BenchMsm::Root(BenchMsm * const me, QEvt const * const e) {
+    (void)me;
+    (void)e;
+    return QM_SUPER();
+}
+
+QState BenchMsm::Root_i(BenchMsm * const me) {
+    static struct {
+        QMState const *target;
+        QActionHandler act[4];
+    } const tatbl = {
+        &BenchMsm::A11_s,
+        {
+            Q_ACTION_CAST(&BenchMsm::A_e),
+            Q_ACTION_CAST(&BenchMsm::A1_e),
+            Q_ACTION_CAST(&BenchMsm::A11_e),
+            Q_ACTION_CAST(0)
+        }
+    };
+    return QM_TRAN_INIT(&tatbl);
+}
+
+QState BenchMsm::A(BenchMsm * const me, QEvt const * const e) {
+    (void)me;
+    (void)e;
+    return QM_SUPER();
+}
+
+QState BenchMsm::A_e(BenchMsm * const me) {
+    me->m_actionCnt++;
+    return QM_ENTRY(&BenchMsm::A_s);
+}
+
+QState BenchMsm::A_x(BenchMsm * const me) {
+    me->m_actionCnt++;
+    return QM_EXIT(&BenchMsm::A_s);
+}
+
+QState BenchMsm::A1(BenchMsm * const me, QEvt const * const e) {
+    (void)me;
+    (void)e;
+    return QM_SUPER();
+}
+
+QState BenchMsm::A1_e(BenchMsm * const me) {
+    me->m_actionCnt++;
+    return QM_ENTRY(&BenchMsm::A1_s);
+}
+
+QState BenchMsm::A1_x(BenchMsm * const me) {
+    me->m_actionCnt++;
+    return QM_EXIT(&BenchMsm::A1_s);
+}
+
+QState BenchMsm::A11(BenchMsm * const me, QEvt const * const e) {
+    switch (e->sig) {
+        case DEEP_SIG: {
+            static struct {
+                QMState const *target;
+                QActionHandler act[7];
+            } const tatbl = {
+                &BenchMsm::B11_s,
+                {
+                    Q_ACTION_CAST(&BenchMsm::A11_x),
+                    Q_ACTION_CAST(&BenchMsm::A1_x),
+                    Q_ACTION_CAST(&BenchMsm::A_x),
+                    Q_ACTION_CAST(&BenchMsm::B_e),
+                    Q_ACTION_CAST(&BenchMsm::B1_e),
+                    Q_ACTION_CAST(&BenchMsm::B11_e),
+                    Q_ACTION_CAST(0)
+                }
+            };
+            return QM_TRAN(&tatbl);
+        }
+        case SIBLING_SIG: {
+            static struct {
+                QMState const *target;
+                QActionHandler act[3];
+            } const tatbl = {
+                &BenchMsm::A12_s,
+                {
+                    Q_ACTION_CAST(&BenchMsm::A11_x),
+                    Q_ACTION_CAST(&BenchMsm::A12_e),
+                    Q_ACTION_CAST(0)
+                }
+            };
+            return QM_TRAN(&tatbl);
+        }
+    }
+    return QM_SUPER();
+}
+
+QState BenchMsm::A11_e(BenchMsm * const me) {
+    me->m_actionCnt++;
+    return QM_ENTRY(&BenchMsm::A11_s);
+}
+
+QState BenchMsm::A11_x(BenchMsm * const me) {
+    me->m_actionCnt++;
+    return QM_EXIT(&BenchMsm::A11_s);
+}
+
+QState BenchMsm::A12(BenchMsm * const me, QEvt const * const e) {
+    switch (e->sig) {
+        case SIBLING_SIG: {
+            static struct {
+                QMState const *target;
+                QActionHandler act[3];
+            } const tatbl = {
+                &BenchMsm::A11_s,
+                {
+                    Q_ACTION_CAST(&BenchMsm::A12_x),
+                    Q_ACTION_CAST(&BenchMsm::A11_e),
+                    Q_ACTION_CAST(0)
+                }
+            };
+            return QM_TRAN(&tatbl);
+        }
+    }
+    return QM_SUPER();
+}
+
+QState BenchMsm::A12_e(BenchMsm * const me) {
+    me->m_actionCnt++;
+    return QM_ENTRY(&BenchMsm::A12_s);
+}
+
+QState BenchMsm::A12_x(BenchMsm * const me) {
+    me->m_actionCnt++;
+    return QM_EXIT(&BenchMsm::A12_s);
+}
+
+QState BenchMsm::B(BenchMsm * const me, QEvt const * const e) {
+    (void)me;
+    (void)e;
+    return QM_SUPER();
+}
+
+QState BenchMsm::B_e(BenchMsm * const me) {
+    me->m_actionCnt++;
+    return QM_ENTRY(&BenchMsm::B_s);
+}
+
+QState BenchMsm::B_x(BenchMsm * const me) {
+    me->m_actionCnt++;
+    return QM_EXIT(&BenchMsm::B_s);
+}
+
+QState BenchMsm::B1(BenchMsm * const me, QEvt const * const e) {
+    (void)me;
+    (void)e;
+    return QM_SUPER();
+}
+
+QState BenchMsm::B1_e(BenchMsm * const me) {
+    me->m_actionCnt++;
+    return QM_ENTRY(&BenchMsm::B1_s);
+}
+
+QState BenchMsm::B1_x(BenchMsm * const me) {
+    me->m_actionCnt++;
+    return QM_EXIT(&BenchMsm::B1_s);
+}
+
+QState BenchMsm::B11(BenchMsm * const me, QEvt const * const e) {
+    switch (e->sig) {
+        case DEEP_SIG: {
+            static struct {
+                QMState const *target;
+                QActionHandler act[7];
+            } const tatbl = {
+                &BenchMsm::A11_s,
+                {
+                    Q_ACTION_CAST(&BenchMsm::B11_x),
+                    Q_ACTION_CAST(&BenchMsm::B1_x),
+                    Q_ACTION_CAST(&BenchMsm::B_x),
+                    Q_ACTION_CAST(&BenchMsm::A_e),
+                    Q_ACTION_CAST(&BenchMsm::A1_e),
+                    Q_ACTION_CAST(&BenchMsm::A11_e),
+                    Q_ACTION_CAST(0)
+                }
+            };
+            return QM_TRAN(&tatbl);
+        }
+    }
+    return QM_SUPER();
+}
+
+QState BenchMsm::B11_e(BenchMsm * const me) {
+    me->m_actionCnt++;
+    return QM_ENTRY(&BenchMsm::B11_s);
+}
+
+QState BenchMsm::B11_x(BenchMsm * const me) {
+    me->m_actionCnt++;
+    return QM_EXIT(&BenchMsm::B11_s);
+}
+
+// TranBench
+
+static BenchHsm benchHsm;
+static BenchMsm benchMsm;
+static QEvt const benchEvt[TranBench::TEST_COUNT] = {
+    QEvt(DEEP_SIG, QEvt::STATIC_EVT),
+    QEvt(SIBLING_SIG, QEvt::STATIC_EVT)
+};
+
+// Each event toggles between two states, so it is dispatched an even number of times to end
+// in the initial state A11. Time is wall time and includes any preemption, so min is the most
+// reliable figure.
+static void Measure(QHsm &sm, QEvt const *e, uint32_t count, TranBench::Result &result) {
+    result.m_count = 0;
+    result.m_min = 0xFFFFFFFF;
+    result.m_max = 0;
+    result.m_total = 0;
+    for (uint32_t i = 0; i < count * 2; i++) {
+        uint32_t startTime = Prof::GetTime();
+        sm.dispatch(e);
+        uint32_t time = Prof::GetTime() - startTime;
+        result.m_count++;
+        result.m_min = LESS(result.m_min, time);
+        result.m_max = GREATER(result.m_max, time);
+        result.m_total += time;
+    }
+}
+
+void TranBench::Run(uint32_t count, Result hsmResult[TEST_COUNT], Result msmResult[TEST_COUNT]) {
+    static bool initialized = false;
+    if (!initialized) {
+        benchHsm.init();
+        benchMsm.init();
+        initialized = true;
+    }
+    for (uint32_t test = 0; test < TEST_COUNT; test++) {
+        Measure(benchHsm, &benchEvt[test], count, hsmResult[test]);
+        Measure(benchMsm, &benchEvt[test], count, msmResult[test]);
+    }
+    // Both machines must have run the same entry and exit actions.
+    FW_ASSERT(benchHsm.m_actionCnt == benchMsm.m_actionCnt);
+}
+
+} // namespace APP
@@ -58,10 +58,11 @@ static CmdStatus Test(Console &console, Evt const *e) {
 }
 
 static CmdStatus List(Console &console, Evt const *e);
-static CmdHandler const cmdHandler[] = {
+static constexpr CmdHandler cmdHandler[] = {
+    { "?",          List,       "List commands", 0 },
     { "test",       Test,       "Test command", 0 },
-    { "?",          List,       "List commands", 0 }
 };
+CMD_TABLE_ASSERT(cmdHandler);
 
 static CmdStatus List(Console &console, Evt const *e) {
     return console.ListCmd(e, cmdHandler, ARRAY_COUNT(cmdHandler));
@@ -84,14 +84,15 @@ static CmdStatus ErrorReq(Console &console, Evt const *e) {
 }
 
 static CmdStatus List(Console &console, Evt const *e);
-static CmdHandler const cmdHandler[] = {
+static constexpr CmdHandler cmdHandler[] = {
+    { "?",       List,             "List commands", 0 },
+    { "e",       EastWest,         "East", 0 },
     { "n",       NorthSouth,       "North", 0 },
+    { "r",       ErrorReq,         "Error", 0 },
     { "s",       NorthSouth,       "South", 0 },
-    { "e",       EastWest,         "East", 0 },
     { "w",       EastWest,         "West", 0 },
-    { "r",       ErrorReq,         "Error", 0 },
-    { "?",       List,             "List commands", 0 },
 };
+CMD_TABLE_ASSERT(cmdHandler);
 
 static CmdStatus List(Console &console, Evt const *e) {
     return console.ListCmd(e, cmdHandler, ARRAY_COUNT(cmdHandler));
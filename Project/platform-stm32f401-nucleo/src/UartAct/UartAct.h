@@ -45,6 +45,7 @@
 #include "fw_timer.h"
 #include "fw_evt.h"
 #include "fw_pipe.h"
+#include "fw_spscpipe.h"
 #include "app_hsmn.h"
 #include "UartIn.h"
 #include "UartOut.h"
@@ -120,7 +121,7 @@ protected:
 
     Hsmn m_client;
     Fifo *m_outFifo;
-    Fifo *m_inFifo;
+    SpscFifo *m_inFifo;
 
     Timer m_stateTimer;
 
@@ -42,6 +42,7 @@
 #include "fw_def.h"
 #include "fw_evt.h"
 #include "fw_pipe.h"
+#include "fw_spscpipe.h"
 #include "app_hsmn.h"
 
 using namespace QP;
@@ -66,13 +67,13 @@ public:
     enum {
         TIMEOUT_MS = 200
     };
-    UartActStartReq(Hsmn to, Hsmn from, Sequence seq, Fifo *outFifo, Fifo *inFifo) :
+    UartActStartReq(Hsmn to, Hsmn from, Sequence seq, Fifo *outFifo, SpscFifo *inFifo) :
         Evt(UART_ACT_START_REQ, to, from, seq), m_outFifo(outFifo), m_inFifo(inFifo) {}
     Fifo *GetOutFifo() const { return m_outFifo; }
-    Fifo *GetInFifo() const { return m_inFifo; }
+    SpscFifo *GetInFifo() const { return m_inFifo; }
 private:
     Fifo *m_outFifo;
-    Fifo *m_inFifo;
+    SpscFifo *m_inFifo;
 };
 
 class UartActStartCfm : public ErrorEvt {
@@ -72,16 +72,35 @@ static uint16_t GetInst(Hsmn hsmn) {
     return inst;
 }
 
-void UartIn::DmaCompleteCallback(Hsmn hsmn) {
+UartIn *UartIn::m_inst[UART_IN_COUNT];
+
+// Called in ISR. Coalesces DMA_RECV events. While one is pending, further ones are not posted since the pending
+// one will pick up all data received up to the time it is processed. A burst of data therefore results in at
+// most one event in the queue, while an isolated keystroke is still handled without delay.
+void UartIn::PostDmaRecv(Hsmn hsmn) {
+    UartIn *me = m_inst[GetInst(hsmn)];
+    if (me) {
+        if (me->m_recvPending) {
+            return;
+        }
+        me->m_recvPending = true;
+    }
     static Sequence counter = 10000;
     Evt *evt = new Evt(UartIn::DMA_RECV, hsmn, HSM_UNDEF, counter++);
     Fw::Post(evt);
 }
 
+void UartIn::DmaCompleteCallback(Hsmn hsmn) {
+    PostDmaRecv(hsmn);
+}
+
 void UartIn::DmaHalfCompleteCallback(Hsmn hsmn) {
-    static Sequence counter = 10000;
-    Evt *evt = new Evt(UartIn::DMA_RECV, hsmn, HSM_UNDEF, counter++);
-    Fw::Post(evt);
+    PostDmaRecv(hsmn);
+}
+
+// Called in ISR when the RX line becomes idle after receiving data, i.e. when the sender pauses for one frame.
+void UartIn::IdleCallback(Hsmn hsmn) {
+    PostDmaRecv(hsmn);
 }
 
 void UartIn::RxCallback(Hsmn hsmn, HwError error) {
@@ -110,6 +129,22 @@ void UartIn::DisableRxInt() {
     QF_CRIT_EXIT(crit);
 }
 
+void UartIn::EnableIdleInt() {
+    QF_CRIT_STAT_TYPE crit;
+    QF_CRIT_ENTRY(crit);
+    // Clear stale idle flag (by reading SR followed by DR) to avoid a spurious interrupt.
+    __HAL_UART_CLEAR_IDLEFLAG(&m_hal);
+    SET_BIT(m_hal.Instance->CR1, USART_CR1_IDLEIE);
+    QF_CRIT_EXIT(crit);
+}
+
+void UartIn::DisableIdleInt() {
+    QF_CRIT_STAT_TYPE crit;
+    QF_CRIT_ENTRY(crit);
+    CLEAR_BIT(m_hal.Instance->CR1, USART_CR1_IDLEIE);
+    QF_CRIT_EXIT(crit);
+}
+
 void UartIn::CleanInvalidateCache(uint32_t addr, uint32_t len) {
     //SCB_CleanInvalidateDCache();
     // Cache not available on this platform.
@@ -120,8 +155,9 @@ void UartIn::CleanInvalidateCache(uint32_t addr, uint32_t len) {
 
 UartIn::UartIn(Hsmn hsmn, char const *name, UART_HandleTypeDef &hal) :
     Region((QStateHandler)&UartIn::InitialPseudoState, hsmn, name),
-    m_hal(hal), m_manager(HSM_UNDEF), m_client(HSM_UNDEF), m_fifo(NULL), m_dataRecv(false), m_activeTimer(hsmn, ACTIVE_TIMER) {
+    m_hal(hal), m_manager(HSM_UNDEF), m_client(HSM_UNDEF), m_fifo(NULL), m_dataRecv(false), m_recvPending(false), m_activeTimer(hsmn, ACTIVE_TIMER) {
     SET_EVT_NAME(UART_IN);
+    m_inst[GetInst(hsmn)] = this;
 }
 
 QState UartIn::InitialPseudoState(UartIn * const me, QEvt const * const e) {
@@ -267,11 +303,14 @@ QState UartIn::Normal(UartIn * const me, QEvt const * const e) {
             HAL_StatusTypeDef result;
             result = HAL_UART_Receive_DMA(&me->m_hal, (uint8_t *)me->m_fifo->GetAddr(0), me->m_fifo->GetBufSize());
             FW_ASSERT(result == HAL_OK);
+            me->m_recvPending = false;
+            me->EnableIdleInt();
             status = Q_HANDLED();
             break;
         }
         case Q_EXIT_SIG: {
             EVENT(e);
+            me->DisableIdleInt();
             HAL_UART_DMAStop(&me->m_hal);
             me->DisableRxInt();
             status = Q_HANDLED();
@@ -279,6 +318,8 @@ QState UartIn::Normal(UartIn * const me, QEvt const * const e) {
         }
         case DMA_RECV: {
             EVENT(e);
+            // Clear before sampling the DMA counter so that data arriving after sampling trigger another event.
+            me->m_recvPending = false;
             // Sample DMA remaining count first. It may keep decrementing as data are being received.
             // Those that arrrive after this point will be processed on the next DMA_RECV event.
             // The FIFO write index is only updated in this region, so there is no need to enforce
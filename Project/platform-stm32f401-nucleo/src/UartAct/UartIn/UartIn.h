@@ -44,7 +44,7 @@
 #include "fw_region.h"
 #include "fw_timer.h"
 #include "fw_evt.h"
-#include "fw_pipe.h"
+#include "fw_spscpipe.h"
 #include "app_hsmn.h"
 
 using namespace QP;
@@ -54,6 +54,11 @@ namespace APP {
 
 class UartIn : public Region {
 public:
+    // Log is turned off in main(). Only ERROR, WARNING and CRITICAL are compiled.
+    enum {
+        LOG_CEILING = Log::TYPE_LOG
+    };
+
     UartIn(Hsmn hsmn, char const *name, UART_HandleTypeDef &hal);
     static void DmaCompleteCallback(Hsmn hsmn);
     static void DmaHalfCompleteCallback(Hsmn hsmn);
@@ -65,6 +70,7 @@ public:
     static const HwError HW_ERROR_FRAME   = 0x04;   // Frame error (e.g. caused by incorrect baud rate).
 
     static void RxCallback(Hsmn hsmn, HwError error = HW_ERROR_NONE);
+    static void IdleCallback(Hsmn hsmn);
 
 protected:
     static QState InitialPseudoState(UartIn * const me, QEvt const * const e);
@@ -78,13 +84,19 @@ protected:
 
     void EnableRxInt();
     void DisableRxInt();
+    void EnableIdleInt();
+    void DisableIdleInt();
+    static void PostDmaRecv(Hsmn hsmn);
     static void CleanInvalidateCache(uint32_t addr, uint32_t len);
 
+    static UartIn *m_inst[UART_IN_COUNT];   // Used by callbacks in ISR.
+
     UART_HandleTypeDef &m_hal;
     Hsmn m_manager;
     Hsmn m_client;
-    Fifo *m_fifo;
+    SpscFifo *m_fifo;
     bool m_dataRecv;
+    bool volatile m_recvPending;    // True if a DMA_RECV posted from ISR has not been processed.
     Timer m_activeTimer;
 
     enum{
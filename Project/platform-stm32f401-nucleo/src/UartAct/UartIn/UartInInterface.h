@@ -41,6 +41,7 @@
 
 #include "fw_def.h"
 #include "fw_evt.h"
+#include "fw_spscpipe.h"
 #include "app_hsmn.h"
 
 using namespace QP;
@@ -66,12 +67,12 @@ public:
     enum {
         TIMEOUT_MS = 100
     };
-    UartInStartReq(Hsmn to, Hsmn from, Sequence seq, Fifo *fifo, Hsmn client) :
+    UartInStartReq(Hsmn to, Hsmn from, Sequence seq, SpscFifo *fifo, Hsmn client) :
         Evt(UART_IN_START_REQ, to, from, seq), m_fifo(fifo), m_client(client) {}
-    Fifo *GetFifo() const { return m_fifo; }
+    SpscFifo *GetFifo() const { return m_fifo; }
     Hsmn GetClient() const { return m_client; }
 private:
-    Fifo *m_fifo;
+    SpscFifo *m_fifo;
     Hsmn m_client;
 };
 
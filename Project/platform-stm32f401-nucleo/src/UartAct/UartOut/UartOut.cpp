@@ -75,7 +75,23 @@ static uint16_t GetInst(Hsmn hsmn) {
     return inst;
 }
 
+UartOut *UartOut::m_inst[UART_OUT_COUNT];
+
+// Called in ISR. When chaining is enabled (in Normal state), the next contiguous part of the FIFO
+// (after wrap-around or data written during the last transfer) is started here so the line stays busy.
+// DMA_DONE is only posted when the FIFO is empty or chaining is disabled.
 void UartOut::DmaCompleteCallback(Hsmn hsmn) {
+    UartOut *me = m_inst[GetInst(hsmn)];
+    if (me) {
+        me->m_dmaDoneCount++;
+    }
+    if (me && me->m_chain) {
+        me->m_fifo->IncReadIndex(me->m_writeCount);
+        me->m_writeCount = 0;
+        if (me->StartDma()) {
+            return;
+        }
+    }
     static Sequence counter = 10000;
     Evt *evt = new Evt(UartOut::DMA_DONE, hsmn, HSM_UNDEF, counter++);
     Fw::Post(evt);
@@ -89,11 +105,29 @@ void UartOut::CleanCache(uint32_t addr, uint32_t len) {
     (void)len;
 }
 
+// Starts DMA transmission of the contiguous part of the FIFO from the read index (zero-copy).
+// Returns the length started, or 0 if the FIFO is empty.
+uint32_t UartOut::StartDma() {
+    Fifo &fifo = *m_fifo;
+    uint32_t addr = fifo.GetReadAddr();
+    uint32_t len = fifo.GetUsedCount();
+    if ((addr + len) > fifo.GetEndAddr()) {
+        len = fifo.GetEndAddr() - addr;
+    }
+    if (len) {
+        fifo.CacheOp(UartOut::CleanCache, len);
+        m_writeCount = len;
+        HAL_UART_Transmit_DMA(&m_hal, (uint8_t*)addr, len);
+    }
+    return len;
+}
+
 UartOut::UartOut(Hsmn hsmn, char const *name, UART_HandleTypeDef &hal) :
     Region((QStateHandler)&UartOut::InitialPseudoState, hsmn, name),
-    m_hal(hal), m_manager(HSM_UNDEF), m_client(HSM_UNDEF), m_fifo(NULL), m_writeCount(0),
-    m_activeTimer(this->GetHsm().GetHsmn(), ACTIVE_TIMER) {
+    m_hal(hal), m_manager(HSM_UNDEF), m_client(HSM_UNDEF), m_fifo(NULL), m_writeCount(0), m_chain(false),
+    m_dmaDoneCount(0), m_lastDmaDoneCount(0), m_activeTimer(this->GetHsm().GetHsmn(), ACTIVE_TIMER) {
     SET_EVT_NAME(UART_OUT);
+    m_inst[GetInst(hsmn)] = this;
 }
 
 QState UartOut::InitialPseudoState(UartOut * const me, QEvt const * const e) {
@@ -249,6 +283,7 @@ QState UartOut::Active(UartOut * const me, QEvt const * const e) {
     switch (e->sig) {
         case Q_ENTRY_SIG: {
             EVENT(e);
+            me->m_lastDmaDoneCount = me->m_dmaDoneCount;
             me->m_activeTimer.Start(ACTIVE_TIMEOUT_MS);
             status = Q_HANDLED();
             break;
@@ -274,6 +309,16 @@ QState UartOut::Active(UartOut * const me, QEvt const * const e) {
         // Gallium - TODO Add HW_FAIL
         case ACTIVE_TIMER: {
             EVENT(e);
+            // Transfers are chained in ISR while data keeps coming, so the timer guards against lack of
+            // progress, i.e. no transfer completed within the timeout, rather than the duration of the
+            // whole output.
+            uint32_t dmaDoneCount = me->m_dmaDoneCount;
+            if (dmaDoneCount != me->m_lastDmaDoneCount) {
+                me->m_lastDmaDoneCount = dmaDoneCount;
+                me->m_activeTimer.Start(ACTIVE_TIMEOUT_MS);
+                status = Q_HANDLED();
+                break;
+            }
             Evt *evt = new UartOutFailInd(me->m_manager, GET_HSMN(), GEN_SEQ(), ERROR_TIMEOUT, GET_HSMN());
             Fw::Post(evt);
             status = Q_TRAN(&UartOut::Failed);
@@ -292,22 +337,16 @@ QState UartOut::Normal(UartOut * const me, QEvt const * const e) {
     switch (e->sig) {
         case Q_ENTRY_SIG: {
             EVENT(e);
-            // Zero-copy.
-            Fifo &fifo = *(me->m_fifo);
-            uint32_t addr = fifo.GetReadAddr();
-            uint32_t len = fifo.GetUsedCount();
-            if ((addr + len) > fifo.GetEndAddr()) {
-                len = fifo.GetEndAddr() - addr;
-            }
-            FW_ASSERT((len > 0) && (len <= fifo.GetUsedCount()));
-            me->m_fifo->CacheOp(UartOut::CleanCache, len);
-            HAL_UART_Transmit_DMA(&me->m_hal, (uint8_t*)addr, len);
-            me->m_writeCount = len;
+            // Must be enabled before the transfer starts since it may complete at any time.
+            me->m_chain = true;
+            uint32_t len = me->StartDma();
+            FW_ASSERT(len > 0);
             status = Q_HANDLED();
             break;
         }
         case Q_EXIT_SIG: {
             EVENT(e);
+            me->m_chain = false;
             status = Q_HANDLED();
             break;
         }
@@ -321,7 +360,10 @@ QState UartOut::Normal(UartOut * const me, QEvt const * const e) {
         }
         case DMA_DONE: {
             //EVENT(e);
+            // m_writeCount is 0 if the completed transfer was already consumed in ISR. Data may have been
+            // written after the ISR found the FIFO empty.
             me->m_fifo->IncReadIndex(me->m_writeCount);
+            me->m_writeCount = 0;
             Evt *evt;
             if (me->m_fifo->GetUsedCount()) {
                 evt = new Evt(CONTINUE, GET_HSMN());
@@ -372,6 +414,7 @@ QState UartOut::StopWait(UartOut * const me, QEvt const * const e) {
         case DMA_DONE: {
             EVENT(e);
             me->m_fifo->IncReadIndex(me->m_writeCount);
+            me->m_writeCount = 0;
             Evt *evt = new Evt(DONE, GET_HSMN());
             me->PostSync(evt);
             status = Q_HANDLED();
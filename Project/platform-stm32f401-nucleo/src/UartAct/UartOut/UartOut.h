@@ -53,6 +53,11 @@ namespace APP {
 
 class UartOut : public Region {
 public:
+    // Log is turned off in main(). Only ERROR, WARNING and CRITICAL are compiled.
+    enum {
+        LOG_CEILING = Log::TYPE_LOG
+    };
+
     UartOut(Hsmn hsmn, char const *name, UART_HandleTypeDef &hal);
     static void DmaCompleteCallback(Hsmn hsmn);
 
@@ -68,12 +73,18 @@ protected:
             static QState Failed(UartOut * const me, QEvt const * const e);
 
     static void CleanCache(uint32_t addr, uint32_t len);
+    uint32_t StartDma();
+
+    static UartOut *m_inst[UART_OUT_COUNT];     // Used by DmaCompleteCallback() to chain transfers.
 
     UART_HandleTypeDef &m_hal;
     Hsmn m_manager;     // Managing HSM
     Hsmn m_client;      // User HSM
     Fifo *m_fifo;
-    uint32_t m_writeCount;
+    uint32_t volatile m_writeCount;     // Length of the current DMA transfer.
+    bool volatile m_chain;              // True to start the next transfer in ISR when one completes.
+    uint32_t volatile m_dmaDoneCount;   // Number of completed transfers. Incremented in ISR.
+    uint32_t m_lastDmaDoneCount;        // m_dmaDoneCount when m_activeTimer was last started.
     Timer m_activeTimer;
 
     enum {
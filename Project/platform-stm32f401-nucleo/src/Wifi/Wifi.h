@@ -54,11 +54,19 @@ public:
 
 protected:
 #define WIFI_TIMER_EVT \
-    ADD_EVT(STATE_TIMER)
+    ADD_EVT(STATE_TIMER) \
+    ADD_EVT(TX_TIMER) \
+    ADD_EVT(CMD_TIMER)
 
 #define WIFI_INTERNAL_EVT \
     ADD_EVT(DONE) \
-    ADD_EVT(FAILED)
+    ADD_EVT(FAILED) \
+    ADD_EVT(AT_WIND) \
+    ADD_EVT(AT_OK) \
+    ADD_EVT(AT_ERROR) \
+    ADD_EVT(AT_SOCK_ID) \
+    ADD_EVT(AT_PAYLOAD) \
+    ADD_EVT(ALL_CLOSED)
 
 #undef ADD_EVT
 #define ADD_EVT(e_) e_,
@@ -62,7 +62,8 @@ namespace APP {
     ADD_EVT(WIFI_DISCONNECT_REQ) \
     ADD_EVT(WIFI_DISCONNECT_CFM) \
     ADD_EVT(WIFI_SEND_REQ) \
-    ADD_EVT(WIFI_SEND_CFM)
+    ADD_EVT(WIFI_SEND_CFM) \
+    ADD_EVT(WIFI_SEND_MSG_REQ)
 
 #undef ADD_EVT
 #define ADD_EVT(e_) e_,
@@ -74,6 +75,15 @@ enum {
 
 enum {
     WIFI_REASON_UNSPEC = 0,
+    WIFI_REASON_AT_ERROR,       // Module responded with ERROR.
+    WIFI_REASON_NO_RSP,         // No response from module after retries.
+    WIFI_REASON_QUEUE_FULL,     // Too many outstanding commands.
+};
+
+// Number of concurrent socket connections. Requests select a connection by its index (0 to WIFI_CONN_COUNT-1),
+// which is chosen by the requester, e.g. a fixed index per user.
+enum {
+    WIFI_CONN_COUNT = 4,
 };
 
 class WifiStartReq : public Evt {
@@ -157,15 +167,17 @@ public:
     enum {
         TIMEOUT_MS = 5000
     };
-    WifiConnectReq(Hsmn to, Hsmn from, Sequence seq, char const *domain, uint16_t port) :
-        Evt(WIFI_CONNECT_REQ, to, from, seq), m_port(port) {
+    WifiConnectReq(Hsmn to, Hsmn from, Sequence seq, char const *domain, uint16_t port, uint8_t conn = 0) :
+        Evt(WIFI_CONNECT_REQ, to, from, seq), m_port(port), m_conn(conn) {
         STRING_COPY(m_domain, domain, sizeof(m_domain));
     }
     char const *GetDomain() const { return m_domain; }
     uint16_t GetPort() const { return m_port; }
+    uint8_t GetConn() const { return m_conn; }
 private:
     char m_domain[100];
     uint16_t m_port;
+    uint8_t m_conn;
 };
 
 class WifiConnectCfm : public ErrorEvt {
@@ -180,8 +192,11 @@ public:
     enum {
         TIMEOUT_MS = 5000
     };
-    WifiDisconnectReq(Hsmn to, Hsmn from, Sequence seq) :
-        Evt(WIFI_DISCONNECT_REQ, to, from, seq) {}
+    WifiDisconnectReq(Hsmn to, Hsmn from, Sequence seq, uint8_t conn = 0) :
+        Evt(WIFI_DISCONNECT_REQ, to, from, seq), m_conn(conn) {}
+    uint8_t GetConn() const { return m_conn; }
+private:
+    uint8_t m_conn;
 };
 
 class WifiDisconnectCfm : public ErrorEvt {
@@ -194,15 +209,38 @@ public:
 class WifiSendReq : public Evt {
 public:
     enum {
-        TIMEOUT_MS = 5000
+        TIMEOUT_MS = 5000,
+        MAX_LEN = 127
     };
-    WifiSendReq(Hsmn to, Hsmn from, Sequence seq, char const *data) :
-        Evt(WIFI_SEND_REQ, to, from, seq) {
+    WifiSendReq(Hsmn to, Hsmn from, Sequence seq, char const *data, uint8_t conn = 0) :
+        Evt(WIFI_SEND_REQ, to, from, seq), m_conn(conn) {
         STRING_COPY(m_data, data, sizeof(m_data));
     }
     char const *GetData() const { return m_data; }
+    uint8_t GetConn() const { return m_conn; }
+private:
+    char m_data[MAX_LEN + 1];
+    uint8_t m_conn;
+};
+
+// Sends a short binary message. It fits in the small event pool. Messages sent back-to-back are combined
+// into a single socket write by WifiSt. No confirmation is sent.
+class WifiSendMsgReq : public Evt {
+public:
+    enum {
+        MAX_LEN = 16
+    };
+    WifiSendMsgReq(Hsmn to, Hsmn from, Sequence seq, void const *data, uint32_t len, uint8_t conn = 0) :
+        Evt(WIFI_SEND_MSG_REQ, to, from, seq), m_len(LESS(len, sizeof(m_data))), m_conn(conn) {
+        memcpy(m_data, data, m_len);
+    }
+    char const *GetData() const { return m_data; }
+    uint32_t GetLen() const { return m_len; }
+    uint8_t GetConn() const { return m_conn; }
 private:
-    char m_data[128];
+    char m_data[MAX_LEN];
+    uint8_t m_len;
+    uint8_t m_conn;
 };
 
 class WifiSendCfm : public ErrorEvt {
@@ -0,0 +1,208 @@
+/*******************************************************************************
+ * Copyright (C) Gallium Studio LLC. All rights reserved.
+ *
+ * This program is open source software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Alternatively, this program may be distributed and modified under the
+ * terms of Gallium Studio LLC commercial licenses, which expressly supersede
+ * the GNU General Public License and are specifically designed for licensees
+ * interested in retaining the proprietary status of their code.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * Contact information:
+ * Website - https://www.galliumstudio.com
+ * Source repository - https://github.com/galliumstudio
+ * Email - admin@galliumstudio.com
+ ******************************************************************************/
+
+#include <stddef.h>
+#include "qpcpp.h"
+#include "fw_macro.h"
+#include "fw_assert.h"
+#include "AtParser.h"
+
+FW_DEFINE_THIS_FILE("AtParser.cpp")
+
+namespace APP {
+
+// Indexed by Token. NULL for tokens not matched at start of line.
+char const * const AtParser::m_keyword[] = {
+    NULL,
+    "+WIND:",
+    "OK",
+    "ERROR",
+    " ID:",
+    NULL,
+};
+
+char const AtParser::PAYLOAD_PREFIX[PAYLOAD_PREFIX_LEN + 1] = "Mdev";
+// Must not start with the first character of any keyword.
+char const AtParser::RSP_PREFIX[] = "AT-S.";
+
+void AtParser::Reset() {
+    m_lineState = LINE_START;
+    m_keywordToken = TOKEN_NONE;
+    m_keywordIdx = 0;
+    m_fieldValid = 0;
+    m_fieldIdx = 0;
+    m_payloadIdx = 0;
+    StartField();
+}
+
+// Returns false if field idx of the last WIND or SOCK_ID token is not numeric.
+bool AtParser::GetField(uint32_t idx, uint32_t &value) const {
+    if ((idx >= FIELD_COUNT) || !(m_fieldValid & BIT_MASK_AT(idx))) {
+        return false;
+    }
+    value = m_field[idx];
+    return true;
+}
+
+void AtParser::StartField() {
+    if (m_fieldIdx < FIELD_COUNT) {
+        m_field[m_fieldIdx] = 0;
+    }
+    m_fieldDigits = 0;
+    m_fieldNumeric = true;
+}
+
+void AtParser::EndField() {
+    if ((m_fieldIdx < FIELD_COUNT) && m_fieldNumeric && m_fieldDigits) {
+        m_fieldValid |= BIT_MASK_AT(m_fieldIdx);
+    }
+    m_fieldIdx++;
+}
+
+AtParser::Token AtParser::Parse(char c) {
+    FW_ASSERT(m_payloadIdx < PAYLOAD_LEN);
+    // Collect payload once its prefix has been matched.
+    if (m_payloadIdx >= PAYLOAD_PREFIX_LEN) {
+        m_payload[m_payloadIdx++] = c;
+        if (m_payloadIdx == PAYLOAD_LEN) {
+            m_payloadIdx = 0;
+            return TOKEN_PAYLOAD;
+        }
+        return TOKEN_NONE;
+    }
+    // Prefix has no repeated characters, so on mismatch only the current character needs to be checked
+    // against the start of the prefix.
+    if (c == PAYLOAD_PREFIX[m_payloadIdx]) {
+        m_payload[m_payloadIdx++] = c;
+    } else if (c == PAYLOAD_PREFIX[0]) {
+        m_payload[0] = c;
+        m_payloadIdx = 1;
+    } else {
+        m_payloadIdx = 0;
+    }
+    if (m_payloadIdx == PAYLOAD_PREFIX_LEN) {
+        // Payload is not part of any line token.
+        m_lineState = LINE_SKIP;
+        return TOKEN_NONE;
+    }
+    return ParseLine(c);
+}
+
+AtParser::Token AtParser::ParseLine(char c) {
+    Token token = TOKEN_NONE;
+    if ((c == '\r') || (c == '\n')) {
+        if ((m_lineState == LINE_KEYWORD) && (m_keyword[m_keywordToken][m_keywordIdx] == 0)) {
+            token = m_keywordToken;
+        } else if (m_lineState == LINE_FIELD) {
+            EndField();
+            if (m_fieldValid & BIT_MASK_AT(0)) {
+                token = m_keywordToken;
+            }
+        }
+        m_lineState = LINE_START;
+        return token;
+    }
+    switch (m_lineState) {
+        case LINE_START: {
+            m_lineState = LINE_SKIP;
+            if (c == RSP_PREFIX[0]) {
+                m_keywordIdx = 1;
+                m_lineState = LINE_PREFIX;
+                break;
+            }
+            for (uint32_t i = TOKEN_WIND; i < ARRAY_COUNT(m_keyword); i++) {
+                if (m_keyword[i] && (c == m_keyword[i][0])) {
+                    m_keywordToken = static_cast<Token>(i);
+                    m_keywordIdx = 1;
+                    m_lineState = LINE_KEYWORD;
+                    break;
+                }
+            }
+            break;
+        }
+        case LINE_PREFIX: {
+            if (c != RSP_PREFIX[m_keywordIdx]) {
+                m_lineState = LINE_SKIP;
+            } else if (RSP_PREFIX[++m_keywordIdx] == 0) {
+                // Keyword follows.
+                m_lineState = LINE_START;
+            }
+            break;
+        }
+        case LINE_KEYWORD: {
+            char k = m_keyword[m_keywordToken][m_keywordIdx];
+            if (k == 0) {
+                // Keyword completed earlier. Only accepted if followed by a delimiter.
+                if (c == ':') {
+                    token = m_keywordToken;
+                }
+                m_lineState = LINE_SKIP;
+            } else if (c != k) {
+                m_lineState = LINE_SKIP;
+            } else if ((m_keyword[m_keywordToken][++m_keywordIdx] == 0) &&
+                       ((m_keywordToken == TOKEN_WIND) || (m_keywordToken == TOKEN_SOCK_ID))) {
+                m_fieldValid = 0;
+                m_fieldIdx = 0;
+                StartField();
+                m_lineState = LINE_FIELD;
+            }
+            break;
+        }
+        case LINE_FIELD: {
+            if (c == ':') {
+                EndField();
+                StartField();
+            } else if ((c >= '0') && (c <= '9') && (m_fieldDigits < FIELD_MAX_DIGITS)) {
+                if (m_fieldIdx < FIELD_COUNT) {
+                    m_field[m_fieldIdx] = m_field[m_fieldIdx] * 10 + (c - '0');
+                }
+                m_fieldDigits++;
+            } else if ((c != ' ') || m_fieldDigits) {
+                // Leading spaces are allowed, as in " ID: 00".
+                m_fieldNumeric = false;
+            }
+            break;
+        }
+        case LINE_SKIP: {
+            break;
+        }
+    }
+    return token;
+}
+
+} // namespace APP
@@ -0,0 +1,115 @@
+/*******************************************************************************
+ * Copyright (C) Gallium Studio LLC. All rights reserved.
+ *
+ * This program is open source software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Alternatively, this program may be distributed and modified under the
+ * terms of Gallium Studio LLC commercial licenses, which expressly supersede
+ * the GNU General Public License and are specifically designed for licensees
+ * interested in retaining the proprietary status of their code.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * Contact information:
+ * Website - https://www.galliumstudio.com
+ * Source repository - https://github.com/galliumstudio
+ * Email - admin@galliumstudio.com
+ ******************************************************************************/
+
+#ifndef AT_PARSER_H
+#define AT_PARSER_H
+
+#include <stdint.h>
+
+namespace APP {
+
+// Incremental tokenizer of responses from the Wifi module. Data are fed one byte at a time as they are read
+// from the input FIFO, so a token split across two reads is still recognized. Each byte is examined once
+// for all tokens.
+// Recognized tokens:
+// 1. "+WIND:<code>:<field>..." at the start of a line. Returned at end of line. Numeric fields are available
+//    from GetField(), with the code being field 0, e.g. the socket id of "+WIND:55:Pending Data:<id>:<len>"
+//    is field 2.
+// 2. "OK" and "ERROR" forming a whole line, or followed by ':'. They may be prefixed with "AT-S." as with SPWF04.
+// 3. " ID: <id>" as the response to socket open. The socket id is field 0.
+// 4. Application payload of PAYLOAD_LEN bytes starting with PAYLOAD_PREFIX anywhere in the stream. Payload
+//    bytes are binary and are not checked for line endings.
+class AtParser {
+public:
+    enum Token {
+        TOKEN_NONE,
+        TOKEN_WIND,
+        TOKEN_OK,
+        TOKEN_ERROR,
+        TOKEN_SOCK_ID,
+        TOKEN_PAYLOAD,
+    };
+    enum {
+        PAYLOAD_LEN = 12,       // Must match sizeof(MicrowaveMsgFormat::Message).
+        PAYLOAD_PREFIX_LEN = 4,
+        FIELD_COUNT = 4,        // Number of leading fields of a line that are captured.
+    };
+
+    AtParser() { Reset(); }
+    void Reset();
+    Token Parse(char c);
+    uint32_t GetWindCode() const { return m_field[0]; }
+    uint32_t GetSockId() const { return m_field[0]; }
+    bool GetField(uint32_t idx, uint32_t &value) const;
+    char const *GetPayload() const { return m_payload; }
+
+protected:
+    Token ParseLine(char c);
+    void StartField();
+    void EndField();
+
+    enum LineState {
+        LINE_START,             // At start of line.
+        LINE_PREFIX,            // Matching the optional response prefix RSP_PREFIX.
+        LINE_KEYWORD,           // Matching the keyword m_keyword[m_keywordToken].
+        LINE_FIELD,             // Reading ':' separated fields following the keyword.
+        LINE_SKIP,              // Ignoring the rest of the line.
+    };
+    enum {
+        FIELD_MAX_DIGITS = 9,
+    };
+
+    static char const * const m_keyword[];
+    static char const PAYLOAD_PREFIX[PAYLOAD_PREFIX_LEN + 1];
+    static char const RSP_PREFIX[];
+
+    LineState m_lineState;
+    Token m_keywordToken;
+    uint32_t m_keywordIdx;      // Index of the next keyword character to match.
+    uint32_t m_field[FIELD_COUNT];
+    uint32_t m_fieldValid;      // Bit n set if field n is numeric.
+    uint32_t m_fieldIdx;        // Index of the field being read.
+    uint32_t m_fieldDigits;     // Number of digits of the field being read. Zero if it is not numeric.
+    bool m_fieldNumeric;
+    uint32_t m_payloadIdx;      // Count of payload bytes matched or collected.
+    char m_payload[PAYLOAD_LEN];
+};
+
+} // namespace APP
+
+#endif // AT_PARSER_H
@@ -134,16 +134,312 @@ static void handleSignal(const MicrowaveMsgFormat::Message& message, Hsmn to, Hs
 	}
 }
 
-void WifiSt::Write(char *const atCmd) {
-    FW_ASSERT(atCmd);
-    FW_ASSERT(m_outIfHsmn != HSM_UNDEF);
-    bool status;
-    // @todo - Check result against atCmd length.
-    uint32_t result = m_outFifo.Write(reinterpret_cast<uint8_t const *>(atCmd), strlen(atCmd), &status);
-    if (status) {
-        Evt *evt = new Evt(UART_OUT_WRITE_REQ, m_outIfHsmn);
+WifiSt::CmdStat WifiSt::m_cmdStat;
+
+// Formats an AT command and queues it in the command tracker. conn is the connection the command applies to,
+// or CONN_NONE. resend is true if the command may be resent on timeout (see QueueCmd()). Returns false if the
+// tracker is full.
+bool WifiSt::Write(uint32_t conn, bool resend, char const *format, ...) {
+    FW_ASSERT(format);
+    char buf[CMD_LEN];
+    va_list arg;
+    va_start(arg, format);
+    uint32_t len = vsnprintf(buf, sizeof(buf), format, arg);
+    va_end(arg);
+    FW_ASSERT(len < sizeof(buf));
+    return QueueCmd(HSM_UNDEF, 0, buf, len, conn, resend);
+}
+
+// Opens the connection selected by req. WifiConnectCfm is sent to the requester when the socket open command
+// completes (see PopCmd()). Returns an error if it cannot be started, in which case no confirmation is sent.
+Error WifiSt::OpenConn(WifiConnectReq const &req) {
+    uint32_t idx = req.GetConn();
+    if (idx >= WIFI_CONN_COUNT) {
+        return ERROR_PARAM;
+    }
+    Conn &conn = m_conn[idx];
+    if (conn.m_state != CONN_FREE) {
+        return ERROR_STATE;
+    }
+    // Not resent since the module may have opened the socket already.
+    if (!Write(idx, false, "at+s.sockon=%s,%d,,t\n\r", req.GetDomain(), req.GetPort())) {
+        return ERROR_UNAVAIL;
+    }
+    conn.m_state = CONN_OPENING;
+    conn.m_idValid = false;
+    conn.m_from = req.GetFrom();
+    conn.m_seq = req.GetSeq();
+    return ERROR_SUCCESS;
+}
+
+// Frees a connection and discards its queued messages. It does not close the socket. ALL_CLOSED is posted
+// when no connection is left.
+void WifiSt::CloseConn(uint32_t idx) {
+    FW_ASSERT(idx < WIFI_CONN_COUNT);
+    Conn &conn = m_conn[idx];
+    conn.m_state = CONN_FREE;
+    conn.m_idValid = false;
+    conn.m_txLen = 0;
+    conn.m_txDue = false;
+    for (uint32_t i = 0; i < WIFI_CONN_COUNT; i++) {
+        if (m_conn[i].m_state != CONN_FREE) {
+            return;
+        }
+    }
+    Evt *evt = new Evt(ALL_CLOSED, GetHsm().GetHsmn());
+    PostSync(evt);
+}
+
+// Returns the index of the connection using socket id of the Wifi module, or CONN_NONE if not found.
+uint32_t WifiSt::FindConn(uint32_t id) const {
+    for (uint32_t i = 0; i < WIFI_CONN_COUNT; i++) {
+        Conn const &conn = m_conn[i];
+        if ((conn.m_state != CONN_FREE) && conn.m_idValid && (conn.m_id == id)) {
+            return i;
+        }
+    }
+    return CONN_NONE;
+}
+
+// Frees all connections without notification, e.g. when the state of the Wifi module is unknown.
+void WifiSt::ResetConn() {
+    for (uint32_t i = 0; i < WIFI_CONN_COUNT; i++) {
+        Conn &conn = m_conn[i];
+        conn.m_state = CONN_FREE;
+        conn.m_idValid = false;
+        conn.m_txLen = 0;
+        conn.m_txDue = false;
+    }
+    m_txNext = 0;
+}
+
+// Queues a message in the transmit aggregator of an open connection. It flushes the queued messages of the
+// connection first if there is no space. Returns false if the message is dropped because the command tracker
+// is full.
+bool WifiSt::QueueTx(uint32_t idx, char const *data, uint32_t len) {
+    FW_ASSERT(idx < WIFI_CONN_COUNT);
+    Conn &conn = m_conn[idx];
+    FW_ASSERT(data && (len <= sizeof(conn.m_txBuf)) && (conn.m_state == CONN_OPEN));
+    if (((conn.m_txLen + len) > sizeof(conn.m_txBuf)) && !FlushTx(idx)) {
+        return false;
+    }
+    // The window is shared by all connections. It starts with the first message queued on any of them.
+    bool idle = true;
+    for (uint32_t i = 0; i < WIFI_CONN_COUNT; i++) {
+        if (m_conn[i].m_txLen) {
+            idle = false;
+            break;
+        }
+    }
+    if (idle) {
+        m_txTimer.Restart(TX_WINDOW_MS);
+    }
+    memcpy(&conn.m_txBuf[conn.m_txLen], data, len);
+    conn.m_txLen += len;
+    m_cmdStat.m_msg++;
+    if (conn.m_txLen == sizeof(conn.m_txBuf)) {
+        conn.m_txDue = true;
+        DrainTx();
+    }
+    return true;
+}
+
+// Sends all queued messages of a connection in a single socket write. Returns false if the command tracker
+// is full, in which case the messages remain queued.
+bool WifiSt::FlushTx(uint32_t idx) {
+    FW_ASSERT(idx < WIFI_CONN_COUNT);
+    Conn &conn = m_conn[idx];
+    if (conn.m_txLen == 0) {
+        conn.m_txDue = false;
+        return true;
+    }
+    FW_ASSERT((conn.m_state == CONN_OPEN) && conn.m_idValid);
+    char buf[CMD_LEN];
+    uint32_t len = snprintf(buf, sizeof(buf) - sizeof(conn.m_txBuf), "at+s.sockw=%lu,%lu\n\r", conn.m_id,
+                            conn.m_txLen);
+    FW_ASSERT(len < (sizeof(buf) - sizeof(conn.m_txBuf)));
+    memcpy(&buf[len], conn.m_txBuf, conn.m_txLen);
+    len += conn.m_txLen;
+    if (!QueueCmd(HSM_UNDEF, 0, buf, len, idx, false)) {
+        return false;
+    }
+    m_cmdStat.m_msgWrite++;
+    conn.m_txLen = 0;
+    conn.m_txDue = false;
+    return true;
+}
+
+// Sends the due queues of all connections in round-robin order. The first connection served advances on
+// each call, and a connection that cannot be served because the command tracker is full is served first on
+// the next call. So a busy connection cannot starve others. Returns false if any due queue remains.
+bool WifiSt::DrainTx() {
+    for (uint32_t i = 0; i < WIFI_CONN_COUNT; i++) {
+        uint32_t idx = (m_txNext + i) % WIFI_CONN_COUNT;
+        if (m_conn[idx].m_txDue && !FlushTx(idx)) {
+            m_txNext = idx;
+            return false;
+        }
+    }
+    m_txNext = (m_txNext + 1) % WIFI_CONN_COUNT;
+    return true;
+}
+
+// Queues a command in the command tracker and sends it if the window allows. from and seq identify the
+// requester to which WifiSendCfm is sent when the command completes. from is HSM_UNDEF if not needed.
+// conn is the connection the command applies to, or CONN_NONE. resend is true if the command is idempotent
+// and may be resent on timeout. Socket open and write are not, since the module may have executed them and
+// only the response was lost. Returns false if the tracker is full.
+bool WifiSt::QueueCmd(Hsmn from, Sequence seq, char const *data, uint32_t len, uint32_t conn, bool resend) {
+    FW_ASSERT(data && (len <= CMD_LEN));
+    if (m_cmdCount == CMD_COUNT) {
+        return false;
+    }
+    Cmd &cmd = m_cmd[(m_cmdHead + m_cmdCount) % CMD_COUNT];
+    memcpy(cmd.m_data, data, len);
+    cmd.m_len = len;
+    cmd.m_from = from;
+    cmd.m_seq = seq;
+    cmd.m_retry = 0;
+    cmd.m_conn = conn;
+    cmd.m_resend = resend;
+    m_cmdCount++;
+    SendCmd();
+    return true;
+}
+
+// Sends queued commands in order while the number of outstanding commands is below the window.
+// The command and its data are written to the output FIFO together, so that the Wifi module never waits for
+// data that have been dropped. If the FIFO is full, the remaining commands are sent upon the next response
+// or timeout.
+void WifiSt::SendCmd() {
+    uint32_t sentBefore = m_cmdSent;
+    while ((m_cmdSent < m_cmdCount) && (m_cmdSent < CMD_WINDOW)) {
+        Cmd &cmd = m_cmd[(m_cmdHead + m_cmdSent) % CMD_COUNT];
+        bool status = false;
+        if (m_outFifo.Write(reinterpret_cast<uint8_t const *>(cmd.m_data), cmd.m_len, &status) == 0) {
+            break;
+        }
+        if (status) {
+            Evt *evt = new Evt(UART_OUT_WRITE_REQ, m_outIfHsmn);
+            Fw::Post(evt);
+        }
+        cmd.m_sendTime = GetSystemMs();
+        m_cmdStat.m_sent++;
+        m_cmdSent++;
+    }
+    // The timer guards the oldest command. If it could not be sent, the timer triggers another attempt.
+    if (m_cmdCount && (sentBefore == 0)) {
+        m_cmdTimer.Restart(CMD_TIMEOUT_MS);
+    }
+}
+
+// Removes the command at pos (0 for the oldest), updates statistics and sends WifiSendCfm to the requester
+// if needed. For a socket open command, it sends WifiConnectCfm and updates the connection.
+void WifiSt::PopCmd(Error error, Reason reason, uint32_t pos) {
+    FW_ASSERT(pos < m_cmdCount);
+    Cmd &cmd = m_cmd[(m_cmdHead + pos) % CMD_COUNT];
+    if (error == ERROR_SUCCESS) {
+        uint32_t rtt = GetSystemMs() - cmd.m_sendTime;
+        m_cmdStat.m_ok++;
+        m_cmdStat.m_rttTotal += rtt;
+        m_cmdStat.m_rttMin = LESS(m_cmdStat.m_rttMin, rtt);
+        m_cmdStat.m_rttMax = GREATER(m_cmdStat.m_rttMax, rtt);
+    } else if (error == ERROR_TIMEOUT) {
+        m_cmdStat.m_timeout++;
+    } else {
+        m_cmdStat.m_error++;
+    }
+    if (cmd.m_from != HSM_UNDEF) {
+        Evt *evt = new WifiSendCfm(cmd.m_from, GetHsm().GetHsmn(), cmd.m_seq, error, GetHsm().GetHsmn(), reason);
+        Fw::Post(evt);
+    }
+    // The only command of an opening connection is its socket open.
+    if ((cmd.m_conn != CONN_NONE) && (m_conn[cmd.m_conn].m_state == CONN_OPENING)) {
+        Conn &conn = m_conn[cmd.m_conn];
+        if ((error == ERROR_SUCCESS) && !conn.m_idValid) {
+            error = ERROR_HARDWARE;
+        }
+        Evt *evt = new WifiConnectCfm(conn.m_from, GetHsm().GetHsmn(), conn.m_seq, error, GetHsm().GetHsmn(), reason);
         Fw::Post(evt);
+        if (error == ERROR_SUCCESS) {
+            conn.m_state = CONN_OPEN;
+        } else {
+            CloseConn(cmd.m_conn);
+        }
+    }
+    if (pos == 0) {
+        m_cmdHead = (m_cmdHead + 1) % CMD_COUNT;
+    } else {
+        for (uint32_t i = pos + 1; i < m_cmdCount; i++) {
+            m_cmd[(m_cmdHead + i - 1) % CMD_COUNT] = m_cmd[(m_cmdHead + i) % CMD_COUNT];
+        }
+    }
+    m_cmdCount--;
+    // Requests deferred when the tracker was full.
+    GetHsm().Recall();
+}
+
+// Completes the oldest outstanding command upon its response (OK or ERROR). Since the Wifi module processes
+// commands in order, a response always belongs to the oldest outstanding command. Responses received when
+// no command is outstanding are ignored.
+void WifiSt::CompleteCmd(Error error, Reason reason) {
+    if (m_cmdSent == 0) {
+        return;
+    }
+    PopCmd(error, reason);
+    m_cmdSent--;
+    if (m_cmdCount) {
+        m_cmdTimer.Restart(CMD_TIMEOUT_MS);
+    } else {
+        m_cmdTimer.Stop();
+    }
+    SendCmd();
+    DrainTx();
+}
+
+// Handles timeout of the oldest command. Its response may have been lost, or the module may have dropped it
+// (e.g. UART buffer overflow), in which case later outstanding commands are lost too. Outstanding commands
+// that may be resent are resent in order, and the oldest one fails once it runs out of retries. Others (socket
+// open and write) fail right away, since resending them could open a second socket or duplicate data.
+void WifiSt::RetryCmd() {
+    if (m_cmdCount == 0) {
+        return;
+    }
+    uint32_t pos = 0;
+    for (uint32_t i = 0; i < m_cmdSent; i++) {
+        Cmd &cmd = m_cmd[(m_cmdHead + pos) % CMD_COUNT];
+        if (!cmd.m_resend || ((i == 0) && (cmd.m_retry >= CMD_MAX_RETRY))) {
+            PopCmd(ERROR_TIMEOUT, WIFI_REASON_NO_RSP, pos);
+            continue;
+        }
+        if (i == 0) {
+            cmd.m_retry++;
+            m_cmdStat.m_retry++;
+        }
+        pos++;
+    }
+    m_cmdSent = 0;
+    SendCmd();
+    DrainTx();
+}
+
+// Fails all queued commands, e.g. when leaving the state in which responses are handled.
+void WifiSt::ClearCmd(Error error) {
+    while (m_cmdCount) {
+        PopCmd(error, WIFI_REASON_UNSPEC);
+    }
+    m_cmdHead = 0;
+    m_cmdSent = 0;
+    m_cmdTimer.Stop();
+}
+
+// Returns the connection of the oldest outstanding command, to which a response being received belongs.
+// CONN_NONE if there is none.
+uint32_t WifiSt::GetRspConn() const {
+    if (m_cmdSent == 0) {
+        return CONN_NONE;
     }
+    return m_cmd[m_cmdHead].m_conn;
 }
 
 WifiSt::WifiSt() :
@@ -151,7 +447,10 @@ WifiSt::WifiSt() :
         m_ifHsmn(HSM_UNDEF), m_outIfHsmn(HSM_UNDEF), m_consoleOutIfHsmn(HSM_UNDEF),
         m_outFifo(m_outFifoStor, OUT_FIFO_ORDER),
         m_inFifo(m_inFifoStor, IN_FIFO_ORDER),
-        m_stateTimer(GetHsm().GetHsmn(), STATE_TIMER) {
+        m_stateTimer(GetHsm().GetHsmn(), STATE_TIMER),
+        m_txTimer(GetHsm().GetHsmn(), TX_TIMER), m_txNext(0),
+        m_cmdHead(0), m_cmdCount(0), m_cmdSent(0), m_cmdTimer(GetHsm().GetHsmn(), CMD_TIMER) {
+    ResetConn();
 }
 
 QState WifiSt::InitialPseudoState(WifiSt * const me, QEvt const * const e) {
@@ -185,6 +484,13 @@ QState WifiSt::Root(WifiSt * const me, QEvt const * const e) {
             me->GetHsm().SaveInSeq(req);
             return Q_TRAN(&WifiSt::Stopping);
         }
+        case WIFI_SEND_REQ: {
+            EVENT(e);
+            Evt const &req = EVT_CAST(*e);
+            Evt *evt = new WifiSendCfm(req.GetFrom(), GET_HSMN(), req.GetSeq(), ERROR_STATE, GET_HSMN());
+            Fw::Post(evt);
+            return Q_HANDLED();
+        }
     }
     return Q_SUPER(&QHsm::top);
 }
@@ -352,15 +658,58 @@ QState WifiSt::Normal(WifiSt * const me, QEvt const * const e) {
     switch (e->sig) {
         case Q_ENTRY_SIG: {
             EVENT(e);
+            me->m_atParser.Reset();
             return Q_HANDLED();
         }
         case Q_EXIT_SIG: {
             EVENT(e);
+            me->ClearCmd(ERROR_STATE);
+            me->ResetConn();
+            return Q_HANDLED();
+        }
+        case AT_OK: {
+            //EVENT(e);
+            me->CompleteCmd(ERROR_SUCCESS);
+            return Q_HANDLED();
+        }
+        case AT_ERROR: {
+            EVENT(e);
+            me->CompleteCmd(ERROR_HARDWARE, WIFI_REASON_AT_ERROR);
+            return Q_HANDLED();
+        }
+        case CMD_TIMER: {
+            EVENT(e);
+            me->RetryCmd();
             return Q_HANDLED();
         }
         case Q_INIT_SIG: {
             return Q_TRAN(&WifiSt::Disconnected);
         }
+        case UART_IN_DATA_IND: {
+            // Posts an event for each complete token. Tokenizer state is kept across reads, so a token may
+            // span multiple reads.
+            char buf[100];
+            while(uint32_t len = me->m_inFifo.Read(reinterpret_cast<uint8_t *>(buf), sizeof(buf)-1)) {
+                FW_ASSERT(len < sizeof(buf));
+                buf[len] = 0;
+                LOG("Received: %s", buf);
+                for (uint32_t i = 0; i < len; i++) {
+                    Evt *evt = NULL;
+                    switch (me->m_atParser.Parse(buf[i])) {
+                        case AtParser::TOKEN_WIND:    evt = new AtWind(GET_HSMN(), me->m_atParser); break;
+                        case AtParser::TOKEN_OK:      evt = new Evt(AT_OK, GET_HSMN(), GET_HSMN()); break;
+                        case AtParser::TOKEN_ERROR:   evt = new Evt(AT_ERROR, GET_HSMN(), GET_HSMN()); break;
+                        case AtParser::TOKEN_SOCK_ID: evt = new AtSockId(GET_HSMN(), me->m_atParser.GetSockId()); break;
+                        case AtParser::TOKEN_PAYLOAD: evt = new AtPayload(GET_HSMN(), me->m_atParser.GetPayload()); break;
+                        default: break;
+                    }
+                    if (evt) {
+                        Fw::Post(evt);
+                    }
+                }
+            }
+            return Q_HANDLED();
+        }
         case WIFI_INTERACTIVE_ON_REQ: {
             EVENT(e);
             WifiInteractiveOnReq const &req = static_cast<WifiInteractiveOnReq const &>(*e);
@@ -373,18 +722,22 @@ QState WifiSt::Normal(WifiSt * const me, QEvt const * const e) {
         case WIFI_CONNECT_REQ: {
             EVENT(e);
             WifiConnectReq const &req = static_cast<WifiConnectReq const &>(*e);
-            LOG("Connecting to %s:%d", req.GetDomain(), req.GetPort());
-            char cmd[100];
-            snprintf(cmd, sizeof(cmd), "at+s.sockon=%s,%d,,t\n\r", req.GetDomain(), req.GetPort());
-            me->Write(cmd);
+            LOG("Connecting conn %d to %s:%d", req.GetConn(), req.GetDomain(), req.GetPort());
+            Error error = me->OpenConn(req);
+            if (error != ERROR_SUCCESS) {
+                Evt *evt = new WifiConnectCfm(req.GetFrom(), GET_HSMN(), req.GetSeq(), error, GET_HSMN());
+                Fw::Post(evt);
+                return Q_HANDLED();
+            }
             return Q_TRAN(&WifiSt::Connected);
         }
         case WIFI_DISCONNECT_REQ: {
             EVENT(e);
-            char cmd[100];
-            snprintf(cmd, sizeof(cmd), "at+s.sockc=%d\n\r", 0);
-            me->Write(cmd);
-            return Q_TRAN(&WifiSt::Disconnected);
+            // No connection is open.
+            Evt const &req = EVT_CAST(*e);
+            Evt *evt = new WifiDisconnectCfm(req.GetFrom(), GET_HSMN(), req.GetSeq(), ERROR_SUCCESS);
+            Fw::Post(evt);
+            return Q_HANDLED();
         }
     }
     return Q_SUPER(&WifiSt::Started);
@@ -400,16 +753,13 @@ QState WifiSt::Disconnected(WifiSt * const me, QEvt const * const e) {
             EVENT(e);
             return Q_HANDLED();
         }
-        case UART_IN_DATA_IND: {
-            char buf[100];
-            while(uint32_t len = me->m_inFifo.Read(reinterpret_cast<uint8_t *>(buf), sizeof(buf)-1)) {
-                FW_ASSERT(len < sizeof(buf));
-                buf[len] = 0;
-                LOG("Received: %s", buf);
-                if (strstr(buf, "+WIND:24")) {
-                    Evt *evt = new MicrowaveWifiConnReq(MICROWAVE, GET_HSMN(), GEN_SEQ());
-                    Fw::Post(evt);
-                }
+        case AT_WIND: {
+            AtWind const &ind = static_cast<AtWind const &>(*e);
+            // WiFi up.
+            if (ind.GetCode() == 24) {
+                EVENT(e);
+                Evt *evt = new MicrowaveWifiConnReq(MICROWAVE, GET_HSMN(), GEN_SEQ());
+                Fw::Post(evt);
             }
             return Q_HANDLED();
         }
@@ -425,48 +775,164 @@ QState WifiSt::Connected(WifiSt * const me, QEvt const * const e) {
         }
         case Q_EXIT_SIG: {
             EVENT(e);
+            // Queued messages are discarded when their connections are freed.
+            me->m_txTimer.Stop();
+            // Deferred requests are answered by the state being entered.
+            me->GetHsm().Recall();
+            return Q_HANDLED();
+        }
+        case ALL_CLOSED: {
+            EVENT(e);
+            return Q_TRAN(&WifiSt::Disconnected);
+        }
+        case WIFI_CONNECT_REQ: {
+            EVENT(e);
+            WifiConnectReq const &req = static_cast<WifiConnectReq const &>(*e);
+            LOG("Connecting conn %d to %s:%d", req.GetConn(), req.GetDomain(), req.GetPort());
+            Error error = me->OpenConn(req);
+            if (error != ERROR_SUCCESS) {
+                Evt *evt = new WifiConnectCfm(req.GetFrom(), GET_HSMN(), req.GetSeq(), error, GET_HSMN());
+                Fw::Post(evt);
+            }
+            return Q_HANDLED();
+        }
+        case WIFI_DISCONNECT_REQ: {
+            EVENT(e);
+            WifiDisconnectReq const &req = static_cast<WifiDisconnectReq const &>(*e);
+            uint32_t idx = req.GetConn();
+            Error error = ERROR_SUCCESS;
+            if (idx >= WIFI_CONN_COUNT) {
+                error = ERROR_PARAM;
+            } else if (me->m_conn[idx].m_state == CONN_OPENING) {
+                // Retried when the socket open command completes.
+                if (!me->GetHsm().Defer(e)) {
+                    error = ERROR_UNAVAIL;
+                } else {
+                    return Q_HANDLED();
+                }
+            } else if (me->m_conn[idx].m_state == CONN_OPEN) {
+                if (!me->Write(idx, true, "at+s.sockc=%lu\n\r", me->m_conn[idx].m_id)) {
+                    // Retried when a command completes.
+                    if (!me->GetHsm().Defer(e)) {
+                        error = ERROR_UNAVAIL;
+                    } else {
+                        return Q_HANDLED();
+                    }
+                } else {
+                    me->CloseConn(idx);
+                }
+            }
+            Evt *evt = new WifiDisconnectCfm(req.GetFrom(), GET_HSMN(), req.GetSeq(), error, GET_HSMN());
+            Fw::Post(evt);
+            return Q_HANDLED();
+        }
+        case WIFI_SEND_MSG_REQ: {
+            //EVENT(e);
+            WifiSendMsgReq const &req = static_cast<WifiSendMsgReq const &>(*e);
+            uint32_t idx = req.GetConn();
+            if ((idx >= WIFI_CONN_COUNT) || (me->m_conn[idx].m_state != CONN_OPEN)) {
+                ERROR("Message dropped. Conn %d not open", idx);
+                m_cmdStat.m_msgDrop++;
+            } else if (!me->QueueTx(idx, req.GetData(), req.GetLen())) {
+                ERROR("Message dropped. Command queue full");
+                m_cmdStat.m_msgDrop++;
+            }
+            return Q_HANDLED();
+        }
+        case TX_TIMER: {
+            //EVENT(e);
+            for (uint32_t i = 0; i < WIFI_CONN_COUNT; i++) {
+                if (me->m_conn[i].m_txLen) {
+                    me->m_conn[i].m_txDue = true;
+                }
+            }
+            if (!me->DrainTx()) {
+                // Command queue full. Remaining queues are also drained when a command completes.
+                me->m_txTimer.Restart(TX_WINDOW_MS);
+            }
             return Q_HANDLED();
         }
         case WIFI_SEND_REQ: {
             EVENT(e);
             WifiSendReq const &req = static_cast<WifiSendReq const &>(*e);
-            char cmd[150];
+            uint32_t idx = req.GetConn();
             char const *data = req.GetData();
-            LOG("Send '%s'", data);
-            snprintf(cmd, sizeof(cmd), "at+s.sockw=0,%d\n\r%s", strlen(data), data);
-            me->Write(cmd);
+            LOG("Send '%s' on conn %d", data, idx);
+            if ((idx >= WIFI_CONN_COUNT) || (me->m_conn[idx].m_state == CONN_FREE)) {
+                Evt *evt = new WifiSendCfm(req.GetFrom(), GET_HSMN(), req.GetSeq(), ERROR_STATE, GET_HSMN());
+                Fw::Post(evt);
+                return Q_HANDLED();
+            }
+            Conn &conn = me->m_conn[idx];
+            bool queued = false;
+            if (conn.m_state == CONN_OPEN) {
+                // Keeps order with queued messages of the same connection.
+                char buf[CMD_LEN];
+                uint32_t len = snprintf(buf, sizeof(buf), "at+s.sockw=%lu,%d\n\r%s", conn.m_id, strlen(data), data);
+                len = LESS(len, sizeof(buf) - 1);
+                queued = me->FlushTx(idx) && me->QueueCmd(req.GetFrom(), req.GetSeq(), buf, len, idx, false);
+            }
+            // Retried when a command completes, including the socket open command of the connection.
+            if (!queued && !me->GetHsm().Defer(e)) {
+                Evt *evt = new WifiSendCfm(req.GetFrom(), GET_HSMN(), req.GetSeq(), ERROR_UNAVAIL, GET_HSMN(),
+                                           WIFI_REASON_QUEUE_FULL);
+                Fw::Post(evt);
+            }
             return Q_HANDLED();
         }
-        case UART_IN_DATA_IND: {
-            char buf[100];
-            while(uint32_t len = me->m_inFifo.Read(reinterpret_cast<uint8_t *>(buf), sizeof(buf)-1)) {
-                FW_ASSERT(len < sizeof(buf));
-                buf[len] = 0;
-                LOG("Received: %s", buf);
-                if (strstr(buf, "+WIND:55")) {
-                    char cmd[100];
-                    snprintf(cmd, sizeof(cmd), "at+s.sockr=0,\n\r");
-                    me->Write(cmd);
-                }
-                char * tmp = strstr(buf, "Mdev");
-                if(NULL != tmp) {
-                	using namespace MicrowaveMsgFormat;
-                	Message message {ByteSwapMessage(Message(tmp))};
-
-					Type type = static_cast<Type>(static_cast<uint32_t>(message.state) >> 24);
-					switch (type) {
-					case MicrowaveMsgFormat::Type::SIGNAL:
-						handleSignal(message, MICROWAVE, GET_HSMN(), GEN_SEQ());
-						break;
-					default:
-						//no states ever come from the app
-						//no updates ever come from the app
-						break;
-					}
+        case AT_SOCK_ID: {
+            EVENT(e);
+            AtSockId const &ind = static_cast<AtSockId const &>(*e);
+            // Response to the socket open command of the connection.
+            uint32_t idx = me->GetRspConn();
+            if ((idx != CONN_NONE) && (me->m_conn[idx].m_state == CONN_OPENING)) {
+                LOG("Conn %d socket id %d", idx, ind.GetId());
+                me->m_conn[idx].m_id = ind.GetId();
+                me->m_conn[idx].m_idValid = true;
+            }
+            return Q_HANDLED();
+        }
+        case AT_WIND: {
+            AtWind const &ind = static_cast<AtWind const &>(*e);
+            // Pending data or socket closed by peer. Routed by socket id, e.g. "+WIND:55:Pending Data:<id>:<len>".
+            uint32_t id;
+            if (((ind.GetCode() == 55) || (ind.GetCode() == 58)) && ind.GetField(2, id)) {
+                EVENT(e);
+                uint32_t idx = me->FindConn(id);
+                if (idx == CONN_NONE) {
+                    ERROR("Unknown socket id %d", id);
+                } else if (ind.GetCode() == 58) {
+                    LOG("Conn %d closed by peer", idx);
+                    me->CloseConn(idx);
+                } else if (me->m_conn[idx].m_state == CONN_OPEN) {
+                    if (!me->Write(idx, true, "at+s.sockr=%lu,\n\r", id)) {
+                        ERROR("Command queue full");
+                    }
                 }
             }
             return Q_HANDLED();
         }
+        case AT_PAYLOAD: {
+            EVENT(e);
+            AtPayload const &ind = static_cast<AtPayload const &>(*e);
+            // Payload is part of the response to the socket read command of the connection.
+            LOG("Payload on conn %d", me->GetRspConn());
+            using namespace MicrowaveMsgFormat;
+            static_assert(sizeof(Message) == AtParser::PAYLOAD_LEN, "AtParser::PAYLOAD_LEN mismatch");
+            Message message {ByteSwapMessage(Message(ind.GetData()))};
+
+            Type type = static_cast<Type>(static_cast<uint32_t>(message.state) >> 24);
+            switch (type) {
+            case MicrowaveMsgFormat::Type::SIGNAL:
+                handleSignal(message, MICROWAVE, GET_HSMN(), GEN_SEQ());
+                break;
+            default:
+                //no states ever come from the app
+                //no updates ever come from the app
+                break;
+            }
+            return Q_HANDLED();
+        }
     }
     return Q_SUPER(&WifiSt::Normal);
 }
@@ -39,12 +39,18 @@
 #ifndef WIFI_ST_H
 #define WIFI_ST_H
 
+#include <string.h>
 #include "qpcpp.h"
 #include "fw_active.h"
 #include "fw_timer.h"
 #include "fw_evt.h"
+#include "fw_pipe.h"
+#include "fw_spscpipe.h"
+#include "fw_macro.h"
 #include "app_hsmn.h"
 #include "Wifi.h"
+#include "WifiInterface.h"
+#include "AtParser.h"
 
 using namespace QP;
 using namespace FW;
@@ -53,8 +59,39 @@ namespace APP {
 
 class WifiSt : public Wifi {
 public:
+    // Log is turned off in main(). Only ERROR, WARNING and CRITICAL are compiled.
+    enum {
+        LOG_CEILING = Log::TYPE_LOG
+    };
+
     WifiSt();
 
+    // AT command statistics. Round-trip time is measured from sending a command to receiving its OK.
+    class CmdStat {
+    public:
+        CmdStat() { Reset(); }
+        void Reset() {
+            m_sent = m_ok = m_error = m_retry = m_timeout = 0;
+            m_rttMin = 0xFFFFFFFF;
+            m_rttMax = 0;
+            m_rttTotal = 0;
+            m_msg = m_msgWrite = m_msgDrop = 0;
+        }
+        uint32_t m_sent;        // Including resent ones.
+        uint32_t m_ok;
+        uint32_t m_error;
+        uint32_t m_retry;
+        uint32_t m_timeout;
+        uint32_t m_rttMin;
+        uint32_t m_rttMax;
+        uint64_t m_rttTotal;    // Divided by m_ok gives average.
+        uint32_t m_msg;         // Messages queued in the transmit aggregator.
+        uint32_t m_msgWrite;    // Socket writes carrying them.
+        uint32_t m_msgDrop;
+    };
+    static CmdStat const &GetCmdStat() { return m_cmdStat; }
+    static void ResetCmdStat() { m_cmdStat.Reset(); }
+
 protected:
     static QState InitialPseudoState(WifiSt * const me, QEvt const * const e);
     static QState Root(WifiSt * const me, QEvt const * const e);
@@ -67,7 +104,65 @@ protected:
                 static QState Connected(WifiSt * const me, QEvt const * const e);
             static QState Interactive(WifiSt * const me, QEvt const * const e);
 
-    void Write(char *const atCmd);
+    bool Write(uint32_t conn, bool resend, char const *format, ...);
+    Error OpenConn(WifiConnectReq const &req);
+    void CloseConn(uint32_t conn);
+    uint32_t FindConn(uint32_t id) const;
+    void ResetConn();
+    bool QueueTx(uint32_t conn, char const *data, uint32_t len);
+    bool FlushTx(uint32_t conn);
+    bool DrainTx();
+    bool QueueCmd(Hsmn from, Sequence seq, char const *data, uint32_t len, uint32_t conn, bool resend);
+    void SendCmd();
+    void PopCmd(Error error, Reason reason, uint32_t pos = 0);
+    void CompleteCmd(Error error, Reason reason = WIFI_REASON_UNSPEC);
+    void RetryCmd();
+    void ClearCmd(Error error);
+    uint32_t GetRspConn() const;
+
+    class AtWind : public Evt {
+    public:
+        AtWind(Hsmn hsmn, AtParser const &parser) :
+            Evt(AT_WIND, hsmn, hsmn), m_fieldValid(0) {
+            for (uint32_t i = 0; i < AtParser::FIELD_COUNT; i++) {
+                if (parser.GetField(i, m_field[i])) {
+                    m_fieldValid |= BIT_MASK_AT(i);
+                }
+            }
+        }
+        uint32_t GetCode() const { return m_field[0]; }
+        // Returns false if the field is not numeric.
+        bool GetField(uint32_t idx, uint32_t &value) const {
+            if ((idx >= AtParser::FIELD_COUNT) || !(m_fieldValid & BIT_MASK_AT(idx))) {
+                return false;
+            }
+            value = m_field[idx];
+            return true;
+        }
+    private:
+        uint32_t m_field[AtParser::FIELD_COUNT];
+        uint8_t m_fieldValid;
+    };
+
+    class AtSockId : public Evt {
+    public:
+        AtSockId(Hsmn hsmn, uint32_t id) :
+            Evt(AT_SOCK_ID, hsmn, hsmn), m_id(id) {}
+        uint32_t GetId() const { return m_id; }
+    private:
+        uint32_t m_id;
+    };
+
+    class AtPayload : public Evt {
+    public:
+        AtPayload(Hsmn hsmn, char const *data) :
+            Evt(AT_PAYLOAD, hsmn, hsmn) {
+            memcpy(m_data, data, sizeof(m_data));
+        }
+        char const *GetData() const { return m_data; }
+    private:
+        char m_data[AtParser::PAYLOAD_LEN];
+    };
 
     Hsmn m_ifHsmn;          // HSMN of the interface active object.
     Hsmn m_outIfHsmn;       // HSMN of the output interface region.
@@ -81,9 +176,69 @@ protected:
     uint8_t m_outFifoStor[1 << OUT_FIFO_ORDER];
     uint8_t m_inFifoStor[1 << IN_FIFO_ORDER];
     Fifo m_outFifo;
-    Fifo m_inFifo;
+    SpscFifo m_inFifo;
+    AtParser m_atParser;
 
     Timer m_stateTimer;
+
+    // Transmit aggregator. Messages queued within TX_WINDOW_MS of the first one are sent in a single
+    // socket write, unless TX_MTU is reached earlier. Each connection has its own queue. Due queues are
+    // drained in round-robin order as the command tracker has space. See DrainTx().
+    enum {
+        TX_WINDOW_MS = 20,
+        TX_MTU = 120,
+    };
+    Timer m_txTimer;
+    uint32_t m_txNext;          // Connection to be drained first.
+
+    // Connection table indexed by the connection index of requests.
+    enum {
+        CONN_NONE = 0xFF,
+    };
+    enum ConnState {
+        CONN_FREE,
+        CONN_OPENING,           // Socket open command pending.
+        CONN_OPEN,
+    };
+    class Conn {
+    public:
+        ConnState m_state;
+        uint32_t m_id;          // Socket id assigned by the Wifi module.
+        bool m_idValid;
+        Hsmn m_from;            // Requester to send WifiConnectCfm to.
+        Sequence m_seq;
+        char m_txBuf[TX_MTU];
+        uint32_t m_txLen;
+        bool m_txDue;           // Queued messages to be sent as soon as the command tracker has space.
+    };
+    Conn m_conn[WIFI_CONN_COUNT];
+
+    // AT command tracker. Commands are sent in order with at most CMD_WINDOW of them outstanding (i.e. sent
+    // without response). Others wait in the queue of CMD_COUNT entries. See SendCmd().
+    enum {
+        CMD_COUNT = 4,
+        CMD_WINDOW = 2,
+        CMD_LEN = TX_MTU + 32,
+        CMD_TIMEOUT_MS = 1000,
+        CMD_MAX_RETRY = 2,
+    };
+    class Cmd {
+    public:
+        char m_data[CMD_LEN];
+        uint32_t m_len;
+        uint32_t m_sendTime;
+        Hsmn m_from;            // Requester to send WifiSendCfm to. HSM_UNDEF if none.
+        Sequence m_seq;
+        uint8_t m_retry;
+        uint8_t m_conn;         // Connection the command applies to. CONN_NONE if none.
+        bool m_resend;          // True if the command may be resent on timeout.
+    };
+    Cmd m_cmd[CMD_COUNT];
+    uint32_t m_cmdHead;         // Index of the oldest command.
+    uint32_t m_cmdCount;        // Number of queued commands including outstanding ones.
+    uint32_t m_cmdSent;         // Number of outstanding commands, starting from the oldest.
+    Timer m_cmdTimer;
+    static CmdStat m_cmdStat;
 };
 
 } // namespace APP
@@ -43,6 +43,7 @@
 #include "ConsoleInterface.h"
 #include "UartInInterface.h"
 #include "WifiInterface.h"
+#include "WifiSt.h"
 #include "WifiStCmd.h"
 
 FW_DEFINE_THIS_FILE("WifiStCmd.cpp")
@@ -65,19 +66,28 @@ static CmdStatus Conn(Console &console, Evt const *e) {
         case Console::CONSOLE_CMD: {
             Console::ConsoleCmd const &ind = static_cast<Console::ConsoleCmd const &>(*e);
             if (ind.Argc() < 3) {
-                console.PutStr("wifi conn <host> <port>\n\r");
+                console.PutStr("wifi conn <host> <port> [conn]\n\r");
                 return CMD_DONE;
             }
             char const *host = ind.Argv(1);
             uint16_t port = STRING_TO_NUM(ind.Argv(2), 0);
-            Evt *evt = new WifiConnectReq(WIFI_ST, hsm.GetHsmn(), hsm.GenSeq(), host, port);
+            uint8_t conn = (ind.Argc() >= 4) ? STRING_TO_NUM(ind.Argv(3), 0) : 0;
+            Evt *evt = new WifiConnectReq(WIFI_ST, hsm.GetHsmn(), hsm.GenSeq(), host, port, conn);
             Fw::Post(evt);
+            console.GetTimer().Start(WifiConnectReq::TIMEOUT_MS);
             break;
         }
-        // @todo - Wait for cfm.
+        case WIFI_CONNECT_CFM: {
+            ErrorEvt const &cfm = ERROR_EVT_CAST(*e);
+            console.PrintErrorEvt(&cfm);
+            return CMD_DONE;
+        }
+        case Console::CONSOLE_TIMER: {
+            console.PutStr("Timeout\n\r");
+            return CMD_DONE;
+        }
     }
-    //return CMD_CONTINUE;
-    return CMD_DONE;
+    return CMD_CONTINUE;
 }
 
 static CmdStatus Disc(Console &console, Evt const *e) {
@@ -85,7 +95,8 @@ static CmdStatus Disc(Console &console, Evt const *e) {
     switch (e->sig) {
         case Console::CONSOLE_CMD: {
             Console::ConsoleCmd const &ind = static_cast<Console::ConsoleCmd const &>(*e);
-            Evt *evt = new WifiDisconnectReq(WIFI_ST, hsm.GetHsmn(), hsm.GenSeq());
+            uint8_t conn = (ind.Argc() >= 2) ? STRING_TO_NUM(ind.Argv(1), 0) : 0;
+            Evt *evt = new WifiDisconnectReq(WIFI_ST, hsm.GetHsmn(), hsm.GenSeq(), conn);
             Fw::Post(evt);
             break;
         }
@@ -101,17 +112,130 @@ static CmdStatus Send(Console &console, Evt const *e) {
         case Console::CONSOLE_CMD: {
             Console::ConsoleCmd const &ind = static_cast<Console::ConsoleCmd const &>(*e);
             if (ind.Argc() < 2) {
-                console.PutStr("wifi send <text>\n\r");
+                console.PutStr("wifi send <text> [conn]\n\r");
                 return CMD_DONE;
             }
             char const *text = ind.Argv(1);
-            Evt *evt = new WifiSendReq(WIFI_ST, hsm.GetHsmn(), hsm.GenSeq(), text);
+            uint8_t conn = (ind.Argc() >= 3) ? STRING_TO_NUM(ind.Argv(2), 0) : 0;
+            Evt *evt = new WifiSendReq(WIFI_ST, hsm.GetHsmn(), hsm.GenSeq(), text, conn);
             Fw::Post(evt);
+            console.GetTimer().Start(WifiSendReq::TIMEOUT_MS);
+            break;
+        }
+        case WIFI_SEND_CFM: {
+            ErrorEvt const &cfm = ERROR_EVT_CAST(*e);
+            console.PrintErrorEvt(&cfm);
+            return CMD_DONE;
+        }
+        case Console::CONSOLE_TIMER: {
+            console.PutStr("Timeout\n\r");
+            return CMD_DONE;
+        }
+    }
+    return CMD_CONTINUE;
+}
+
+// Throughput test. "wifi load <conns> <count> [len]" sends count writes of len bytes, round-robin over
+// connections 0 to conns-1, which must have been opened with "wifi conn". Up to LOAD_WINDOW requests are
+// outstanding, so that WifiSendReq does not use up the large event pool.
+static void LoadSend(Console &console, uint32_t conns, uint32_t len, uint32_t index) {
+    Hsm &hsm = console.GetHsm();
+    char data[WifiSendReq::MAX_LEN + 1];
+    memset(data, 'a' + (index % 26), len);
+    data[len] = 0;
+    Evt *evt = new WifiSendReq(WIFI_ST, hsm.GetHsmn(), hsm.GenSeq(), data, index % conns);
+    Fw::Post(evt);
+}
+
+static CmdStatus Load(Console &console, Evt const *e) {
+    enum {
+        LOAD_WINDOW = 2,
+        DEFAULT_LEN = 100,
+    };
+    enum {
+        VAR_CONNS,
+        VAR_COUNT,
+        VAR_LEN,
+        VAR_SENT,
+        VAR_DONE,
+        VAR_OK,
+        VAR_START_MS,
+    };
+    uint32_t &conns = console.Var(VAR_CONNS);
+    uint32_t &count = console.Var(VAR_COUNT);
+    uint32_t &len = console.Var(VAR_LEN);
+    uint32_t &sent = console.Var(VAR_SENT);
+    uint32_t &done = console.Var(VAR_DONE);
+    uint32_t &ok = console.Var(VAR_OK);
+    uint32_t &startMs = console.Var(VAR_START_MS);
+    switch (e->sig) {
+        case Console::CONSOLE_CMD: {
+            Console::ConsoleCmd const &ind = static_cast<Console::ConsoleCmd const &>(*e);
+            if (ind.Argc() >= 3) {
+                conns = STRING_TO_NUM(ind.Argv(1), 0);
+                count = STRING_TO_NUM(ind.Argv(2), 0);
+                len = (ind.Argc() >= 4) ? STRING_TO_NUM(ind.Argv(3), 0) : static_cast<uint32_t>(DEFAULT_LEN);
+            }
+            if ((conns == 0) || (conns > WIFI_CONN_COUNT) || (count == 0) || (len == 0) ||
+                (len > WifiSendReq::MAX_LEN)) {
+                console.Print("wifi load <conns (1-%d)> <count> [len (1-%d)]\n\r", WIFI_CONN_COUNT,
+                              WifiSendReq::MAX_LEN);
+                return CMD_DONE;
+            }
+            startMs = GetSystemMs();
+            while ((sent < count) && (sent < LOAD_WINDOW)) {
+                LoadSend(console, conns, len, sent++);
+            }
+            console.GetTimer().Start(WifiSendReq::TIMEOUT_MS);
+            break;
+        }
+        case WIFI_SEND_CFM: {
+            ErrorEvt const &cfm = ERROR_EVT_CAST(*e);
+            done++;
+            if (cfm.GetError() == ERROR_SUCCESS) {
+                ok++;
+            }
+            if (done < count) {
+                if (sent < count) {
+                    LoadSend(console, conns, len, sent++);
+                }
+                console.GetTimer().Restart(WifiSendReq::TIMEOUT_MS);
+                break;
+            }
+            uint32_t ms = GetSystemMs() - startMs;
+            console.Print("%lu of %lu writes ok on %lu conn, %lu bytes in %lu ms (%lu B/s)\n\r", ok, count, conns,
+                          ok * len, ms, ms ? (ok * len * 1000 / ms) : 0);
+            return CMD_DONE;
+        }
+        case Console::CONSOLE_TIMER: {
+            console.Print("Timeout after %lu of %lu writes\n\r", done, count);
+            return CMD_DONE;
+        }
+    }
+    return CMD_CONTINUE;
+}
+
+static CmdStatus Stat(Console &console, Evt const *e) {
+    switch (e->sig) {
+        case Console::CONSOLE_CMD: {
+            Console::ConsoleCmd const &ind = static_cast<Console::ConsoleCmd const &>(*e);
+            if ((ind.Argc() > 1) && STRING_EQUAL(ind.Argv(1), "reset")) {
+                WifiSt::ResetCmdStat();
+                console.Print("AT command statistics reset\n\r");
+                break;
+            }
+            WifiSt::CmdStat const &stat = WifiSt::GetCmdStat();
+            console.Print("AT commands sent=%lu ok=%lu error=%lu retry=%lu timeout=%lu\n\r",
+                          stat.m_sent, stat.m_ok, stat.m_error, stat.m_retry, stat.m_timeout);
+            if (stat.m_ok) {
+                console.Print("RTT (ms) min=%lu avg=%lu max=%lu\n\r", stat.m_rttMin,
+                              static_cast<uint32_t>(stat.m_rttTotal / stat.m_ok), stat.m_rttMax);
+            }
+            console.Print("Messages queued=%lu writes=%lu dropped=%lu\n\r", stat.m_msg, stat.m_msgWrite,
+                          stat.m_msgDrop);
             break;
         }
-        // @todo - Wait for cfm.
     }
-    //return CMD_CONTINUE;
     return CMD_DONE;
 }
 
@@ -170,14 +294,17 @@ static CmdStatus Interact(Console &console, Evt const *e) {
 }
 
 static CmdStatus List(Console &console, Evt const *e);
-static CmdHandler const cmdHandler[] = {
-    { "test",       Test,       "Test function", 0 },
+static constexpr CmdHandler cmdHandler[] = {
+    { "?",          List,       "List commands", 0 },
     { "conn",       Conn,       "Connect to host", 0 },
     { "disc",       Disc,       "Disconnect", 0 },
-    { "send",       Send,       "Send", 0 },
     { "interact",   Interact,   "Interactive mode", 0 },
-    { "?",          List,       "List commands", 0 },
+    { "load",       Load,       "Throughput test", 0 },
+    { "send",       Send,       "Send", 0 },
+    { "stat",       Stat,       "AT command statistics", 0 },
+    { "test",       Test,       "Test function", 0 },
 };
+CMD_TABLE_ASSERT(cmdHandler);
 
 static CmdStatus List(Console &console, Evt const *e) {
     return console.ListCmd(e, cmdHandler, ARRAY_COUNT(cmdHandler));
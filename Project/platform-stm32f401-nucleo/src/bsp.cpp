@@ -39,6 +39,7 @@
 #include <string.h>
 #include "qpcpp.h"
 #include "bsp.h"
+#include "fw_log.h"
 
 Q_DEFINE_THIS_FILE
 
@@ -47,6 +48,9 @@ Q_DEFINE_THIS_FILE
 // boot up process but allows all debug message to be seen since boot up.
 //#define ENABLE_BSP_PRINT
 
+// Without tickless idle, it counts the iterations of the idle loop.
+// With tickless idle, it counts the idle time in microseconds.
+// In both cases System calibrates it against an idle period for CPU utilization.
 static volatile uint32_t idleCnt = 0;
 
 static UART_HandleTypeDef usart;
@@ -121,9 +125,15 @@ HAL_StatusTypeDef HAL_InitTick(uint32_t TickPriority) {
     (void)TickPriority;
     SysTick_Config(SystemCoreClock / BSP_TICKS_PER_SEC);
     NVIC_SetPriority(SysTick_IRQn, SYSTICK_PRIO);
+#if ENABLE_TICKLESS_IDLE
+    // DWT cycle counter keeps the tick boundaries for tickless sleep. See BspTicklessSleep().
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
     return HAL_OK;
 }
 
+
 // namespace QP **************************************************************
 namespace QP {
 
@@ -150,6 +160,15 @@ void QF::onCleanup(void) {
 }
 //............................................................................
 void QXK::onIdle(void) {
+    // Deferred binary log records are written before idling. See Log::FlushBin().
+    if (FW::Log::FlushBin()) {
+        return;
+    }
+#if ENABLE_TICKLESS_IDLE
+    QF_INT_DISABLE();
+    idleCnt += BspTicklessSleep() / (SystemCoreClock / 1000000);
+    QF_INT_ENABLE();
+#else
     // toggle the User LED on and then off (not enough LEDs, see NOTE01)
     QF_INT_DISABLE();
     //GPIOA->BSRR |= (LED_LD2);        // turn LED[n] on
@@ -174,6 +193,7 @@ void QXK::onIdle(void) {
     //
     //__WFI();   Wait-For-Interrupt
 #endif
+#endif // ENABLE_TICKLESS_IDLE
 }
 
 //............................................................................
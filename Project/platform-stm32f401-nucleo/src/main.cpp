@@ -158,6 +158,8 @@ int main(void)
     // Configure log settings.
     Log::SetVerbosity(4);
     Log::OnAll();
+    // EVENT, LOG and INFO are also compiled out of the following HSM's by their LOG_CEILING.
+    // Update them together.
     Log::Off(UART2_IN);
     Log::Off(UART1_IN);
     Log::Off(UART2_OUT);
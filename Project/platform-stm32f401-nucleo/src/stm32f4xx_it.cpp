@@ -75,6 +75,7 @@
 #include "UartAct.h"
 #include "GpioIn.h"
 #include "fw_log.h"
+#include "fw_timer.h"
 
 /* USER CODE BEGIN 0 */
 
@@ -102,6 +103,7 @@ extern "C" void SysTick_Handler(void){
   /* USER CODE BEGIN SysTick_IRQn 1 */
   QXK_ISR_ENTRY();
   QP::QF::tickX_(0);
+  FW::Timer::Tick();
   QXK_ISR_EXIT();
   /* USER CODE END SysTick_IRQn 1 */
 }
@@ -116,12 +118,22 @@ extern "C" void SysTick_Handler(void){
 /* USER CODE BEGIN 1 */
 
 // Common handler for UART interrupts.
-// It handles RX error and RXNE interrupts. It does NOT handle TX interrupts.
+// It handles RX error, RXNE and IDLE interrupts. It does NOT handle TX interrupts.
 // It does NOT pass control to HAL handler.
 void HandleUartIrq(Hsmn hsmn) {
     UartIn::HwError error = UartIn::HW_ERROR_NONE;
     UART_HandleTypeDef *hal = UartAct::GetHal(hsmn);
     volatile uint32_t isrflags   = READ_REG(hal->Instance->SR);
+    uint32_t cr1 = READ_REG(hal->Instance->CR1);
+    if ((isrflags & USART_SR_IDLE) && (cr1 & USART_CR1_IDLEIE)) {
+        // Sender has paused. Read DR following SR to clear flag. Received data have been moved by DMA already.
+        __HAL_UART_CLEAR_IDLEFLAG(hal);
+        UartIn::IdleCallback(UartAct::GetUartInHsmn(hsmn));
+        // Done unless other interrupts are pending.
+        if (!(isrflags & (USART_SR_NE | USART_SR_FE | USART_SR_ORE)) && !(cr1 & USART_CR1_RXNEIE)) {
+            return;
+        }
+    }
     if (isrflags & USART_SR_NE) {
         // START bit Noise detection flag. Must clear it or it will cause ISR to be re-entered.
         __HAL_UART_CLEAR_NEFLAG(hal);
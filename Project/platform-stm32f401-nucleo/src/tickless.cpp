@@ -0,0 +1,180 @@
+/*******************************************************************************
+ * Copyright (C) Gallium Studio LLC. All rights reserved.
+ *
+ * This program is open source software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Alternatively, this program may be distributed and modified under the
+ * terms of Gallium Studio LLC commercial licenses, which expressly supersede
+ * the GNU General Public License and are specifically designed for licensees
+ * interested in retaining the proprietary status of their code.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * Contact information:
+ * Website - https://www.galliumstudio.com
+ * Source repository - https://github.com/galliumstudio
+ * Email - admin@galliumstudio.com
+ ******************************************************************************/
+
+#include "qpcpp.h"
+#include "bsp.h"
+#include "fw_timer.h"
+
+// See ENABLE_TICKLESS_IDLE in bsp.h.
+#if ENABLE_TICKLESS_IDLE
+
+#if !FW_TIMER_WHEEL
+#error "ENABLE_TICKLESS_IDLE requires FW_TIMER_WHEEL to be set to 1"
+#endif
+
+extern __IO uint32_t uwTick;    // Defined in stm32f4xx_hal.c.
+
+enum {
+    SYSTICK_MAX_LOAD = SysTick_LOAD_RELOAD_Msk,     // SysTick is a 24-bit down counter.
+    // Cycles from reading CYCCNT to SysTick counting again in RestartSysTick(). If it is less than the actual
+    // number, the tick ends that many cycles late but never early.
+    RESTART_CYCLES = 4,
+    // Minimum cycles to the boundary for RestartSysTick(), so that the reload for the remainder of the tick
+    // happens after LOAD is set back for normal ticks.
+    RESTART_MIN_CYCLES = 32,
+};
+
+// Tick boundaries are kept as absolute times in DWT CYCCNT, rather than relative to SysTick when it is
+// stopped, so that the cycles SysTick is stopped for do not accumulate as drift. The boundary at which
+// uwTick is to reach n is anchorCycle + (n - anchorTick) * cyclesPerTick (modulo 2^32).
+// Anchored on the first tickless sleep.
+static bool anchored = false;
+static uint32_t anchorTick;
+static uint32_t anchorCycle;
+
+static uint32_t GetBoundary(uint32_t tick, uint32_t cyclesPerTick) {
+    return anchorCycle + (tick - anchorTick) * cyclesPerTick;
+}
+
+// SysTick must have been stopped. Restarts it to reach 0 at the boundary and then to run normal ticks.
+// Returns false if the boundary is too close or has passed.
+static bool RestartSysTick(uint32_t ctrl, uint32_t boundary, uint32_t cyclesPerTick) {
+    uint32_t cycles = boundary - DWT->CYCCNT - RESTART_CYCLES;
+    if (static_cast<int32_t>(cycles) < RESTART_MIN_CYCLES) {
+        return false;
+    }
+    SysTick->LOAD = cycles - 1;
+    SysTick->VAL = 0;
+    SysTick->CTRL = ctrl | SysTick_CTRL_ENABLE_Msk;
+    SysTick->LOAD = cyclesPerTick - 1;
+    return true;
+}
+
+// SysTick must have been stopped at time now. Restarts it at the next boundary not passed. If one or more
+// boundaries have passed, the SysTick interrupt is pended for the last one and the number of the others
+// (to be skipped) is returned. A boundary within RESTART_MIN_CYCLES is waited for and counted as passed.
+static uint32_t ResumeSysTick(uint32_t ctrl, uint32_t now, uint32_t cyclesPerTick) {
+    uint32_t tick = uwTick;
+    int32_t since = now - GetBoundary(tick + 1, cyclesPerTick);
+    uint32_t passed = (since >= 0) ? (since / cyclesPerTick + 1) : 0;
+    // SysTick may have reached 0 a few cycles before the boundary. See RESTART_CYCLES.
+    if (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk) {
+        passed = GREATER(passed, 1);
+    }
+    uint32_t boundary = GetBoundary(tick + passed + 1, cyclesPerTick);
+    while (!RestartSysTick(ctrl, boundary, cyclesPerTick)) {
+        // Waits for the boundary too close to restart at, so that its tick is not processed early.
+        while (static_cast<int32_t>(DWT->CYCCNT - boundary) < 0) {}
+        passed++;
+        boundary += cyclesPerTick;
+    }
+    if (passed == 0) {
+        return 0;
+    }
+    SCB->ICSR = SCB_ICSR_PENDSTSET_Msk;
+    return passed - 1;
+}
+
+// Called with kernel-aware interrupts disabled (QF_INT_DISABLE) and returns in the same state.
+// Returns the idle time in SysTick clock cycles.
+//
+// While sleeping, SysTick is reloaded to reach 0 at the boundary of the tick in which the next timer
+// expires. On wakeup by SysTick or another interrupt, SysTick is restarted at the next tick boundary.
+// The ticks that have passed are added to the HAL tick count and FW::Timer, except the last one which is
+// processed by SysTick_Handler() as usual.
+// Neither QF::tickX_() nor the QTimeEvt it serves are affected since it is only done when no
+// QTimeEvt (e.g. QXThread timeout) is armed.
+// DWT is enabled in HAL_InitTick(). A SysTick period is one more than its reload value.
+uint32_t BspTicklessSleep() {
+    uint32_t const cyclesPerTick = SystemCoreClock / BSP_TICKS_PER_SEC;
+    uint32_t idleTicks = 0;
+    if (QP::QF::noTimeEvtsActiveX(0)) {
+        idleTicks = FW::Timer::GetIdleTicks(SYSTICK_MAX_LOAD / cyclesPerTick);
+    }
+    uint32_t cycles = 0;
+    uint32_t skipTicks = 0;
+    // Use PRIMASK to disable interrupts since an interrupt masked by BASEPRI does not wake up WFI.
+    __disable_irq();
+    QF_INT_ENABLE();
+    if ((idleTicks < 2) || (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk)) {
+        // Sleep for no more than the current tick.
+        uint32_t load = SysTick->LOAD;
+        uint32_t startVal = SysTick->VAL;
+        __DSB();
+        __WFI();
+        __ISB();
+        uint32_t endVal = SysTick->VAL;
+        // SysTick can only have wrapped around once since it wakes up WFI.
+        cycles = (endVal <= startVal) ? (startVal - endVal) : (startVal + load + 1 - endVal);
+    } else {
+        // Reading CTRL clears COUNTFLAG.
+        uint32_t ctrl = SysTick->CTRL & ~(SysTick_CTRL_ENABLE_Msk | SysTick_CTRL_COUNTFLAG_Msk);
+        SysTick->CTRL = ctrl;
+        uint32_t start = DWT->CYCCNT;
+        if (!anchored) {
+            bool pending = SCB->ICSR & SCB_ICSR_PENDSTSET_Msk;
+            anchorTick = uwTick + (pending ? 2 : 1);
+            anchorCycle = start + SysTick->VAL;
+            anchored = true;
+        }
+        uint32_t tick = uwTick;
+        uint32_t sleepBoundary = GetBoundary(tick + idleTicks, cyclesPerTick);
+        // If the current tick has ended while SysTick is stopped, it is processed rather than sleeping.
+        if ((static_cast<int32_t>(start - GetBoundary(tick + 1, cyclesPerTick)) >= 0) ||
+            (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk) || !RestartSysTick(ctrl, sleepBoundary, cyclesPerTick)) {
+            skipTicks = ResumeSysTick(ctrl, start, cyclesPerTick);
+        } else {
+            // SysTick is reloaded for normal ticks when it reaches 0 at sleepBoundary.
+            __DSB();
+            __WFI();
+            __ISB();
+            SysTick->CTRL = ctrl;
+            uint32_t now = DWT->CYCCNT;
+            skipTicks = ResumeSysTick(ctrl, now, cyclesPerTick);
+            cycles = now - start;
+        }
+    }
+    // Pending interrupts remain masked by BASEPRI until the skipped ticks are accounted for.
+    QF_INT_DISABLE();
+    __enable_irq();
+    uwTick += skipTicks;
+    FW::Timer::Skip(skipTicks);
+    return cycles;
+}
+
+#endif // ENABLE_TICKLESS_IDLE
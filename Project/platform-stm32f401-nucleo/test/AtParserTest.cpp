@@ -0,0 +1,224 @@
+/*******************************************************************************
+ * Copyright (C) Gallium Studio LLC. All rights reserved.
+ *
+ * This program is open source software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Alternatively, this program may be distributed and modified under the
+ * terms of Gallium Studio LLC commercial licenses, which expressly supersede
+ * the GNU General Public License and are specifically designed for licensees
+ * interested in retaining the proprietary status of their code.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * Contact information:
+ * Website - https://www.galliumstudio.com
+ * Source repository - https://github.com/galliumstudio
+ * Email - admin@galliumstudio.com
+ ******************************************************************************/
+
+// Host test of AtParser. A modem transcript is fed in every read size from 1 to READ_MAX bytes, so that
+// each token is split at every position. The tokens and fields returned must be the same for all sizes.
+// The transcript is also scanned the way WifiSt did before AtParser, i.e. strstr() on each read for
+// "+WIND:24", "+WIND:55" and "Mdev", to report how many of those tokens that approach misses and to compare
+// the throughput of both.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "fw_macro.h"
+#include "AtParser.h"
+
+using namespace APP;
+
+extern "C" void Q_onAssert(char const * const module, int location) {
+    printf("Assert failed in %s at line %d\n", module, location);
+    exit(1);
+}
+
+namespace {
+
+enum {
+    READ_MAX = 99,          // Size of the buffer WifiSt reads from the input FIFO.
+    REPEAT = 8,             // Copies of the transcript fed in one pass, to vary where reads split tokens.
+    BENCH_BYTES = 64 * 1024 * 1024,
+};
+
+// Payload bytes include NUL, line endings and "OK" which must not be taken as tokens.
+char const TRANSCRIPT[] =
+    "\r\n+WIND:1:Poweron:170223\r\n"
+    "+WIND:24:WiFi Up:0:192.168.1.10\r\n"
+    "at+s.sockon=10.0.0.1,8080,,t\r\n"
+    " ID: 01\r\n"
+    "AT-S.OK\r\n"
+    "+WIND:55:Pending Data:1:12\r\n"
+    "AT-S.Reading:12:12\r\n"
+    "Mdev" "\x01\x00\r\nOK\r\n\x00\x02"
+    "\r\nAT-S.OK\r\n"
+    "AT-S.ERROR:62:Socket not open\r\n"
+    "+WIND:58:Socket Closed:1:0\r\n"
+    "ERROR\r\n"
+    "+WIND:33:WiFi Network Lost\r\n";
+
+struct Expected {
+    AtParser::Token token;
+    int32_t field[AtParser::FIELD_COUNT];   // -1 if not numeric.
+};
+
+Expected const EXPECTED[] = {
+    { AtParser::TOKEN_WIND,     { 1, -1, 170223, -1 } },
+    { AtParser::TOKEN_WIND,     { 24, -1, 0, -1 } },
+    { AtParser::TOKEN_SOCK_ID,  { 1, -1, -1, -1 } },
+    { AtParser::TOKEN_OK,       { 0 } },
+    { AtParser::TOKEN_WIND,     { 55, -1, 1, 12 } },
+    { AtParser::TOKEN_PAYLOAD,  { 0 } },
+    { AtParser::TOKEN_OK,       { 0 } },
+    { AtParser::TOKEN_ERROR,    { 0 } },
+    { AtParser::TOKEN_WIND,     { 58, -1, 1, 0 } },
+    { AtParser::TOKEN_ERROR,    { 0 } },
+    { AtParser::TOKEN_WIND,     { 33, -1, -1, -1 } },
+};
+
+char const PAYLOAD[AtParser::PAYLOAD_LEN] = { 'M', 'd', 'e', 'v', 1, 0, '\r', '\n', 'O', 'K', '\r', '\n' };
+
+// Tokens WifiSt acted on before AtParser.
+char const * const OLD_PATTERN[] = { "+WIND:24", "+WIND:55", "Mdev" };
+
+uint32_t const STREAM_LEN = (sizeof(TRANSCRIPT) - 1) * REPEAT;
+char stream[STREAM_LEN];
+
+uint32_t failures = 0;
+
+void Fail(uint32_t readLen, uint32_t idx, char const *what) {
+    if (failures++ < 10) {
+        printf("FAIL: read size %u, token %u: %s\n", readLen, idx, what);
+    }
+}
+
+// Returns number of tokens checked.
+uint32_t CheckTokens(uint32_t readLen) {
+    AtParser parser;
+    uint32_t idx = 0;
+    for (uint32_t pos = 0; pos < STREAM_LEN; pos += readLen) {
+        uint32_t len = (STREAM_LEN - pos < readLen) ? (STREAM_LEN - pos) : readLen;
+        for (uint32_t i = 0; i < len; i++) {
+            AtParser::Token token = parser.Parse(stream[pos + i]);
+            if (token == AtParser::TOKEN_NONE) {
+                continue;
+            }
+            Expected const &exp = EXPECTED[idx % ARRAY_COUNT(EXPECTED)];
+            if (token != exp.token) {
+                Fail(readLen, idx, "wrong token");
+            } else if ((token == AtParser::TOKEN_WIND) || (token == AtParser::TOKEN_SOCK_ID)) {
+                for (uint32_t f = 0; f < AtParser::FIELD_COUNT; f++) {
+                    uint32_t value;
+                    bool valid = parser.GetField(f, value);
+                    if ((valid != (exp.field[f] >= 0)) || (valid && (value != static_cast<uint32_t>(exp.field[f])))) {
+                        Fail(readLen, idx, "wrong field");
+                    }
+                }
+            } else if (token == AtParser::TOKEN_PAYLOAD) {
+                if (memcmp(parser.GetPayload(), PAYLOAD, sizeof(PAYLOAD)) != 0) {
+                    Fail(readLen, idx, "wrong payload");
+                }
+            }
+            idx++;
+        }
+    }
+    if (idx != ARRAY_COUNT(EXPECTED) * REPEAT) {
+        Fail(readLen, idx, "wrong token count");
+    }
+    return idx;
+}
+
+// Scans each read as WifiSt did before AtParser. Returns number of OLD_PATTERN matches.
+uint32_t OldScan(uint32_t readLen) {
+    char buf[READ_MAX + 1];
+    uint32_t count = 0;
+    for (uint32_t pos = 0; pos < STREAM_LEN; pos += readLen) {
+        uint32_t len = (STREAM_LEN - pos < readLen) ? (STREAM_LEN - pos) : readLen;
+        memcpy(buf, &stream[pos], len);
+        buf[len] = 0;
+        for (uint32_t p = 0; p < ARRAY_COUNT(OLD_PATTERN); p++) {
+            if (strstr(buf, OLD_PATTERN[p])) {
+                count++;
+            }
+        }
+    }
+    return count;
+}
+
+double Now() {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+} // namespace
+
+int main() {
+    for (uint32_t i = 0; i < REPEAT; i++) {
+        memcpy(&stream[i * (sizeof(TRANSCRIPT) - 1)], TRANSCRIPT, sizeof(TRANSCRIPT) - 1);
+    }
+    uint32_t tokens = 0;
+    uint32_t oldMissed = 0;
+    uint32_t oldMissedSizes = 0;
+    uint32_t const oldExpected = ARRAY_COUNT(OLD_PATTERN) * REPEAT;
+    for (uint32_t readLen = 1; readLen <= READ_MAX; readLen++) {
+        tokens += CheckTokens(readLen);
+        uint32_t found = OldScan(readLen);
+        if (found < oldExpected) {
+            oldMissed += oldExpected - found;
+            oldMissedSizes++;
+        }
+    }
+    printf("AtParser: %u tokens checked over read sizes 1 to %u\n", tokens, READ_MAX);
+    printf("strstr per read: missed %u of %u tokens, in %u of %u read sizes\n", oldMissed, oldExpected * READ_MAX,
+           oldMissedSizes, READ_MAX);
+
+    uint32_t const rounds = BENCH_BYTES / STREAM_LEN;
+    uint32_t const bytes = rounds * STREAM_LEN;
+    AtParser parser;
+    volatile uint32_t sink = 0;
+    double start = Now();
+    for (uint32_t r = 0; r < rounds; r++) {
+        for (uint32_t i = 0; i < STREAM_LEN; i++) {
+            sink += parser.Parse(stream[i]);
+        }
+    }
+    double parseTime = Now() - start;
+    start = Now();
+    for (uint32_t r = 0; r < rounds; r++) {
+        sink += OldScan(READ_MAX);
+    }
+    double oldTime = Now() - start;
+    printf("AtParser: %.1f MB/s, strstr per %u-byte read: %.1f MB/s\n", bytes / parseTime / 1e6, READ_MAX,
+           bytes / oldTime / 1e6);
+
+    if (failures) {
+        printf("FAILED: %u failures\n", failures);
+        return 1;
+    }
+    printf("PASSED\n");
+    return 0;
+}
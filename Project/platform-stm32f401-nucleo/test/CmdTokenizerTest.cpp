@@ -0,0 +1,268 @@
+/*******************************************************************************
+ * Copyright (C) Gallium Studio LLC. All rights reserved.
+ *
+ * This program is open source software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Alternatively, this program may be distributed and modified under the
+ * terms of Gallium Studio LLC commercial licenses, which expressly supersede
+ * the GNU General Public License and are specifically designed for licensees
+ * interested in retaining the proprietary status of their code.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * Contact information:
+ * Website - https://www.galliumstudio.com
+ * Source repository - https://github.com/galliumstudio
+ * Email - admin@galliumstudio.com
+ ******************************************************************************/
+
+// Host test of CmdTokenizer, which replaced the event-driven parser in the CmdParser region.
+// 1. A corpus of command lines covering delimiters, quoting, escapes and the maxArgc cut-off is checked
+//    against the expected arguments.
+// 2. Random lines are parsed by CmdTokenizer and by OldParse(), a transcription of the former Delimiter,
+//    SimpleArg and QuotedArg states. argc, argv and the terminated buffer must be identical.
+// 3. Lines per second of CmdTokenizer are reported, with the number of events the former parser posted
+//    for the same lines.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "fw_macro.h"
+#include "CmdTokenizer.h"
+
+using namespace APP;
+
+extern "C" void Q_onAssert(char const * const module, int location) {
+    printf("Assert failed in %s at line %d\n", module, location);
+    exit(1);
+}
+
+namespace {
+
+enum {
+    MAX_ARGC = 8,           // As Console::MAX_ARGC.
+    MAX_LEN = 80,
+    RANDOM_LINES = 200000,
+    BENCH_ROUNDS = 200000,
+};
+
+struct Case {
+    char const *line;
+    uint32_t maxArgc;
+    uint32_t argc;
+    char const *argv[MAX_ARGC];
+};
+
+Case const CORPUS[] = {
+    { "", MAX_ARGC, 0, {} },
+    { "  \t ", MAX_ARGC, 0, {} },
+    { "wifi conn 10.0.0.1 8080", MAX_ARGC, 4, { "wifi", "conn", "10.0.0.1", "8080" } },
+    { "  sys\tpool   reset \t", MAX_ARGC, 3, { "sys", "pool", "reset" } },
+    { "log \"a b\tc\" d", MAX_ARGC, 3, { "log", "a b\tc", "d" } },
+    { "mw \"\" x", MAX_ARGC, 3, { "mw", "", "x" } },
+    { "a\"b c\"d", MAX_ARGC, 3, { "a", "b c", "d" } },
+    { "say \"he said \\\"hi\\\"\"", MAX_ARGC, 2, { "say", "he said \\\"hi\\\"" } },
+    { "say \"a\\\\\" b", MAX_ARGC, 3, { "say", "a\\\\", "b" } },
+    { "x \"ends with slash\\", MAX_ARGC, 2, { "x", "ends with slash\\" } },
+    { "path\\to\\file \\\"", MAX_ARGC, 3, { "path\\to\\file", "\\", "" } },
+    { "\"unterminated arg", MAX_ARGC, 1, { "unterminated arg" } },
+    { "a b c d e", 3, 3, { "a", "b", "c d e" } },
+    { "  hello  world ", 1, 1, { "hello  world " } },
+    { "a \"b c\" d", 2, 2, { "a", "b c\" d" } },
+    { "a b", 0, 0, {} },
+    { "1 2 3 4 5 6 7 8 9 10", MAX_ARGC, MAX_ARGC, { "1", "2", "3", "4", "5", "6", "7", "8 9 10" } },
+};
+
+// Typical console lines for the benchmark.
+char const * const BENCH_LINES[] = {
+    "sys pool",
+    "wifi conn 192.168.1.10 8080",
+    "mw digit 4",
+    "log on \"Microwave\" UartOut",
+    "wifi send 0 \"hello from the console\"",
+    "sys tran 1000",
+};
+
+uint32_t failures = 0;
+
+void Fail(char const *line, char const *what) {
+    if (failures++ < 10) {
+        printf("FAIL: \"%s\": %s\n", line, what);
+    }
+}
+
+// Transcription of the former event-driven parser. Each STEP event looked at the next character and posted a
+// character class event followed by another STEP, or DONE at the end. Returns argc and the number of events
+// posted in evtCount.
+uint32_t OldParse(char *cmdStr, char const **argv, uint32_t maxArgc, uint32_t &evtCount) {
+    enum { DELIMITER, SIMPLE_ARG, QUOTED_ARG } state = DELIMITER;
+    uint32_t argc = 0;
+    int32_t index = -1;
+    evtCount = 1;
+    for (;;) {
+        char ch = cmdStr[++index];
+        if ((argc >= maxArgc) || (ch == 0)) {
+            evtCount++;
+            return argc;
+        }
+        evtCount += 2;
+        bool delim = (ch == ' ') || (ch == '\t');
+        switch (state) {
+            case DELIMITER: {
+                if (ch == '"') {
+                    argv[argc++] = &cmdStr[index + 1];
+                    state = QUOTED_ARG;
+                } else if (!delim) {
+                    argv[argc++] = &cmdStr[index];
+                    state = SIMPLE_ARG;
+                }
+                break;
+            }
+            case SIMPLE_ARG: {
+                if (delim) {
+                    cmdStr[index] = 0;
+                    state = DELIMITER;
+                } else if (ch == '"') {
+                    cmdStr[index] = 0;
+                    argv[argc++] = &cmdStr[index + 1];
+                    state = QUOTED_ARG;
+                }
+                break;
+            }
+            case QUOTED_ARG: {
+                if (ch == '"') {
+                    cmdStr[index] = 0;
+                    state = DELIMITER;
+                } else if ((ch == '\\') && cmdStr[index + 1]) {
+                    index++;
+                }
+                break;
+            }
+        }
+    }
+}
+
+void CheckCorpus() {
+    for (uint32_t i = 0; i < ARRAY_COUNT(CORPUS); i++) {
+        Case const &c = CORPUS[i];
+        char buf[MAX_LEN + 1];
+        STRING_COPY(buf, c.line, sizeof(buf));
+        char const *argv[MAX_ARGC];
+        uint32_t argc = CmdTokenizer::Parse(buf, argv, c.maxArgc);
+        if (argc != c.argc) {
+            Fail(c.line, "wrong argc");
+            continue;
+        }
+        for (uint32_t a = 0; a < argc; a++) {
+            if (!STRING_EQUAL(argv[a], c.argv[a])) {
+                Fail(c.line, "wrong argument");
+            }
+        }
+    }
+}
+
+void CheckRandom() {
+    static char const CHARS[] = { ' ', '\t', '"', '\\', 'a', 'b' };
+    srand(1);
+    for (uint32_t n = 0; n < RANDOM_LINES; n++) {
+        char line[MAX_LEN + 1];
+        uint32_t len = rand() % MAX_LEN;
+        for (uint32_t i = 0; i < len; i++) {
+            line[i] = CHARS[rand() % sizeof(CHARS)];
+        }
+        line[len] = 0;
+        uint32_t maxArgc = rand() % (MAX_ARGC + 1);
+        char newBuf[MAX_LEN + 1];
+        char oldBuf[MAX_LEN + 1];
+        memcpy(newBuf, line, sizeof(line));
+        memcpy(oldBuf, line, sizeof(line));
+        char const *newArgv[MAX_ARGC];
+        char const *oldArgv[MAX_ARGC];
+        uint32_t evtCount;
+        uint32_t argc = CmdTokenizer::Parse(newBuf, newArgv, maxArgc);
+        if (argc != OldParse(oldBuf, oldArgv, maxArgc, evtCount)) {
+            Fail(line, "argc differs from former parser");
+            continue;
+        }
+        if (memcmp(newBuf, oldBuf, sizeof(newBuf)) != 0) {
+            Fail(line, "terminators differ from former parser");
+        }
+        for (uint32_t a = 0; a < argc; a++) {
+            if ((newArgv[a] - newBuf) != (oldArgv[a] - oldBuf)) {
+                Fail(line, "argv differs from former parser");
+            }
+        }
+    }
+}
+
+double Now() {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+void Bench() {
+    uint32_t const lineCount = ARRAY_COUNT(BENCH_LINES);
+    uint32_t chars = 0;
+    uint32_t events = 0;
+    for (uint32_t i = 0; i < lineCount; i++) {
+        char buf[MAX_LEN + 1];
+        char const *argv[MAX_ARGC];
+        uint32_t evtCount;
+        STRING_COPY(buf, BENCH_LINES[i], sizeof(buf));
+        OldParse(buf, argv, MAX_ARGC, evtCount);
+        chars += strlen(BENCH_LINES[i]);
+        events += evtCount;
+    }
+    volatile uint32_t sink = 0;
+    double start = Now();
+    for (uint32_t r = 0; r < BENCH_ROUNDS; r++) {
+        for (uint32_t i = 0; i < lineCount; i++) {
+            char buf[MAX_LEN + 1];
+            char const *argv[MAX_ARGC];
+            strcpy(buf, BENCH_LINES[i]);
+            sink += CmdTokenizer::Parse(buf, argv, MAX_ARGC);
+        }
+    }
+    double time = Now() - start;
+    printf("CmdTokenizer: %.2f M lines/s, %.1f chars per line\n", BENCH_ROUNDS * lineCount / time / 1e6,
+           static_cast<double>(chars) / lineCount);
+    printf("Former parser: %.1f events per line, none now\n", static_cast<double>(events) / lineCount);
+}
+
+} // namespace
+
+int main() {
+    CheckCorpus();
+    printf("Corpus: %u lines checked\n", static_cast<uint32_t>(ARRAY_COUNT(CORPUS)));
+    CheckRandom();
+    printf("Random: %u lines compared with former parser\n", RANDOM_LINES);
+    Bench();
+    if (failures) {
+        printf("FAILED: %u failures\n", failures);
+        return 1;
+    }
+    printf("PASSED\n");
+    return 0;
+}
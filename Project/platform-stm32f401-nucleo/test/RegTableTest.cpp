@@ -0,0 +1,222 @@
+/*******************************************************************************
+ * Copyright (C) Gallium Studio LLC. All rights reserved.
+ *
+ * This program is open source software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Alternatively, this program may be distributed and modified under the
+ * terms of Gallium Studio LLC commercial licenses, which expressly supersede
+ * the GNU General Public License and are specifically designed for licensees
+ * interested in retaining the proprietary status of their code.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * Contact information:
+ * Website - https://www.galliumstudio.com
+ * Source repository - https://github.com/galliumstudio
+ * Email - admin@galliumstudio.com
+ ******************************************************************************/
+
+// Host test and benchmark of HsmnRegTable, which replaced the HSMN to region map searched by Active::dispatch()
+// and XThread::Dispatch().
+// 1. For random sets of regions, HsmnRegTable::Get() must return the same region as the former lookup with
+//    Map::GetByKey() for every HSMN.
+// 2. For MAX_REGION_COUNT of 8 to 64, the time to look up and dispatch to a region is measured with the table
+//    full, for both HsmnRegTable and the former map. A lookup of an HSMN not contained is measured as well.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "qpcpp.h"
+#include "fw_macro.h"
+#include "fw_map.h"
+#include "fw_regtable.h"
+
+using namespace FW;
+
+extern "C" void Q_onAssert(char const * const module, int location) {
+    printf("Assert failed in %s at line %d\n", module, location);
+    exit(1);
+}
+
+namespace QP {
+
+// Stand-in for a region of an active object. Dispatching only counts the events.
+class QHsm {
+public:
+    QHsm() : m_count(0) {}
+    virtual ~QHsm() {}
+    virtual void dispatch(uint32_t sig) { m_count += sig; }
+private:
+    uint32_t m_count;
+};
+
+} // namespace QP
+
+using namespace QP;
+
+namespace {
+
+// As removed from fw_maptype.h, with QHsm for Region.
+typedef KeyValue<Hsmn, QHsm *> HsmnReg;
+typedef Map<Hsmn, QHsm *> HsmnRegMap;
+
+enum {
+    CHECK_ROUNDS = 1000,
+    SEQ_LEN = 1024,             // Length of the HSMN sequence looked up.
+    BENCH_LOOKUPS = 20000000,
+};
+
+uint32_t failures = 0;
+
+void Fail(char const *what) {
+    if (failures++ < 10) {
+        printf("FAIL: %s\n", what);
+    }
+}
+
+uint32_t seed = 12345;
+uint32_t Random(uint32_t n) {
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    return seed % n;
+}
+
+double Now() {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// As the former Active::dispatch().
+QHsm *MapGet(HsmnRegMap &map, Hsmn hsmn) {
+    HsmnReg *hsmnReg = map.GetByKey(hsmn);
+    return (hsmnReg && hsmnReg->GetValue()) ? hsmnReg->GetValue() : NULL;
+}
+
+// Adds count regions of random distinct HSMN to both the table and the map. Returns the HSMN in hsmn[].
+template <uint32_t N>
+void Fill(HsmnRegTable<N> &table, HsmnRegMap &map, QHsm *reg, uint32_t count, Hsmn *hsmn) {
+    bool used[MAX_HSM_COUNT] = { true };
+    for (uint32_t i = 0; i < count; i++) {
+        Hsmn h;
+        do {
+            h = Random(MAX_HSM_COUNT);
+        } while (used[h]);
+        used[h] = true;
+        hsmn[i] = h;
+        table.Add(h, &reg[i]);
+        map.Save(HsmnReg(h, &reg[i]));
+    }
+}
+
+template <uint32_t N>
+void Check() {
+    uint32_t const maxCount = LESS(N, static_cast<uint32_t>(MAX_HSM_COUNT - 1));
+    for (uint32_t r = 0; r < CHECK_ROUNDS; r++) {
+        HsmnRegTable<N> table;
+        HsmnReg stor[N];
+        HsmnRegMap map(stor, N, HsmnReg(HSM_UNDEF, NULL));
+        QHsm reg[N];
+        Hsmn hsmn[N];
+        uint32_t count = Random(maxCount + 1);
+        Fill(table, map, reg, count, hsmn);
+        if (table.GetCount() != count) {
+            Fail("wrong region count");
+        }
+        for (uint32_t h = 0; h < 0x100; h++) {
+            QHsm *expected = (h < MAX_HSM_COUNT) ? MapGet(map, h) : NULL;
+            if (table.Get(h) != expected) {
+                Fail("region differs from the former map lookup");
+            }
+        }
+    }
+}
+
+template <class Lookup>
+double Time(Lookup lookup, Hsmn const *seq) {
+    double start = Now();
+    for (uint32_t i = 0; i < BENCH_LOOKUPS; i++) {
+        QHsm *reg = lookup(seq[i % SEQ_LEN]);
+        if (reg) {
+            reg->dispatch(1);
+        }
+    }
+    return (Now() - start) * 1e9 / BENCH_LOOKUPS;
+}
+
+template <uint32_t N>
+void Bench() {
+    uint32_t const count = LESS(N, static_cast<uint32_t>(MAX_HSM_COUNT - 1));
+    HsmnRegTable<N> table;
+    HsmnReg stor[N];
+    HsmnRegMap map(stor, N, HsmnReg(HSM_UNDEF, NULL));
+    QHsm reg[N];
+    Hsmn hsmn[N];
+    Fill(table, map, reg, count, hsmn);
+    Hsmn seq[SEQ_LEN];
+    for (uint32_t i = 0; i < SEQ_LEN; i++) {
+        seq[i] = hsmn[Random(count)];
+    }
+    // An HSMN not contained.
+    Hsmn miss[SEQ_LEN];
+    bool used[MAX_HSM_COUNT] = { true };
+    for (uint32_t i = 0; i < count; i++) {
+        used[hsmn[i]] = true;
+    }
+    Hsmn h = 0;
+    while ((h < MAX_HSM_COUNT) && used[h]) {
+        h++;
+    }
+    for (uint32_t i = 0; i < SEQ_LEN; i++) {
+        miss[i] = h;
+    }
+    auto tableGet = [&table](Hsmn k) { return table.Get(k); };
+    auto mapGet = [&map](Hsmn k) { return MapGet(map, k); };
+    double tableHit = Time(tableGet, seq);
+    double mapHit = Time(mapGet, seq);
+    double tableMiss = Time(tableGet, miss);
+    double mapMiss = Time(mapGet, miss);
+    printf("MAX_REGION_COUNT %2u, %2u regions: table %.1f ns, map %.1f ns per dispatch; not contained: "
+           "table %.1f ns, map %.1f ns\n", N, count, tableHit, mapHit, tableMiss, mapMiss);
+}
+
+} // namespace
+
+int main() {
+    Check<8>();
+    Check<16>();
+    Check<32>();
+    Check<64>();
+    printf("Check: %u random region sets per MAX_REGION_COUNT\n", CHECK_ROUNDS);
+    Bench<8>();
+    Bench<16>();
+    Bench<32>();
+    Bench<64>();
+    if (failures) {
+        printf("FAILED: %u failures\n", failures);
+        return 1;
+    }
+    printf("PASSED\n");
+    return 0;
+}
@@ -0,0 +1,217 @@
+/*******************************************************************************
+ * Copyright (C) Gallium Studio LLC. All rights reserved.
+ *
+ * This program is open source software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Alternatively, this program may be distributed and modified under the
+ * terms of Gallium Studio LLC commercial licenses, which expressly supersede
+ * the GNU General Public License and are specifically designed for licensees
+ * interested in retaining the proprietary status of their code.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * Contact information:
+ * Website - https://www.galliumstudio.com
+ * Source repository - https://github.com/galliumstudio
+ * Email - admin@galliumstudio.com
+ ******************************************************************************/
+
+// Host stress test of SpscPipe. A producer thread and a consumer thread run concurrently on the host.
+// 1. Ordering and loss: the producer writes a running sequence in random burst sizes, retrying when the pipe
+//    is full. The consumer reads random counts and checks each entry is the next in the sequence.
+// 2. Notification: the consumer waits on a semaphore whenever a read leaves the pipe empty, and the producer
+//    signals it whenever Write() sets its status. A missed notification leaves the consumer waiting, which
+//    is reported after NOTIFY_TIMEOUT_MS.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include "qpcpp.h"
+#include "fw_macro.h"
+#include "fw_spscpipe.h"
+
+using namespace FW;
+
+extern "C" void Q_onAssert(char const * const module, int location) {
+    printf("Assert failed in %s at line %d\n", module, location);
+    exit(1);
+}
+
+namespace {
+
+enum {
+    BURST_MAX = 48,
+    NOTIFY_TIMEOUT_MS = 2000,
+};
+
+uint32_t failures = 0;
+std::mutex failMutex;
+
+void Fail(char const *name, char const *what) {
+    std::lock_guard<std::mutex> lock(failMutex);
+    if (failures++ < 10) {
+        printf("FAIL: %s: %s\n", name, what);
+    }
+}
+
+double Now() {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+class Random {
+public:
+    Random(uint32_t seed) : m_seed(seed) {}
+    uint32_t Get(uint32_t n) {
+        m_seed ^= m_seed << 13;
+        m_seed ^= m_seed >> 17;
+        m_seed ^= m_seed << 5;
+        return m_seed % n;
+    }
+private:
+    uint32_t m_seed;
+};
+
+// Counting semaphore, as the event posted to the reader on a notification.
+class Semaphore {
+public:
+    Semaphore() : m_count(0), m_signalCount(0) {}
+    void Signal() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_count++;
+        m_signalCount++;
+        m_cond.notify_one();
+    }
+    bool Wait(uint32_t timeoutMs) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (!m_cond.wait_for(lock, std::chrono::milliseconds(timeoutMs), [this] { return m_count > 0; })) {
+            return false;
+        }
+        m_count--;
+        return true;
+    }
+    uint32_t GetSignalCount() const { return m_signalCount; }
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_cond;
+    uint32_t m_count;
+    uint32_t m_signalCount;
+};
+
+// Entries carry the low bits of the sequence number for Type narrower than 32 bits.
+template <class Type>
+void Run(char const *name, uint8_t order, uint32_t total, bool notify) {
+    Type *stor = new Type[1UL << order];
+    SpscPipe<Type> pipe(stor, order);
+    Semaphore sem;
+    uint32_t fullCount = 0;
+    uint32_t waitCount = 0;
+    double start = Now();
+    std::thread producer([&] {
+        Random random(1);
+        Type buf[BURST_MAX];
+        uint32_t seq = 0;
+        while (seq < total) {
+            // LESS() evaluates its arguments twice, so the random count must be drawn first.
+            uint32_t count = 1 + random.Get(LESS(static_cast<uint32_t>(BURST_MAX), pipe.GetBufSize() - 1));
+            count = LESS(count, total - seq);
+            for (uint32_t i = 0; i < count; i++) {
+                buf[i] = static_cast<Type>(seq + i);
+            }
+            bool status = false;
+            while (pipe.Write(buf, count, notify ? &status : NULL) == 0) {
+                if (!pipe.IsTruncated()) {
+                    Fail(name, "write of zero count");
+                }
+                fullCount++;
+                std::this_thread::yield();
+            }
+            if (status) {
+                sem.Signal();
+            }
+            seq += count;
+        }
+    });
+    std::thread consumer([&] {
+        Random random(2);
+        Type buf[BURST_MAX];
+        uint32_t seq = 0;
+        while (seq < total) {
+            bool empty = false;
+            uint32_t count = pipe.Read(buf, 1 + random.Get(BURST_MAX), notify ? &empty : NULL);
+            for (uint32_t i = 0; i < count; i++) {
+                if (buf[i] != static_cast<Type>(seq + i)) {
+                    Fail(name, "entry out of order or lost");
+                    seq = total;
+                    break;
+                }
+            }
+            seq += count;
+            if (notify && (seq < total) && ((count == 0) || empty)) {
+                waitCount++;
+                if (!sem.Wait(NOTIFY_TIMEOUT_MS)) {
+                    Fail(name, "notification missed");
+                    break;
+                }
+            } else if (count == 0) {
+                std::this_thread::yield();
+            }
+        }
+    });
+    producer.join();
+    consumer.join();
+    double time = Now() - start;
+    if (pipe.GetUsedCount() != 0) {
+        Fail(name, "pipe not empty at the end");
+    }
+    printf("%s: %u entries of %u bytes through %u slots, %.1f M entries/s, full %u times", name, total,
+           static_cast<uint32_t>(sizeof(Type)), pipe.GetBufSize(), total / time / 1e6, fullCount);
+    if (notify) {
+        printf(", %u waits, %u notifications", waitCount, sem.GetSignalCount());
+    }
+    printf("\n");
+    delete[] stor;
+}
+
+} // namespace
+
+int main() {
+    printf("%u hardware threads\n", std::thread::hardware_concurrency());
+    Run<uint8_t>("SpscFifo", 5, 10000000, false);
+    Run<uint8_t>("SpscFifo", 10, 50000000, false);
+    Run<uint32_t>("MagnetronPipe", 3, 5000000, false);
+    Run<uint32_t>("SpscPipe<uint32_t>", 12, 50000000, false);
+    Run<uint8_t>("SpscFifo notify", 5, 5000000, true);
+    Run<uint32_t>("SpscPipe<uint32_t> notify", 10, 20000000, true);
+    if (failures) {
+        printf("FAILED: %u failures\n", failures);
+        return 1;
+    }
+    printf("PASSED\n");
+    return 0;
+}
@@ -0,0 +1,664 @@
+/*******************************************************************************
+ * Copyright (C) Gallium Studio LLC. All rights reserved.
+ *
+ * This program is open source software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Alternatively, this program may be distributed and modified under the
+ * terms of Gallium Studio LLC commercial licenses, which expressly supersede
+ * the GNU General Public License and are specifically designed for licensees
+ * interested in retaining the proprietary status of their code.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * Contact information:
+ * Website - https://www.galliumstudio.com
+ * Source repository - https://github.com/galliumstudio
+ * Email - admin@galliumstudio.com
+ ******************************************************************************/
+
+// Host simulation of tickless idle. BspTicklessSleep() (src/tickless.cpp) and FW::Timer on the timing wheel
+// (FW_TIMER_WHEEL) are compiled unchanged, with SysTick, DWT CYCCNT, WFI and interrupt masking simulated on a
+// virtual clock of core cycles (see host/tickless). Each register access takes REG_CYCLES, so SysTick loses
+// time whenever it is stopped.
+// 1. Microwave idle: Microwave's 500 ms clock timer and System's 2 s CPU utilization timer run, with a key
+//    press (GpioIn pulse and hold timers) and a console character (UartIn active timer) every few seconds.
+//    Wakeups from WFI are counted against the ticks a fixed 1 kHz SysTick would take.
+// 2. Random: timers of random timeouts are started, restarted and stopped on timeouts and on interrupts at
+//    random times.
+// Checks:
+// - Every timeout is posted in the tick it is due, i.e. when GetSystemMs() reaches its start time plus its
+//   timeout.
+// - No tick is processed before its boundary on the virtual clock. The phase of SysTick against the ideal
+//   tick boundaries, which grows by the cycles SysTick is stopped for but not compensated, stays within
+//   PHASE_PPM_MAX of the run time.
+// - The tick count seen by interrupts is the number of tick boundaries passed, or one less when the tick
+//   interrupt is pending.
+// - The idle time returned for the CPU utilization matches the time spent in WFI within IDLE_ERROR_MAX.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "fw_macro.h"
+#include "bsp.h"
+#include "fw_timer.h"
+#include "fw_prof.h"
+
+using namespace QP;
+using namespace FW;
+
+extern "C" void Q_onAssert(char const * const module, int location) {
+    printf("Assert failed in %s at line %d\n", module, location);
+    exit(1);
+}
+
+extern __IO uint32_t uwTick;    // HAL tick count of GetSystemMs(). Defined below as in stm32f4xx_hal.c.
+
+namespace {
+
+enum {
+    CORE_HZ = 84000000,                                 // As SystemClock_Config().
+    CYCLES_PER_TICK = CORE_HZ / BSP_TICKS_PER_SEC,
+    CYCLES_PER_MS = CORE_HZ / 1000,
+    REG_CYCLES = 2,             // Per access to a SysTick, DWT or SCB register, and per barrier.
+    TICK_ISR_CYCLES = 400,      // SysTick_Handler().
+    EXT_ISR_CYCLES = 300,       // Other interrupts.
+    DISPATCH_CYCLES = 4200,     // Per event dispatched.
+    RUN_SEC = 600,              // Virtual run time of each scenario.
+    QUEUE_SIZE = 64,
+    PHASE_PPM_MAX = 1,
+};
+
+uint64_t const NEVER = ~0ULL;
+double const IDLE_ERROR_MAX = 0.001;    // Of the run time.
+
+uint32_t failures = 0;
+
+void Fail(char const *what) {
+    if (failures++ < 10) {
+        printf("FAIL: %s\n", what);
+    }
+}
+
+// Virtual clock and SysTick. SysTick counts down once per cycle when enabled. When it reaches 0, COUNTFLAG
+// is set and its interrupt is pended. On the next cycle it is reloaded from LOAD. Writing VAL clears it to 0
+// without setting COUNTFLAG.
+uint64_t now;
+struct {
+    bool enable;
+    bool tickInt;
+    bool countFlag;
+    bool pending;
+    uint32_t load;
+    uint32_t val;
+} st;
+
+uint32_t basepri;
+bool primask;
+bool inIsr;
+bool pendSv;                // An event has been posted, so the idle thread is to be preempted.
+uint64_t extTime = NEVER;   // Time of the next external interrupt.
+
+struct Stat {
+    uint64_t wfiCycles;     // Time spent in WFI.
+    uint64_t idleCycles;    // Sum returned by BspTicklessSleep().
+    uint32_t wakeups;       // WFI that slept.
+    uint32_t tickIsrs;
+    uint32_t extIsrs;
+    uint32_t timeouts;      // Timeouts posted and checked.
+    uint64_t postLateMax;   // Cycles from the boundary of the tick a timeout is due to its post.
+    int64_t phaseMin;       // Cycles from the ideal tick boundary to SysTick reaching 0.
+    int64_t phaseMax;
+};
+Stat stat;
+
+void Advance(uint64_t cycles) {
+    while (cycles) {
+        if (!st.enable) {
+            now += cycles;
+            break;
+        }
+        if (st.val == 0) {
+            st.val = st.load;
+            now++;
+            cycles--;
+            continue;
+        }
+        uint64_t step = LESS(cycles, static_cast<uint64_t>(st.val));
+        st.val -= step;
+        now += step;
+        cycles -= step;
+        if (st.val == 0) {
+            st.countFlag = true;
+            st.pending = st.tickInt;
+        }
+    }
+}
+
+// Cycles until SysTick interrupt is pended, or NEVER.
+uint64_t CyclesToTick() {
+    if (!st.enable || !st.tickInt) {
+        return NEVER;
+    }
+    return st.val ? st.val : (static_cast<uint64_t>(st.load) + 1);
+}
+
+bool IsExtPending() {
+    return now >= extTime;
+}
+
+uint32_t ReadCtrl() {
+    uint32_t v = (st.enable ? SysTick_CTRL_ENABLE_Msk : 0) | (st.tickInt ? SysTick_CTRL_TICKINT_Msk : 0) |
+                 SysTick_CTRL_CLKSOURCE_Msk | (st.countFlag ? SysTick_CTRL_COUNTFLAG_Msk : 0);
+    st.countFlag = false;
+    Advance(REG_CYCLES);
+    return v;
+}
+void WriteCtrl(uint32_t v) {
+    st.enable = v & SysTick_CTRL_ENABLE_Msk;
+    st.tickInt = v & SysTick_CTRL_TICKINT_Msk;
+    Advance(REG_CYCLES);
+}
+uint32_t ReadLoad() {
+    Advance(REG_CYCLES);
+    return st.load;
+}
+void WriteLoad(uint32_t v) {
+    st.load = v & SysTick_LOAD_RELOAD_Msk;
+    Advance(REG_CYCLES);
+}
+uint32_t ReadVal() {
+    uint32_t v = st.val;
+    Advance(REG_CYCLES);
+    return v;
+}
+void WriteVal(uint32_t v) {
+    (void)v;
+    st.val = 0;
+    st.countFlag = false;
+    Advance(REG_CYCLES);
+}
+uint32_t ReadCyccnt() {
+    uint32_t v = static_cast<uint32_t>(now);
+    Advance(REG_CYCLES);
+    return v;
+}
+uint32_t ReadIcsr() {
+    uint32_t v = st.pending ? SCB_ICSR_PENDSTSET_Msk : 0;
+    Advance(REG_CYCLES);
+    return v;
+}
+void WriteIcsr(uint32_t v) {
+    if (v & SCB_ICSR_PENDSTSET_Msk) {
+        st.pending = true;
+    }
+    Advance(REG_CYCLES);
+}
+void WriteReadOnly(uint32_t v) {
+    (void)v;
+    Fail("write to read-only register");
+}
+
+void TickIsr();
+void ExtIsr();
+
+// Takes pending interrupts unless masked. SysTick has a higher priority than external interrupts.
+void Service() {
+    if (inIsr || basepri || primask) {
+        return;
+    }
+    for (;;) {
+        inIsr = true;
+        if (st.pending) {
+            st.pending = false;
+            TickIsr();
+        } else if (IsExtPending()) {
+            ExtIsr();
+        } else {
+            inIsr = false;
+            break;
+        }
+        inIsr = false;
+    }
+    pendSv = false;
+}
+
+// Runs with interrupts enabled for the number of cycles.
+void Run(uint64_t cycles) {
+    uint64_t end = now + cycles;
+    while (now < end) {
+        uint64_t step = LESS(end - now, CyclesToTick());
+        if (extTime > now) {
+            step = LESS(step, extTime - now);
+        }
+        Advance(GREATER(step, 1ULL));
+        Service();
+    }
+}
+
+// Phase of SysTick against the ideal boundary of the next tick. Only valid when SysTick runs normal ticks.
+void SamplePhase() {
+    if (st.enable && !st.pending && (st.val > 0) && (st.load == (CYCLES_PER_TICK - 1))) {
+        int64_t phase = static_cast<int64_t>(now + st.val) - static_cast<int64_t>((uwTick + 1ULL) * CYCLES_PER_TICK);
+        stat.phaseMin = LESS(stat.phaseMin, phase);
+        stat.phaseMax = GREATER(stat.phaseMax, phase);
+    }
+}
+
+// Timer with the tick at which its next timeout is due.
+class SimTimer : public Timer {
+public:
+    SimTimer(Hsmn hsmn, uint32_t index) :
+        Timer(hsmn, TIMER_EVT_START(hsmn) + index), m_armed(false), m_due(0), m_period(0) {}
+    void SimStart(uint32_t ms, bool periodic = false) {
+        Start(ms, periodic ? PERIODIC : ONCE);
+        m_armed = true;
+        m_due = uwTick + ms / BSP_MSEC_PER_TICK;
+        m_period = periodic ? (ms / BSP_MSEC_PER_TICK) : 0;
+    }
+    void SimStop() {
+        Stop();
+        m_armed = false;
+    }
+    void SimRestart(uint32_t ms, bool periodic = false) {
+        SimStop();
+        SimStart(ms, periodic);
+    }
+    bool IsArmed() const { return m_armed; }
+    void OnSimPost() {
+        if (!m_armed) {
+            Fail("timeout posted for a stopped timer");
+        } else if (uwTick != m_due) {
+            Fail("timeout posted in a wrong tick");
+        }
+        uint64_t due = static_cast<uint64_t>(m_due) * CYCLES_PER_TICK;
+        if (now < due) {
+            Fail("timeout posted before its tick boundary");
+        } else {
+            stat.postLateMax = GREATER(stat.postLateMax, now - due);
+        }
+        stat.timeouts++;
+        if (m_period) {
+            m_due += m_period;
+        } else {
+            m_armed = false;
+        }
+    }
+private:
+    bool m_armed;
+    uint32_t m_due;
+    uint32_t m_period;
+};
+
+// Event queue of the simulated active object. An entry is a timeout or an external interrupt.
+struct Item {
+    SimTimer *timer;
+    uint32_t source;
+};
+Item queue[QUEUE_SIZE];
+uint32_t queueHead;
+uint32_t queueTail;
+
+void Push(SimTimer *timer, uint32_t source) {
+    if ((queueHead - queueTail) >= QUEUE_SIZE) {
+        Fail("event queue overflow");
+        return;
+    }
+    queue[queueHead++ % QUEUE_SIZE] = { timer, source };
+    pendSv = true;
+}
+
+class SimAct : public QActive {
+public:
+    bool post_(QEvt const * const e, uint_fast16_t const margin, void const * const sender) {
+        (void)margin;
+        (void)sender;
+        SimTimer *timer = static_cast<SimTimer *>(const_cast<QEvt *>(e));
+        timer->OnSimPost();
+        Push(timer, 0);
+        return true;
+    }
+};
+SimAct simAct;
+
+uint32_t seed = 12345;
+uint32_t Random(uint32_t n) {
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    return seed % n;
+}
+
+// External interrupt sources. Each has the time of its next interrupt.
+enum {
+    SOURCE_COUNT = 3,
+};
+uint64_t sourceTime[SOURCE_COUNT];
+
+void UpdateExtTime() {
+    extTime = NEVER;
+    for (uint32_t i = 0; i < SOURCE_COUNT; i++) {
+        extTime = LESS(extTime, sourceTime[i]);
+    }
+}
+
+void ScheduleExt(uint32_t source, uint64_t delay) {
+    sourceTime[source] = now + delay;
+    UpdateExtTime();
+}
+
+void TickIsr() {
+    uint64_t boundary = (uwTick + 1ULL) * CYCLES_PER_TICK;
+    if (now < boundary) {
+        Fail("tick processed before its boundary");
+    }
+    uwTick++;       // HAL_IncTick()
+    stat.tickIsrs++;
+    Timer::Tick();
+    Advance(TICK_ISR_CYCLES);
+}
+
+void ExtIsr() {
+    uint64_t ticks = now / CYCLES_PER_TICK;
+    if ((uwTick > ticks) || ((uwTick + 1) < ticks)) {
+        Fail("tick count does not match the virtual clock");
+    }
+    for (uint32_t i = 0; i < SOURCE_COUNT; i++) {
+        if (sourceTime[i] <= now) {
+            sourceTime[i] = NEVER;
+            Push(NULL, i + 1);
+            break;
+        }
+    }
+    UpdateExtTime();
+    stat.extIsrs++;
+    Advance(EXT_ISR_CYCLES);
+}
+
+class Scenario {
+public:
+    virtual ~Scenario() {}
+    virtual void Start() = 0;
+    virtual void Stop() = 0;
+    virtual void OnTimeout(SimTimer *timer) = 0;
+    virtual void OnExt(uint32_t source) = 0;
+};
+
+// Microwave showing the clock, with System polling the idle count. The key is pressed every 7 to 8 s and
+// released after 80 to 400 ms. A console character arrives every 3.3 to 4 s.
+class MicrowaveIdle : public Scenario {
+public:
+    enum {
+        MICROWAVE = 1,
+        SYSTEM,
+        GPIO_IN,
+        UART_IN
+    };
+    enum {
+        KEY_PRESS,
+        KEY_RELEASE,
+        CONSOLE_RX
+    };
+    MicrowaveIdle() :
+        m_halfSecondTimer(MICROWAVE, 0), m_idleCntTimer(SYSTEM, 0), m_pulseTimer(GPIO_IN, 0),
+        m_holdTimer(GPIO_IN, 1), m_activeTimer(UART_IN, 0) {}
+    void Start() {
+        m_halfSecondTimer.SimStart(500, true);      // Microwave::HALF_SECOND_TIMEOUT_MS
+        m_idleCntTimer.SimStart(2000, true);        // System::IDLE_CNT_POLL_TIMEOUT_MS
+        ScheduleExt(KEY_PRESS, 7000ULL * CYCLES_PER_MS + Random(1000 * CYCLES_PER_MS));
+        ScheduleExt(CONSOLE_RX, 3300ULL * CYCLES_PER_MS + Random(700 * CYCLES_PER_MS));
+    }
+    void Stop() {
+        SimTimer *timer[] = { &m_halfSecondTimer, &m_idleCntTimer, &m_pulseTimer, &m_holdTimer, &m_activeTimer };
+        for (uint32_t i = 0; i < ARRAY_COUNT(timer); i++) {
+            timer[i]->SimStop();
+        }
+    }
+    void OnTimeout(SimTimer *timer) {
+        if (timer == &m_pulseTimer) {
+            m_holdTimer.SimStart(1000);             // GpioIn::HOLD_TIMEOUT_MS
+        }
+    }
+    void OnExt(uint32_t source) {
+        switch (source) {
+            case KEY_PRESS: {
+                m_pulseTimer.SimRestart(50);        // GpioIn::PULSE_TIMEOUT_MS
+                ScheduleExt(KEY_RELEASE, 80ULL * CYCLES_PER_MS + Random(320 * CYCLES_PER_MS));
+                ScheduleExt(KEY_PRESS, 7000ULL * CYCLES_PER_MS + Random(1000 * CYCLES_PER_MS));
+                break;
+            }
+            case KEY_RELEASE: {
+                m_pulseTimer.SimStop();
+                m_holdTimer.SimStop();
+                break;
+            }
+            case CONSOLE_RX: {
+                m_activeTimer.SimRestart(10);       // UartIn::ACTIVE_TIMER_MS
+                ScheduleExt(CONSOLE_RX, 3300ULL * CYCLES_PER_MS + Random(700 * CYCLES_PER_MS));
+                break;
+            }
+        }
+    }
+private:
+    SimTimer m_halfSecondTimer;
+    SimTimer m_idleCntTimer;
+    SimTimer m_pulseTimer;
+    SimTimer m_holdTimer;
+    SimTimer m_activeTimer;
+};
+
+// Timers of random timeouts up to 3 s, a quarter of them periodic. On a timeout a one-shot timer is started
+// again with a new timeout. Interrupts come on average every 25 ms, each restarting or stopping a random timer.
+class RandomTimers : public Scenario {
+public:
+    enum {
+        TIMER_COUNT = 32,
+        TIMEOUT_MAX_MS = 3000,
+        EXT_MEAN_MS = 25,
+    };
+    RandomTimers() {
+        for (uint32_t i = 0; i < TIMER_COUNT; i++) {
+            m_timer[i] = new SimTimer(1 + (i / 4), i % 4);
+        }
+    }
+    void Start() {
+        for (uint32_t i = 0; i < TIMER_COUNT; i++) {
+            m_timer[i]->SimStart(1 + Random(TIMEOUT_MAX_MS), (i % 4) == 0);
+        }
+        ScheduleNext();
+    }
+    void Stop() {
+        for (uint32_t i = 0; i < TIMER_COUNT; i++) {
+            m_timer[i]->SimStop();
+        }
+    }
+    void OnTimeout(SimTimer *timer) {
+        if (!timer->IsArmed()) {
+            timer->SimStart(1 + Random(TIMEOUT_MAX_MS));
+        }
+    }
+    void OnExt(uint32_t source) {
+        (void)source;
+        SimTimer *timer = m_timer[Random(TIMER_COUNT)];
+        if (Random(4) == 0) {
+            timer->SimStop();
+        } else {
+            timer->SimRestart(1 + Random(TIMEOUT_MAX_MS), Random(4) == 0);
+        }
+        ScheduleNext();
+    }
+private:
+    void ScheduleNext() {
+        ScheduleExt(0, 1 + Random(2 * EXT_MEAN_MS * CYCLES_PER_MS));
+    }
+    SimTimer *m_timer[TIMER_COUNT];
+};
+
+// Runs the scenario for RUN_SEC with the idle loop of QXK::onIdle().
+void RunScenario(char const *name, Scenario &scenario) {
+    stat = Stat();
+    stat.phaseMin = INT64_MAX;
+    stat.phaseMax = INT64_MIN;
+    uint32_t startTick = uwTick;
+    uint64_t start = now;
+    uint64_t end = now + static_cast<uint64_t>(RUN_SEC) * CORE_HZ;
+    scenario.Start();
+    while (now < end) {
+        Service();
+        SamplePhase();
+        if (queueTail != queueHead) {
+            QF_CRIT_STAT_TYPE crit;
+            QF_CRIT_ENTRY(crit);
+            Item item = queue[queueTail++ % QUEUE_SIZE];
+            QF_CRIT_EXIT(crit);
+            if (item.timer) {
+                if (Timer::IsValid(item.timer)) {
+                    scenario.OnTimeout(item.timer);
+                }
+            } else {
+                scenario.OnExt(item.source - 1);
+            }
+            Run(DISPATCH_CYCLES);
+        } else {
+            QF_INT_DISABLE();
+            stat.idleCycles += BspTicklessSleep();
+            QF_INT_ENABLE();
+        }
+    }
+    scenario.Stop();
+    for (uint32_t i = 0; i < SOURCE_COUNT; i++) {
+        sourceTime[i] = NEVER;
+    }
+    UpdateExtTime();
+    // Drains stale timeouts so the next scenario starts with an empty queue.
+    while (queueTail != queueHead) {
+        Item item = queue[queueTail++ % QUEUE_SIZE];
+        if (item.timer) {
+            Timer::IsValid(item.timer);
+        }
+    }
+
+    uint64_t total = now - start;
+    uint32_t ticks = uwTick - startTick;
+    double phasePpm = 1e6 * stat.phaseMax / total;
+    double idleError = (static_cast<double>(stat.idleCycles) - stat.wfiCycles) / total;
+    printf("%s: %.3f s, %u ticks, %u tick interrupts, %u other interrupts\n", name,
+           static_cast<double>(total) / CORE_HZ, ticks, stat.tickIsrs, stat.extIsrs);
+    printf("  wakeups %u, %u at 1 kHz tick (%.1f%% avoided)\n", stat.wakeups, ticks + stat.extIsrs,
+           100.0 * (ticks + stat.extIsrs - stat.wakeups) / (ticks + stat.extIsrs));
+    printf("  timeouts %u, max %.1f us after tick boundary\n", stat.timeouts,
+           static_cast<double>(stat.postLateMax) / (CORE_HZ / 1000000));
+    printf("  tick phase %lld..%lld cycles, drift %.3f ppm\n", static_cast<long long>(stat.phaseMin),
+           static_cast<long long>(stat.phaseMax), phasePpm);
+    printf("  idle %.3f%% in WFI, %.3f%% returned for CPU utilization\n", 100.0 * stat.wfiCycles / total,
+           100.0 * stat.idleCycles / total);
+    if (stat.phaseMin < 0) {
+        Fail("tick phase ahead of the ideal boundary");
+    }
+    if (phasePpm > PHASE_PPM_MAX) {
+        Fail("tick drift over PHASE_PPM_MAX");
+    }
+    if ((idleError > IDLE_ERROR_MAX) || (idleError < -IDLE_ERROR_MAX)) {
+        Fail("idle time off by more than IDLE_ERROR_MAX");
+    }
+}
+
+} // namespace
+
+uint32_t SystemCoreClock = CORE_HZ;
+__IO uint32_t uwTick;
+SimSysTick simSysTick = { { ReadCtrl, WriteCtrl }, { ReadLoad, WriteLoad }, { ReadVal, WriteVal } };
+SimDwt simDwt = { { ReadCyccnt, WriteReadOnly } };
+SimScb simScb = { { ReadIcsr, WriteIcsr } };
+
+uint32_t SimSetBasepri(uint32_t value) {
+    uint32_t prev = basepri;
+    basepri = value;
+    Service();
+    return prev;
+}
+
+void __disable_irq() {
+    primask = true;
+}
+
+void __enable_irq() {
+    primask = false;
+    Service();
+}
+
+void __DSB() {
+    Advance(REG_CYCLES);
+}
+
+void __ISB() {
+    Advance(REG_CYCLES);
+}
+
+// Wakes up on a pending interrupt even if masked by PRIMASK or BASEPRI.
+void __WFI() {
+    if (!st.pending && !pendSv && !IsExtPending()) {
+        uint64_t cycles = CyclesToTick();
+        if (extTime != NEVER) {
+            cycles = LESS(cycles, extTime - now);
+        }
+        if (cycles == NEVER) {
+            printf("WFI with no interrupt to wake up\n");
+            exit(1);
+        }
+        Advance(cycles);
+        stat.wfiCycles += cycles;
+        stat.wakeups++;
+    }
+    Advance(REG_CYCLES);
+}
+
+bool QF::noTimeEvtsActiveX(uint_fast8_t const tickRate) {
+    (void)tickRate;
+    return true;
+}
+
+QActive *Fw::GetContainer(Hsmn hsmn) {
+    (void)hsmn;
+    return &simAct;
+}
+
+uint32_t Prof::GetTime() {
+    return static_cast<uint32_t>(now);
+}
+
+int main() {
+    // As SysTick_Config() in HAL_InitTick().
+    st.load = CYCLES_PER_TICK - 1;
+    st.val = 0;
+    st.enable = true;
+    st.tickInt = true;
+    MicrowaveIdle microwaveIdle;
+    RunScenario("Microwave idle", microwaveIdle);
+    RandomTimers randomTimers;
+    RunScenario("Random", randomTimers);
+    if (failures) {
+        printf("FAILED: %u failures\n", failures);
+        return 1;
+    }
+    printf("PASSED\n");
+    return 0;
+}
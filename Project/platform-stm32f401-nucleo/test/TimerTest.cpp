@@ -0,0 +1,392 @@
+/*******************************************************************************
+ * Copyright (C) Gallium Studio LLC. All rights reserved.
+ *
+ * This program is open source software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Alternatively, this program may be distributed and modified under the
+ * terms of Gallium Studio LLC commercial licenses, which expressly supersede
+ * the GNU General Public License and are specifically designed for licensees
+ * interested in retaining the proprietary status of their code.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * Contact information:
+ * Website - https://www.galliumstudio.com
+ * Source repository - https://github.com/galliumstudio
+ * Email - admin@galliumstudio.com
+ ******************************************************************************/
+
+// Host test and benchmark of FW::Timer on the list of armed QTimeEvt scanned by QF::tickX_() (the default) and on
+// the timing wheel (FW_TIMER_WHEEL). It is built twice, as TimerListTest and TimerWheelTest. fw_timer.cpp and
+// qpcpp/src/qf/qf_time.cpp are compiled unchanged, with the QF port in host/timer.
+// 1. For 10 to 4000 armed timers with random timeouts of up to TIMEOUT_MAX_MS (one in four periodic), ticks are
+//    run as in SysTick_Handler() and the time of QF::tickX_() plus Timer::Tick() is measured per tick. Expired
+//    one-shot timers are restarted by the simulated active object, and CHANGES_PER_TICK random timers are
+//    stopped or restarted between ticks, so the number of armed timers stays about the same.
+// 2. Every timeout event must be posted in the tick it is due, and none after its timer is stopped.
+// 3. Timer::Stop() is timed against the former Stop(), which removed the timeout events of the timer from the
+//    event queue of its container by walking the queue. Nearly all of either runs with interrupts masked, so
+//    the time per call bounds the interrupt-disable window. The queue has EVT_QUEUE_COUNT entries as Active,
+//    with 0 to EVT_QUEUE_COUNT + 1 other events in it. Timer::IsValid(), which drops stale timeout events at
+//    dispatch instead, is timed as well.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <vector>
+#include "fw_macro.h"
+#include "bsp.h"
+#include "fw_timer.h"
+#include "fw_prof.h"
+#include "fw_inline.h"
+#include "fw_assert.h"
+
+FW_DEFINE_THIS_FILE("TimerTest.cpp")
+
+using namespace QP;
+using namespace FW;
+
+extern "C" void Q_onAssert(char const * const module, int location) {
+    printf("Assert failed in %s at line %d\n", module, location);
+    exit(1);
+}
+
+namespace {
+
+enum {
+    TIMER_HSMN = 1,
+    TIMEOUT_MAX_MS = 30000,
+    RUN_TICKS = 20000,
+    CHANGES_PER_TICK = 2,
+    EVT_QUEUE_COUNT = 64,       // As Active.
+    STOP_TIMERS = 1000,
+    STOP_ROUNDS = 1000,
+};
+
+uint32_t failures = 0;
+
+void Fail(char const *what) {
+    if (failures++ < 10) {
+        printf("FAIL: %s\n", what);
+    }
+}
+
+double Now() {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+class Random {
+public:
+    Random(uint32_t seed) : m_seed(seed) {}
+    uint32_t Get(uint32_t n) {
+        m_seed ^= m_seed << 13;
+        m_seed ^= m_seed >> 17;
+        m_seed ^= m_seed << 5;
+        return m_seed % n;
+    }
+private:
+    uint32_t m_seed;
+};
+
+uint32_t tickCount;     // Number of ticks run.
+
+// Timer with the tick at which its next timeout is due. Each timer draws its own timeouts, so that they do not
+// depend on the order in which timers expiring in the same tick are posted.
+class SimTimer : public Timer {
+public:
+    SimTimer(uint32_t index) :
+        Timer(TIMER_HSMN, TIMER_EVT_START(TIMER_HSMN) + (index & 0x3F)), m_random(index + 1), m_armed(false),
+        m_due(0), m_period(0) {}
+    void SimStart(bool periodic) {
+        uint32_t ms = 1 + m_random.Get(TIMEOUT_MAX_MS);
+        Start(ms, periodic ? PERIODIC : ONCE);
+        m_armed = true;
+        m_due = tickCount + ms / BSP_MSEC_PER_TICK;
+        m_period = periodic ? (ms / BSP_MSEC_PER_TICK) : 0;
+    }
+    void SimStop() {
+        Stop();
+        m_armed = false;
+    }
+    void SimRestart(bool periodic) {
+        SimStop();
+        SimStart(periodic);
+    }
+    bool IsArmed() const { return m_armed; }
+    bool IsPeriodic() const { return m_period != 0; }
+    void SimPost() {
+        OnPost();
+    }
+    void FormerStop(QEQueue *eQueue, QEvt const **queueStor, QEQueueCtr queueCount);
+    void OnTimeout() {
+        if (!m_armed) {
+            Fail("timeout posted for a stopped timer");
+        } else if (tickCount != m_due) {
+            Fail("timeout posted in a wrong tick");
+        }
+        if (m_period) {
+            m_due += m_period;
+        } else {
+            m_armed = false;
+        }
+    }
+private:
+    Random m_random;
+    bool IsMatch(QEvt const *other) {
+        return (other->sig == sig) &&
+               (static_cast<Timer const *>(other)->GetHsmn() == m_hsmn);
+    }
+
+    bool m_armed;
+    uint32_t m_due;
+    uint32_t m_period;
+};
+
+Timer const CANCELED_TIMER(HSM_UNDEF, Q_USER_SIG);
+
+// Timer::Stop() as removed from fw_timer.cpp, with the event queue of the container passed in.
+void SimTimer::FormerStop(QEQueue *eQueue, QEvt const **queueStor, QEQueueCtr queueCount) {
+#if FW_TIMER_WHEEL
+    {
+        QF_CRIT_STAT_TYPE crit;
+        QF_CRIT_ENTRY(crit);
+        if (IsWheelArmed()) {
+            WheelUnlink();
+        }
+        QF_CRIT_EXIT(crit);
+    }
+#else
+    QTimeEvt::disarm();
+#endif
+    FW_ASSERT(queueStor && queueCount);
+    QF_CRIT_STAT_TYPE crit;
+    QF_CRIT_ENTRY(crit);
+    QEvt const * frontEvt = eQueue->get();
+    if (frontEvt) {
+        if (IsMatch(frontEvt)) {
+            FW_ASSERT(IS_TIMER_EVT(frontEvt->sig) && QF_EVT_POOL_ID_(frontEvt) == 0);
+            frontEvt = &CANCELED_TIMER;
+        }
+        eQueue->postLIFO(frontEvt);
+        if (QF_EVT_POOL_ID_(frontEvt) != 0) {
+            FW_ASSERT(QF_EVT_REF_CTR_(frontEvt) > 1);
+            QF_EVT_REF_CTR_DEC_(frontEvt);
+        }
+        if (eQueue->getNFree() < queueCount) {
+            for (QEQueueCtr i = 0; i < queueCount; i++) {
+                if (IsMatch(queueStor[i])) {
+                    FW_ASSERT(IS_TIMER_EVT(queueStor[i]->sig) && QF_EVT_POOL_ID_(queueStor[i]) == 0);
+                    queueStor[i] = &CANCELED_TIMER;
+                }
+            }
+        }
+    }
+    QF_CRIT_EXIT(crit);
+}
+
+// Queues timeout events posted within a tick. They are dispatched after the tick.
+class SimAct : public QActive {
+public:
+    bool post_(QEvt const * const e, uint_fast16_t const margin) {
+        (void)margin;
+        m_queue.push_back(e);
+        return true;
+    }
+    std::vector<QEvt const *> m_queue;
+};
+
+SimAct simAct;
+
+struct Result {
+    double avgNs;
+    double maxNs;
+    uint32_t timeouts;
+};
+
+Result Run(uint32_t timerCount) {
+    Random random(timerCount);
+    std::vector<SimTimer *> timers;
+    for (uint32_t i = 0; i < timerCount; i++) {
+        SimTimer *t = new SimTimer(i);
+        t->SimStart(random.Get(4) == 0);
+        timers.push_back(t);
+    }
+    simAct.m_queue.reserve(timerCount);
+    Result result = { 0, 0, 0 };
+    double total = 0;
+    for (uint32_t i = 0; i < RUN_TICKS; i++) {
+        double start = Now();
+        tickCount++;
+        QF::tickX_(0);
+        Timer::Tick();
+        double time = Now() - start;
+        total += time;
+        result.maxNs = GREATER(result.maxNs, time * 1e9);
+        for (QEvt const *e : simAct.m_queue) {
+            if (Timer::IsValid(e)) {
+                SimTimer *t = static_cast<SimTimer *>(const_cast<QEvt *>(e));
+                t->OnTimeout();
+                result.timeouts++;
+                if (!t->IsArmed()) {
+                    t->SimStart(false);
+                }
+            }
+        }
+        simAct.m_queue.clear();
+        for (uint32_t j = 0; j < CHANGES_PER_TICK; j++) {
+            SimTimer *t = timers[random.Get(timerCount)];
+            if (random.Get(2)) {
+                t->SimRestart(t->IsPeriodic());
+            } else if (t->IsArmed()) {
+                t->SimStop();
+            } else {
+                t->SimStart(false);
+            }
+        }
+    }
+    // Stops all timers and runs the ticks the longest timeout takes, so that stale events are flushed out.
+    for (SimTimer *t : timers) {
+        t->SimStop();
+    }
+    for (uint32_t i = 0; i <= TIMEOUT_MAX_MS; i++) {
+        tickCount++;
+        QF::tickX_(0);
+        Timer::Tick();
+        for (QEvt const *e : simAct.m_queue) {
+            if (Timer::IsValid(e)) {
+                Fail("timeout posted after all timers are stopped");
+            }
+        }
+        simAct.m_queue.clear();
+    }
+    if (!QF::noTimeEvtsActiveX(0)) {
+        Fail("time event still armed after all timers are stopped");
+    }
+    for (SimTimer *t : timers) {
+        delete t;
+    }
+    result.avgNs = total * 1e9 / RUN_TICKS;
+    return result;
+}
+
+// Returns the time per call in ns of Stop() if former is false, or the former Stop() if true.
+double TimeStop(std::vector<SimTimer *> &timers, bool former, QEQueue *eQueue, QEvt const **queueStor) {
+    double total = 0;
+    for (uint32_t round = 0; round < STOP_ROUNDS; round++) {
+        for (SimTimer *t : timers) {
+            t->Start(TIMEOUT_MAX_MS);
+        }
+        double start = Now();
+        if (former) {
+            for (SimTimer *t : timers) {
+                t->FormerStop(eQueue, queueStor, EVT_QUEUE_COUNT);
+            }
+        } else {
+            for (SimTimer *t : timers) {
+                t->Stop();
+            }
+        }
+        total += Now() - start;
+    }
+    return total * 1e9 / (STOP_ROUNDS * timers.size());
+}
+
+// Returns the time per call in ns of IsValid() for stale timeout events.
+double TimeIsValid(std::vector<SimTimer *> &timers) {
+    double total = 0;
+    for (uint32_t round = 0; round < STOP_ROUNDS; round++) {
+        for (SimTimer *t : timers) {
+            t->SimPost();
+            t->Stop();
+        }
+        double start = Now();
+        for (SimTimer *t : timers) {
+            if (Timer::IsValid(t)) {
+                Fail("stale timeout event not dropped");
+            }
+        }
+        total += Now() - start;
+    }
+    return total * 1e9 / (STOP_ROUNDS * timers.size());
+}
+
+void BenchStop() {
+    std::vector<SimTimer *> timers;
+    for (uint32_t i = 0; i < STOP_TIMERS; i++) {
+        timers.push_back(new SimTimer(i));
+    }
+    // Other events in the queue are timeout events of a timer not being stopped.
+    SimTimer other(STOP_TIMERS);
+    // The former Stop() reads unused entries as well, which must point to an event.
+    QEvt const *queueStor[EVT_QUEUE_COUNT];
+    for (QEvt const *&e : queueStor) {
+        e = &other;
+    }
+    QEQueue eQueue;
+    eQueue.init(queueStor, EVT_QUEUE_COUNT);
+    uint32_t const depths[] = { 0, 1, 2, EVT_QUEUE_COUNT + 1 };
+    uint32_t depth = 0;
+    for (uint32_t target : depths) {
+        for (; depth < target; depth++) {
+            eQueue.post(&other, QF_NO_MARGIN);
+        }
+        double formerNs = TimeStop(timers, true, &eQueue, queueStor);
+        double stopNs = TimeStop(timers, false, &eQueue, queueStor);
+        printf("Queue depth %2u: former Stop() %6.1f ns, Stop() %4.1f ns per call\n", depth, formerNs, stopNs);
+    }
+    printf("IsValid() %.1f ns per stale timeout event\n", TimeIsValid(timers));
+    for (SimTimer *t : timers) {
+        delete t;
+    }
+}
+
+} // namespace
+
+QActive *Fw::GetContainer(Hsmn hsmn) {
+    (void)hsmn;
+    return &simAct;
+}
+
+uint32_t Prof::GetTime() {
+    return tickCount;
+}
+
+int main() {
+    printf("%s: %u ticks per run, timeouts of 1 to %u ms\n", FW_TIMER_WHEEL ? "Timing wheel" : "QTimeEvt list",
+           RUN_TICKS, TIMEOUT_MAX_MS);
+    uint32_t const timerCounts[] = { 10, 100, 1000, 4000 };
+    for (uint32_t timerCount : timerCounts) {
+        Result result = Run(timerCount);
+        printf("%4u timers: %7.1f ns avg, %8.1f ns max per tick, %u timeouts\n", timerCount, result.avgNs,
+               result.maxNs, result.timeouts);
+    }
+    BenchStop();
+    if (failures) {
+        printf("FAILED: %u failures\n", failures);
+        return 1;
+    }
+    printf("PASSED\n");
+    return 0;
+}
@@ -0,0 +1,105 @@
+/*******************************************************************************
+ * Copyright (C) Gallium Studio LLC. All rights reserved.
+ *
+ * This program is open source software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Alternatively, this program may be distributed and modified under the
+ * terms of Gallium Studio LLC commercial licenses, which expressly supersede
+ * the GNU General Public License and are specifically designed for licensees
+ * interested in retaining the proprietary status of their code.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * Contact information:
+ * Website - https://www.galliumstudio.com
+ * Source repository - https://github.com/galliumstudio
+ * Email - admin@galliumstudio.com
+ ******************************************************************************/
+
+#ifndef BSP_H
+#define BSP_H
+
+#include <stdint.h>
+#include "qpcpp.h"
+
+// Stand-in for bsp.h in TicklessTest. SysTick, DWT CYCCNT, SCB ICSR, WFI and PRIMASK are simulated on
+// a virtual clock of core cycles by TicklessTest. Registers are read and written through SimReg.
+
+#define BSP_TICKS_PER_SEC            (1000)
+#define BSP_MSEC_PER_TICK            (1000 / BSP_TICKS_PER_SEC)
+
+#define ENABLE_TICKLESS_IDLE         1
+
+uint32_t BspTicklessSleep();
+
+#define __IO                         volatile
+
+class SimReg {
+public:
+    typedef uint32_t (*ReadFunc)();
+    typedef void (*WriteFunc)(uint32_t value);
+    SimReg(ReadFunc read, WriteFunc write) : m_read(read), m_write(write) {}
+    operator uint32_t() const { return m_read(); }
+    SimReg &operator=(uint32_t value) { m_write(value); return *this; }
+private:
+    SimReg(SimReg const &);
+    SimReg &operator=(SimReg const &);
+    ReadFunc m_read;
+    WriteFunc m_write;
+};
+
+struct SimSysTick {
+    SimReg CTRL;
+    SimReg LOAD;
+    SimReg VAL;
+};
+struct SimDwt {
+    SimReg CYCCNT;
+};
+struct SimScb {
+    SimReg ICSR;
+};
+
+extern uint32_t SystemCoreClock;
+extern SimSysTick simSysTick;
+extern SimDwt simDwt;
+extern SimScb simScb;
+
+#define SysTick                      (&simSysTick)
+#define DWT                          (&simDwt)
+#define SCB                          (&simScb)
+
+#define SysTick_CTRL_ENABLE_Msk      (1UL << 0)
+#define SysTick_CTRL_TICKINT_Msk     (1UL << 1)
+#define SysTick_CTRL_CLKSOURCE_Msk   (1UL << 2)
+#define SysTick_CTRL_COUNTFLAG_Msk   (1UL << 16)
+#define SysTick_LOAD_RELOAD_Msk      (0xFFFFFFUL)
+#define SCB_ICSR_PENDSTSET_Msk       (1UL << 26)
+
+void __WFI();
+void __DSB();
+void __ISB();
+void __disable_irq();
+void __enable_irq();
+
+#endif // BSP_H
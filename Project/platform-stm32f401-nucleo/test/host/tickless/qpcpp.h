@@ -0,0 +1,105 @@
+/*******************************************************************************
+ * Copyright (C) Gallium Studio LLC. All rights reserved.
+ *
+ * This program is open source software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Alternatively, this program may be distributed and modified under the
+ * terms of Gallium Studio LLC commercial licenses, which expressly supersede
+ * the GNU General Public License and are specifically designed for licensees
+ * interested in retaining the proprietary status of their code.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * Contact information:
+ * Website - https://www.galliumstudio.com
+ * Source repository - https://github.com/galliumstudio
+ * Email - admin@galliumstudio.com
+ ******************************************************************************/
+
+#ifndef QPCPP_H
+#define QPCPP_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Stand-in for qpcpp.h in TicklessTest. It declares the part of QP used by FW::Timer and the framework
+// headers it includes. Interrupt masking by BASEPRI is simulated by TicklessTest, which also defines
+// the QActive and QF functions.
+typedef int int_t;
+
+extern "C" void Q_onAssert(char const * const module, int_t location);
+
+#define Q_ASSERT_COMPILE(test_)     static_assert((test_), "Q_ASSERT_COMPILE")
+#define Q_SIGNAL_SIZE               2
+#define QF_MAX_ACTIVE               32
+
+// Sets the simulated BASEPRI and returns the previous value. Pending interrupts are taken when both
+// BASEPRI and PRIMASK are cleared.
+uint32_t SimSetBasepri(uint32_t basepri);
+
+#define QF_CRIT_STAT_TYPE           uint32_t
+#define QF_CRIT_ENTRY(stat_)        ((stat_) = SimSetBasepri(1U))
+#define QF_CRIT_EXIT(stat_)         ((void)SimSetBasepri(stat_))
+#define QF_INT_DISABLE()            ((void)SimSetBasepri(1U))
+#define QF_INT_ENABLE()             ((void)SimSetBasepri(0U))
+
+namespace QP {
+
+typedef uint16_t QSignal;
+typedef uint32_t QTimeEvtCtr;
+
+enum {
+    QF_NO_MARGIN = 0xFFFF
+};
+
+class QEvt {
+public:
+    QSignal sig;
+    uint8_t poolId_;
+    uint8_t volatile refCtr_;
+
+    QEvt(QSignal const s) : sig(s), poolId_(0U), refCtr_(0U) {}
+};
+
+class QTimeEvt : public QEvt {
+public:
+    QTimeEvt(QSignal const s) : QEvt(s) {}
+};
+
+class QActive {
+public:
+    virtual ~QActive() {}
+    virtual bool post_(QEvt const * const e, uint_fast16_t const margin, void const * const sender) = 0;
+};
+
+class QF {
+public:
+    static bool noTimeEvtsActiveX(uint_fast8_t const tickRate);
+    static void onTimeEvtPost(QTimeEvt *t);
+};
+
+} // namespace QP
+
+#define POST(e_, sender_)           post_((e_), QP::QF_NO_MARGIN, (sender_))
+
+#endif // QPCPP_H
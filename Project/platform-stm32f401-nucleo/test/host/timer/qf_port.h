@@ -0,0 +1,155 @@
+/*******************************************************************************
+ * Copyright (C) Gallium Studio LLC. All rights reserved.
+ *
+ * This program is open source software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Alternatively, this program may be distributed and modified under the
+ * terms of Gallium Studio LLC commercial licenses, which expressly supersede
+ * the GNU General Public License and are specifically designed for licensees
+ * interested in retaining the proprietary status of their code.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * Contact information:
+ * Website - https://www.galliumstudio.com
+ * Source repository - https://github.com/galliumstudio
+ * Email - admin@galliumstudio.com
+ ******************************************************************************/
+
+#ifndef qf_port_h
+#define qf_port_h
+
+#include <stdint.h>
+
+// Stand-in for the QF port in TimerTest. QEvt, QActive, QTimeEvt and QF are declared as in qep.h and qf.h
+// (QP 6.5.1, without Q_SPY), limited to what FW::Timer, qf_time.cpp and qf_qeq.cpp use. Critical sections
+// are empty since the test runs in a single thread.
+#include "qassert.h"
+
+typedef int enum_t;
+
+#define Q_SIGNAL_SIZE               2
+#define Q_EVT_CTOR
+#define QF_TIMEEVT_CTR_SIZE         4
+#define QF_MAX_ACTIVE               32
+#define QF_MAX_TICK_RATE            2
+#define QF_MAX_EPOOL                3
+#define QF_EPOOL_TYPE_              uint32_t
+
+#define QF_CRIT_STAT_TYPE           uint32_t
+#define QF_CRIT_ENTRY(stat_)        ((stat_) = 0U)
+#define QF_CRIT_EXIT(stat_)         ((void)(stat_))
+#define QF_CRIT_EXIT_NOP()          ((void)0)
+#define QF_INT_DISABLE()            ((void)0)
+#define QF_INT_ENABLE()             ((void)0)
+
+namespace QP {
+
+typedef uint16_t QSignal;
+typedef uint32_t QTimeEvtCtr;
+typedef uint32_t QSubscrList;
+
+enum_t const Q_USER_SIG = static_cast<enum_t>(4);
+uint_fast16_t const QF_NO_MARGIN = static_cast<uint_fast16_t>(0xFFFF);
+
+class QEvt {
+public:
+    QSignal sig;
+    uint8_t poolId_;
+    uint8_t volatile refCtr_;
+
+    QEvt(QSignal const s) : sig(s), poolId_(0U), refCtr_(0U) {}
+};
+
+class QActive {
+public:
+    virtual ~QActive() {}
+    virtual bool post_(QEvt const * const e, uint_fast16_t const margin) = 0;
+};
+
+class QTimeEvt : public QEvt {
+private:
+    QTimeEvt * volatile m_next;
+    void * volatile m_act;
+    QTimeEvtCtr volatile m_ctr;
+    QTimeEvtCtr m_interval;
+
+public:
+    QTimeEvt(QActive * const act, enum_t const sgnl,
+             uint_fast8_t const tickRate = static_cast<uint_fast8_t>(0));
+    void armX(QTimeEvtCtr const nTicks,
+              QTimeEvtCtr const interval = static_cast<QTimeEvtCtr>(0));
+    bool disarm(void);
+    bool rearm(QTimeEvtCtr const nTicks);
+    bool wasDisarmed(void);
+    QTimeEvtCtr currCtr(void) const;
+
+#ifndef QP_IMPL
+    QTimeEvt(enum_t const sgnl) :
+        QEvt(static_cast<QSignal>(sgnl)),
+        m_next(static_cast<QTimeEvt *>(0)),
+        m_act(static_cast<void *>(0)),
+        m_ctr(static_cast<QTimeEvtCtr>(0)),
+        m_interval(static_cast<QTimeEvtCtr >(0))
+    {
+    }
+    void postIn(QActive * const act, QTimeEvtCtr const nTicks) {
+        m_act = act;
+        armX(nTicks, static_cast<QTimeEvtCtr>(0));
+    }
+    void postEvery(QActive * const act, QTimeEvtCtr const nTicks) {
+        m_act = act;
+        armX(nTicks, nTicks);
+    }
+#endif // QP_IMPL
+
+private:
+    QTimeEvt(void);
+    QTimeEvt(QTimeEvt const &);
+    QTimeEvt & operator=(QTimeEvt const &);
+
+    QActive  *toActive(void)  { return static_cast<QActive  *>(m_act); }
+    QTimeEvt *toTimeEvt(void) { return static_cast<QTimeEvt *>(m_act); }
+
+    friend class QF;
+};
+
+class QF {
+public:
+    static void tickX_(uint_fast8_t const tickRate);
+    static bool noTimeEvtsActiveX(uint_fast8_t const tickRate);
+    static void onTimeEvtPost(QTimeEvt *t);
+
+private:
+    static QTimeEvt timeEvtHead_[QF_MAX_TICK_RATE];
+
+    friend class QTimeEvt;
+};
+
+} // namespace QP
+
+#include "qequeue.h"
+
+#define POST(e_, sender_)           post_((e_), QP::QF_NO_MARGIN)
+
+#endif // qf_port_h